@@ -0,0 +1,141 @@
+#include <atomic>  // For counting from every thread
+#include <cstdlib> // For std::malloc and std::free
+#include <new>     // For std::bad_alloc and the operators we replace
+
+#include "Headers/AllocationCounter.hpp" // Header for the allocation counter
+
+// How many times operator new was called
+static std::atomic<unsigned long long> allocation_count(0);
+
+// Allocate and count (every operator new ends up here)
+static void* allocate(std::size_t i_size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    // malloc(0) may return nullptr, but new must always give us something
+    return std::malloc(i_size == 0 ? 1 : i_size);
+}
+
+// Get how many times operator new was called
+unsigned long long get_allocation_count() {
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+// The replaced operators: every new counts and calls malloc, and every delete calls free
+void* operator new(std::size_t i_size) {
+    void* output = allocate(i_size);
+
+    if (output == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return output;
+}
+
+void* operator new[](std::size_t i_size) {
+    return operator new(i_size);
+}
+
+void* operator new(std::size_t i_size, const std::nothrow_t&) noexcept {
+    return allocate(i_size);
+}
+
+void* operator new[](std::size_t i_size, const std::nothrow_t&) noexcept {
+    return allocate(i_size);
+}
+
+void operator delete(void* i_memory) noexcept {
+    std::free(i_memory);
+}
+
+void operator delete[](void* i_memory) noexcept {
+    std::free(i_memory);
+}
+
+void operator delete(void* i_memory, std::size_t) noexcept {
+    std::free(i_memory);
+}
+
+void operator delete[](void* i_memory, std::size_t) noexcept {
+    std::free(i_memory);
+}
+
+void operator delete(void* i_memory, const std::nothrow_t&) noexcept {
+    std::free(i_memory);
+}
+
+void operator delete[](void* i_memory, const std::nothrow_t&) noexcept {
+    std::free(i_memory);
+}
+
+// The aligned operators only exist since C++17
+#ifdef __cpp_aligned_new
+// Allocate with a bigger alignment than malloc gives us, and count
+static void* allocate_aligned(std::size_t i_size, std::align_val_t i_alignment) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    std::size_t alignment = static_cast<std::size_t>(i_alignment);
+    // Round the size up, because aligned_alloc wants a multiple of the alignment
+    std::size_t size = (i_size == 0 ? alignment : alignment * ((alignment - 1 + i_size) / alignment));
+
+#ifdef _MSC_VER
+    return _aligned_malloc(size, alignment);
+#else
+    return std::aligned_alloc(alignment, size);
+#endif
+}
+
+// Free memory from allocate_aligned
+static void free_aligned(void* i_memory) {
+#ifdef _MSC_VER
+    _aligned_free(i_memory);
+#else
+    std::free(i_memory);
+#endif
+}
+
+void* operator new(std::size_t i_size, std::align_val_t i_alignment) {
+    void* output = allocate_aligned(i_size, i_alignment);
+
+    if (output == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return output;
+}
+
+void* operator new[](std::size_t i_size, std::align_val_t i_alignment) {
+    return operator new(i_size, i_alignment);
+}
+
+void* operator new(std::size_t i_size, std::align_val_t i_alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(i_size, i_alignment);
+}
+
+void* operator new[](std::size_t i_size, std::align_val_t i_alignment, const std::nothrow_t&) noexcept {
+    return allocate_aligned(i_size, i_alignment);
+}
+
+void operator delete(void* i_memory, std::align_val_t) noexcept {
+    free_aligned(i_memory);
+}
+
+void operator delete[](void* i_memory, std::align_val_t) noexcept {
+    free_aligned(i_memory);
+}
+
+void operator delete(void* i_memory, std::size_t, std::align_val_t) noexcept {
+    free_aligned(i_memory);
+}
+
+void operator delete[](void* i_memory, std::size_t, std::align_val_t) noexcept {
+    free_aligned(i_memory);
+}
+
+void operator delete(void* i_memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    free_aligned(i_memory);
+}
+
+void operator delete[](void* i_memory, std::align_val_t, const std::nothrow_t&) noexcept {
+    free_aligned(i_memory);
+}
+#endif
@@ -1,42 +1,55 @@
 #include <array>  // For std::array
+#include <cstddef> // For std::size_t
 #include <string> // For std::string
+#include <vector> // For std::vector
 #include <SFML/Graphics.hpp> // SFML library for graphics rendering
 
 #include "Headers/Global.hpp"        // Header for global definitions and constants
+#include "Headers/Map.hpp"           // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
 #include "Headers/Pacman.hpp"        // Header for Pac-Man class definition
+#include "Headers/MapSketch.hpp"     // Header for the default map sketch
+#include "Headers/CompiledSketch.hpp" // Header for the sketches converted while compiling
 #include "Headers/ConvertSketch.hpp" // Header for the convert_sketch function definition
+#include "Headers/Trace.hpp"         // Header for the trace zones
 
 // Function to convert a textual map sketch to a structured game map
-std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH> convert_sketch(
-    const std::array<std::string, MAP_HEIGHT>& i_map_sketch,
+// The map is reused, so starting a level on a map of the same size doesn't allocate any memory
+void convert_sketch(
+    const std::vector<std::string>& i_map_sketch,
+    Map& i_map,
     std::array<Position, 4>& i_ghost_positions,
     Pacman& i_pacman
 ) {
-    // Initialize the output map with default empty cells
-    std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH> output_map{};
+    TRACE_ZONE("convert_sketch");
+
+    // The size of the map is the size of the sketch (every row has the same length, see validate_maze)
+    unsigned short height = static_cast<unsigned short>(i_map_sketch.size());
+    unsigned short width = static_cast<unsigned short>(i_map_sketch[0].size());
+
+    // Initialize the map with empty cells
+    i_map.reset(width, height);
 
     // Iterate over the rows of the sketch
-    for (unsigned char a = 0; a < MAP_HEIGHT; a++) {
+    for (unsigned short a = 0; a < height; a++) {
         // Iterate over the columns of the sketch
-        for (unsigned char b = 0; b < MAP_WIDTH; b++) {
-            // Default cell type is empty
-            output_map[b][a] = Cell::Empty;
-
+        for (unsigned short b = 0; b < width; b++) {
             // Switch on the character at the current position
             switch (i_map_sketch[a][b]) {
                 // Wall cell, representing an obstacle
             case '#':
-                output_map[b][a] = Cell::Wall;
+                i_map.set_cell(b, a, Cell::Wall);
                 break;
 
                 // Door cell, typically used for ghost exits
             case '=':
-                output_map[b][a] = Cell::Door;
+                i_map.set_cell(b, a, Cell::Door);
                 break;
 
                 // Pellet cell, representing food for Pac-Man
             case '.':
-                output_map[b][a] = Cell::Pellet;
+                i_map.set_cell(b, a, Cell::Pellet);
                 break;
 
                 // Position for the red ghost (ghost ID 0)
@@ -70,7 +83,7 @@ std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH> convert_sketch(
 
                 // Energizer cell, representing a power-up
             case 'o':
-                output_map[b][a] = Cell::Energizer;
+                i_map.set_cell(b, a, Cell::Energizer);
                 break;
 
                 // Default case, no special handling required
@@ -79,7 +92,4 @@ std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH> convert_sketch(
             }
         }
     }
-
-    // Return the structured output map
-    return output_map;
 }
@@ -1,15 +1,19 @@
-#include <cmath> // For rounding and math operations
+#include <cmath>   // For rounding and math operations
+#include <cstring> // For std::strcspn
+#include <string>  // For std::string
 #include <SFML/Graphics.hpp> // For SFML graphics components
 
 #include "Headers/DrawText.hpp" // Header for draw_text function
 #include "Headers/Global.hpp"   // Header for global constants and definitions
+#include "Headers/Metrics.hpp"  // Header for counting the texture loads
 
 // Function to draw text onto an SFML render window
+// The text is a plain C string, so drawing it every frame doesn't allocate any memory
 void draw_text(
     bool i_center,
     unsigned short i_x,
     unsigned short i_y,
-    const std::string& i_text,
+    const char* i_text,
     sf::RenderWindow& i_window
 ) {
     // Variables to keep track of the character's position
@@ -19,14 +23,21 @@ void draw_text(
     // Character width to determine the spacing between characters
     unsigned char character_width;
 
+    // Number of lines in the text
+    unsigned char line_count = 1;
+
     // SFML sprite to draw individual characters
     sf::Sprite character_sprite;
 
-    // SFML texture to represent the font
-    sf::Texture font_texture;
+    // SFML texture to represent the font (loaded only once, loading it every frame was slow and allocated memory)
+    static sf::Texture font_texture;
 
     // Load the font texture from a file
-    font_texture.loadFromFile("Resources/Images/Font.png");
+    if (font_texture.getSize().x == 0) {
+        font_texture.loadFromFile("Resources/Images/Font.png");
+
+        add_metric(Metric::TextureLoadMetric);
+    }
 
     // Determine the width of each character based on the texture's total width
     character_width = font_texture.getSize().x / 96; // The texture contains 96 characters
@@ -37,25 +48,32 @@ void draw_text(
     // If the text needs to be centered horizontally
     if (i_center) {
         // Calculate the initial x position for centered text
-        // The expression centers the first line of text within the width of the map
+        // The expression centers the first line of text within the width of the view
         character_x = static_cast<short>(
-            round(0.5f * (CELL_SIZE * MAP_WIDTH - character_width * i_text.substr(0, i_text.find_first_of('\n')).size()))
+            round(0.5f * (CELL_SIZE * VIEW_WIDTH - character_width * std::strcspn(i_text, "\n")))
             );
 
+        // Count the lines
+        for (const char* a = i_text; *a != '\0'; a++) {
+            if (*a == '\n') {
+                line_count++;
+            }
+        }
+
         // Calculate the initial y position for centered text
         character_y = static_cast<short>(
-            round(0.5f * (CELL_SIZE * MAP_HEIGHT - FONT_HEIGHT * (1 + std::count(i_text.begin(), i_text.end(), '\n'))))
+            round(0.5f * (CELL_SIZE * VIEW_HEIGHT - FONT_HEIGHT * line_count))
             );
     }
 
     // Loop through each character in the input text
-    for (std::string::const_iterator a = i_text.begin(); a != i_text.end(); ++a) {
+    for (const char* a = i_text; *a != '\0'; a++) {
         if (*a == '\n') {
             // If there's a newline, move to the next line
             if (i_center) {
                 // Recalculate the centered x position for the new line
                 character_x = static_cast<short>(
-                    round(0.5f * (CELL_SIZE * MAP_WIDTH - character_width * i_text.substr(1 + (a - i_text.begin()), i_text.find_first_of('\n', 1 + (a - i_text.begin())) - (1 + (a - i_text.begin()))).size()))
+                    round(0.5f * (CELL_SIZE * VIEW_WIDTH - character_width * std::strcspn(1 + a, "\n")))
                     );
             }
             else {
@@ -0,0 +1,89 @@
+#include <algorithm> // For std::max
+#include <array>  // For std::array
+#include <string> // For std::string
+#include <SFML/Graphics.hpp> // For SFML graphics components
+
+#include "Headers/Global.hpp"         // Header for global constants and definitions
+#include "Headers/EntityRenderer.hpp" // Header for the EntityRenderer class definition
+#include "Headers/Metrics.hpp"        // Header for counting the texture loads
+#include "Headers/Trace.hpp"          // Header for the trace zones
+
+// Constructor for the EntityRenderer class (the atlas is packed when the first sprite is added)
+EntityRenderer::EntityRenderer() :
+    draw_calls(0),
+    sheet_positions{},
+    vertices(sf::Quads)
+{
+}
+
+// Get how many draw calls we made in the last frame
+unsigned short EntityRenderer::get_draw_calls() {
+    return draw_calls;
+}
+
+// Pack the sprite sheets into one texture, in the order of EntitySheet
+void EntityRenderer::load_atlas() {
+    TRACE_ZONE("EntityRenderer::load_atlas");
+
+    std::array<sf::Image, 3> sheets;
+
+    sheets[EntitySheet::GhostSheet].loadFromFile("Resources/Images/Ghost" + std::to_string(CELL_SIZE) + ".png");
+    sheets[EntitySheet::PacmanSheet].loadFromFile("Resources/Images/Pacman" + std::to_string(CELL_SIZE) + ".png");
+    sheets[EntitySheet::PacmanDeathSheet].loadFromFile("Resources/Images/PacmanDeath" + std::to_string(CELL_SIZE) + ".png");
+
+    add_metric(Metric::TextureLoadMetric, sheets.size());
+
+    unsigned height = 0;
+    unsigned width = 0;
+
+    for (unsigned char a = 0; a < sheets.size(); a++) {
+        sheet_positions[a] = static_cast<unsigned short>(height);
+
+        height += sheets[a].getSize().y;
+        width = std::max(width, sheets[a].getSize().x);
+    }
+
+    sf::Image image;
+
+    image.create(width, height, sf::Color(0, 0, 0, 0));
+
+    for (unsigned char a = 0; a < sheets.size(); a++) {
+        image.copy(sheets[a], 0, sheet_positions[a]);
+    }
+
+    atlas.loadFromImage(image);
+}
+
+// Add a sprite to this frame
+void EntityRenderer::add_sprite(EntitySheet i_sheet, unsigned short i_texture_x, unsigned short i_texture_y, short i_x, short i_y, const sf::Color& i_color) {
+    // Load the atlas (only once, loading the textures every frame was slow and allocated memory)
+    if (atlas.getSize().x == 0) {
+        load_atlas();
+    }
+
+    float x = i_x;
+    float y = i_y;
+
+    float texture_x = i_texture_x;
+    float texture_y = static_cast<float>(i_texture_y + sheet_positions[i_sheet]);
+
+    vertices.append(sf::Vertex(sf::Vector2f(x, y), i_color, sf::Vector2f(texture_x, texture_y)));
+    vertices.append(sf::Vertex(sf::Vector2f(CELL_SIZE + x, y), i_color, sf::Vector2f(CELL_SIZE + texture_x, texture_y)));
+    vertices.append(sf::Vertex(sf::Vector2f(CELL_SIZE + x, CELL_SIZE + y), i_color, sf::Vector2f(CELL_SIZE + texture_x, CELL_SIZE + texture_y)));
+    vertices.append(sf::Vertex(sf::Vector2f(x, CELL_SIZE + y), i_color, sf::Vector2f(texture_x, CELL_SIZE + texture_y)));
+}
+
+// Draw all the sprites of this frame at once
+void EntityRenderer::draw(sf::RenderTarget& i_target) {
+    TRACE_ZONE("EntityRenderer::draw");
+
+    draw_calls = 0;
+
+    if (vertices.getVertexCount() != 0) {
+        i_target.draw(vertices, sf::RenderStates(&atlas));
+
+        draw_calls++;
+    }
+
+    vertices.clear();
+}
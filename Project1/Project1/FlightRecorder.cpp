@@ -0,0 +1,244 @@
+#include <algorithm> // For std::max and std::min
+#include <array>   // For std::array
+#include <atomic>  // For std::atomic_signal_fence
+#include <csignal> // For catching the crashes
+#include <cstddef> // For std::size_t
+#include <cstdio>  // For saving copies of the ring
+#include <string>  // For std::string
+#include <vector>  // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components (the game can draw itself)
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>  // For CreateFileMapping and MapViewOfFile
+#else
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap
+#include <unistd.h>   // For ftruncate and close
+#endif
+
+#include "Headers/Global.hpp"         // Header for global constants and definitions
+#include "Headers/Map.hpp"            // Header for the Map class definition
+#include "Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "Headers/Game.hpp"           // Header for the Game class definition
+#include "Headers/FlightRecorder.hpp" // Header for the FlightRecorder class definition
+
+// The signals we write into the header before the game dies
+constexpr std::array<int, 4> CRASH_SIGNALS = { SIGABRT, SIGFPE, SIGILL, SIGSEGV };
+
+// The header of the recorder that was opened last (the signal handler can't be given one)
+static FlightHeader* crash_header = nullptr;
+
+// Write the signal into the header, then die the way we would have died without us
+// The records are already in the mapped file, so this is all we have to do. (It's only a store, so it's safe in a signal handler.)
+static void handle_crash(int i_signal) {
+    if (crash_header != nullptr) {
+        crash_header->crash_signal = i_signal;
+    }
+
+    std::signal(i_signal, SIG_DFL);
+    std::raise(i_signal);
+}
+
+// Map a file of i_size bytes into memory (nullptr if we can't). The file stays open as long as it's mapped.
+static void* map_file(const std::string& i_file_name, std::size_t i_size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(i_file_name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<unsigned long long>(i_size) >> 32), static_cast<DWORD>(i_size), nullptr);
+
+    // The view keeps the mapping (and the file) alive
+    void* output = mapping == nullptr ? nullptr : MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, i_size);
+
+    if (mapping != nullptr) {
+        CloseHandle(mapping);
+    }
+
+    CloseHandle(file);
+
+    return output;
+#else
+    int file = open(i_file_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+
+    if (file == -1) {
+        return nullptr;
+    }
+
+    void* output = ftruncate(file, i_size) == -1 ? MAP_FAILED : mmap(nullptr, i_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+    close(file);
+
+    return output == MAP_FAILED ? nullptr : output;
+#endif
+}
+
+static void unmap_file(void* i_memory, std::size_t i_size) {
+#ifdef _WIN32
+    (void)i_size;
+
+    UnmapViewOfFile(i_memory);
+#else
+    munmap(i_memory, i_size);
+#endif
+}
+
+// Microseconds in 2 bytes
+static unsigned short get_short_duration(unsigned i_duration) {
+    return static_cast<unsigned short>(std::min(65535u, i_duration));
+}
+
+// Constructor for the FlightRecorder class (it records nothing until it's opened)
+FlightRecorder::FlightRecorder() :
+    size(0),
+    header(nullptr),
+    records(nullptr)
+{
+}
+
+FlightRecorder::~FlightRecorder() {
+    if (header != nullptr) {
+        if (crash_header == header) {
+            crash_header = nullptr;
+        }
+
+        unmap_file(header, size);
+    }
+}
+
+// Create the file and start catching crashes
+bool FlightRecorder::open(const std::string& i_file_name, unsigned short i_seconds) {
+    unsigned capacity = std::max(1u, static_cast<unsigned>(i_seconds) * (1000000 / FRAME_DURATION));
+
+    std::size_t new_size = sizeof(FlightHeader) + capacity * sizeof(FlightRecord);
+
+    void* memory = map_file(i_file_name, new_size);
+
+    if (memory == nullptr) {
+        return 0;
+    }
+
+    if (header != nullptr) {
+        unmap_file(header, size);
+    }
+
+    size = new_size;
+
+    // The file starts with zeros, so the counters do too
+    header = static_cast<FlightHeader*>(memory);
+    records = reinterpret_cast<FlightRecord*>(header + 1);
+
+    header->magic = FLIGHT_MAGIC;
+    header->version = FLIGHT_VERSION;
+    header->record_size = sizeof(FlightRecord);
+    header->capacity = capacity;
+
+    crash_header = header;
+
+    for (int crash_signal : CRASH_SIGNALS) {
+        std::signal(crash_signal, handle_crash);
+    }
+
+    return 1;
+}
+
+// Save the ring as it is now, in the same format
+bool FlightRecorder::save(const std::string& i_file_name) {
+    if (header == nullptr) {
+        return 0;
+    }
+
+    std::FILE* file = std::fopen(i_file_name.c_str(), "wb");
+
+    if (file == nullptr) {
+        return 0;
+    }
+
+    bool output = std::fwrite(header, 1, size, file) == size;
+
+    return std::fclose(file) == 0 && output;
+}
+
+// Write the record of a tick (a few dozen stores into the mapped file, no system calls)
+void FlightRecorder::record(unsigned i_frame, unsigned char i_input, unsigned char i_ghost_input, unsigned i_tick_duration, unsigned i_frame_duration, bool i_slow, Game& i_game) {
+    if (header == nullptr) {
+        return;
+    }
+
+    std::array<Ghost, 4>& ghosts = i_game.get_ghost_manager().get_ghosts();
+
+    FlightRecord& record = records[header->record_count % header->capacity];
+
+    // The events are the differences from the last tick
+    unsigned char previous_flags = 0;
+    unsigned short previous_energizer_timer = 0;
+
+    std::array<unsigned char, 4> previous_ghost_states{};
+
+    if (header->record_count != 0) {
+        const FlightRecord& previous_record = records[(header->record_count - 1) % header->capacity];
+
+        previous_flags = previous_record.flags;
+        previous_energizer_timer = previous_record.energizer_timer;
+        previous_ghost_states = previous_record.ghost_states;
+    }
+
+    record.events = i_slow ? FLIGHT_EVENT_SLOW_TICK : 0;
+    record.flags = (i_game.get_game_won() ? FLIGHT_FLAG_GAME_WON : 0) | (i_game.get_pacman().get_dead() ? FLIGHT_FLAG_PACMAN_DEAD : 0);
+    record.ghost_input = i_ghost_input;
+    record.input = i_input;
+    record.level = i_game.get_level();
+    record.pacman_direction = i_game.get_pacman().get_direction();
+    record.wave = i_game.get_ghost_manager().get_current_wave();
+    record.energizer_timer = i_game.get_pacman().get_energizer_timer();
+    record.wave_timer = i_game.get_ghost_manager().get_wave_timer();
+    record.frame_duration = get_short_duration(i_frame_duration);
+    record.tick_duration = get_short_duration(i_tick_duration);
+    record.frame = i_frame;
+    record.pacman_position = i_game.get_pacman().get_position();
+
+    for (unsigned char a = 0; a < 4; a++) {
+        record.ghost_directions[a] = ghosts[a].get_direction();
+        record.ghost_states[a] = ghosts[a].get_frightened_mode() | (ghosts[a].get_movement_mode() ? FLIGHT_GHOST_CHASE : 0) | (ghosts[a].get_use_door() ? FLIGHT_GHOST_USE_DOOR : 0);
+        record.ghost_positions[a] = ghosts[a].get_position();
+        record.ghost_targets[a] = ghosts[a].get_target();
+
+        if ((previous_ghost_states[a] & 3) != 2 && ghosts[a].get_frightened_mode() == 2) {
+            record.events |= FLIGHT_EVENT_GHOST_EATEN;
+        }
+    }
+
+    if (previous_energizer_timer < record.energizer_timer) {
+        record.events |= FLIGHT_EVENT_ENERGIZER;
+    }
+
+    if (previous_flags != 0 && record.flags == 0) {
+        record.events |= FLIGHT_EVENT_LEVEL_START;
+    }
+
+    if ((previous_flags & FLIGHT_FLAG_GAME_WON) == 0 && (record.flags & FLIGHT_FLAG_GAME_WON) != 0) {
+        record.events |= FLIGHT_EVENT_LEVEL_WON;
+    }
+
+    if ((previous_flags & FLIGHT_FLAG_PACMAN_DEAD) == 0 && (record.flags & FLIGHT_FLAG_PACMAN_DEAD) != 0) {
+        record.events |= FLIGHT_EVENT_PACMAN_DIED;
+    }
+
+    if (i_slow) {
+        header->slow_frame = i_frame;
+    }
+
+    // The record is complete before it's counted, so a crash can only lose the one being written
+    std::atomic_signal_fence(std::memory_order_release);
+
+    header->record_count++;
+}
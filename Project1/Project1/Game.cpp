@@ -0,0 +1,234 @@
+#include <algorithm> // For std::max and std::min
+#include <array>  // For std::array
+#include <cstddef> // For std::size_t
+#include <cstdio> // For std::snprintf
+#include <cstdlib> // For std::abort
+#include <string> // For std::string
+#include <vector> // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components
+
+#include "Headers/Global.hpp"        // Header for global constants and definitions
+#include "Headers/Map.hpp"           // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "Headers/DrawText.hpp"      // Header for drawing text on screen
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "Headers/Pacman.hpp"        // Header for Pac-Man class definition
+#include "Headers/Ghost.hpp"         // Header for Ghost class definition
+#include "Headers/GhostManager.hpp"  // Header for managing ghosts
+#include "Headers/MapSketch.hpp"     // Header for the default map sketch
+#include "Headers/CompiledSketch.hpp" // Header for the default map converted while compiling
+#include "Headers/ConvertSketch.hpp" // Header for converting map sketch to a game map
+#include "Headers/MapRenderer.hpp"   // Header for drawing the game map
+#include "Headers/Game.hpp"          // Header for the Game class definition
+#include "Headers/Trace.hpp"         // Header for the trace zones
+#include "Headers/Zobrist.hpp"       // Header for the Zobrist hash
+
+// Constructor for the Game class, starting at the first level
+Game::Game(bool i_versus, unsigned i_seed, const std::vector<std::string>& i_map_sketch) :
+    game_won(0),
+    versus(i_versus),
+    level(0),
+    ghost_simulation_radius(0),
+    seed(i_seed),
+    map_sketch(&i_map_sketch)
+{
+    reset();
+}
+
+// Check if every pellet was eaten
+bool Game::get_game_won() {
+    return game_won;
+}
+
+// Get the current level
+unsigned char Game::get_level() {
+    return level;
+}
+
+// Compute the hash of game_won, the level and the map from scratch
+static unsigned long long get_game_hash(bool i_game_won, unsigned char i_level, const Map& i_map) {
+    unsigned long long output = get_zobrist_key(HASH_GAME_WON, 0, i_game_won) ^ get_zobrist_key(HASH_LEVEL, 0, i_level);
+
+    for (unsigned short a = 0; a < i_map.get_height(); a++) {
+        for (unsigned short b = 0; b < i_map.get_width(); b++) {
+            output ^= get_zobrist_key(HASH_CELL, b + i_map.get_width() * a, i_map.get_cell(b, a));
+        }
+    }
+
+    return output;
+}
+
+// Where the camera starts on one axis: Pacman is in the middle, unless that shows something outside the map
+// (A map smaller than the view is drawn in the corner, like before there was a camera.)
+static float get_camera_start(short i_pacman_position, unsigned short i_map_size, unsigned char i_view_size) {
+    float output = i_pacman_position + 0.5f * CELL_SIZE * (1 - i_view_size);
+
+    return std::max(0.f, std::min<float>(output, CELL_SIZE * (i_map_size - i_view_size)));
+}
+
+// Compute the hash of everything from scratch
+unsigned long long Game::compute_hash() {
+    return get_game_hash(game_won, level, map) ^ pacman.compute_hash() ^ ghost_manager.compute_hash();
+}
+
+// Get the hash we updated while playing
+unsigned long long Game::get_hash() {
+    return hash ^ pacman.get_hash() ^ ghost_manager.get_hash();
+}
+
+// Draw the whole game (the caller clears and displays the window)
+void Game::draw(MapRenderer& i_map_renderer, EntityRenderer& i_entity_renderer, sf::RenderWindow& i_window) {
+    TRACE_ZONE("Game::draw");
+
+    // The text stays where it is, in the view of the window
+    sf::View window_view = i_window.getView();
+
+    // The camera shows VIEW_WIDTH x VIEW_HEIGHT cells around Pacman, above the text
+    sf::View camera(sf::FloatRect(
+        get_camera_start(pacman.get_position().x, map.get_width(), VIEW_WIDTH),
+        get_camera_start(pacman.get_position().y, map.get_height(), VIEW_HEIGHT),
+        CELL_SIZE * VIEW_WIDTH,
+        CELL_SIZE * VIEW_HEIGHT
+    ));
+
+    camera.setViewport(sf::FloatRect(0, 0, CELL_SIZE * VIEW_WIDTH / window_view.getSize().x, CELL_SIZE * VIEW_HEIGHT / window_view.getSize().y));
+
+    i_window.setView(camera);
+
+    if (!game_won && !pacman.get_dead()) {
+        // Draw the part of the game map the camera sees
+        i_map_renderer.draw(map, i_window);
+
+        // Add the ghosts, with a check for flashing state (ghosts are vulnerable)
+        ghost_manager.draw(level_settings.ghost_flash_start >= pacman.get_energizer_timer(), i_entity_renderer);
+    }
+
+    // Add Pac-Man with the game status
+    pacman.draw(game_won, i_entity_renderer);
+
+    // Draw Pac-Man and the ghosts in one draw call
+    i_entity_renderer.draw(i_window);
+
+    i_window.setView(window_view);
+
+    if (!game_won && !pacman.get_dead()) {
+        // Display the current level on the screen
+        // (Written into a buffer on the stack, so drawing it every frame doesn't allocate any memory)
+        char level_text[16];
+
+        std::snprintf(level_text, sizeof(level_text), "Level: %u", 1 + level);
+
+        draw_text(0, 0, CELL_SIZE * VIEW_HEIGHT, level_text, i_window);
+    }
+
+    if (pacman.get_animation_over()) {
+        if (game_won) {
+            // If the game is won, display "Next level!"
+            draw_text(1, 0, 0, "Next level!", i_window);
+        }
+        else {
+            // If Pac-Man died, display "Game over"
+            draw_text(1, 0, 0, "Game over", i_window);
+        }
+    }
+}
+
+// Reset the map, the ghosts and Pac-Man for the current level
+void Game::reset() {
+    reset(level, get_level_settings(level));
+}
+
+// Start a level with any settings
+void Game::reset(unsigned char i_level, const LevelSettings& i_level_settings) {
+    game_won = 0;
+    level = i_level;
+    level_settings = i_level_settings;
+
+    // The default map was converted while compiling
+    if (map_sketch == &get_map_sketch()) {
+        convert_sketch(DEFAULT_MAP, map, ghost_positions, pacman);
+    }
+    else {
+        convert_sketch(*map_sketch, map, ghost_positions, pacman);
+    }
+
+    // A new map, so we start our part of the hash again
+    hash = get_game_hash(game_won, level, map);
+
+    // Every level gets different (but still deterministic) random numbers
+    ghost_manager.reset(level_settings, seed + level, versus, ghost_positions);
+
+    pacman.reset();
+}
+
+// Set how far from Pacman the ghosts move in every tick
+void Game::set_ghost_simulation_radius(unsigned short i_ghost_simulation_radius) {
+    ghost_simulation_radius = i_ghost_simulation_radius;
+}
+
+// Simulate one frame
+void Game::update(unsigned char i_pacman_input, unsigned char i_ghost_input) {
+    TRACE_ZONE("Game::update");
+
+    // So we can update the hash at the end
+    bool previous_game_won = game_won;
+
+    if (!game_won && !pacman.get_dead()) {
+        // Update Pac-Man's state
+        pacman.update(level_settings, i_pacman_input, map, hash);
+
+        // Update ghost behavior
+        ghost_manager.update(level_settings, ghost_simulation_radius, i_ghost_input, map, pacman);
+
+        // The map counts the pellets, so we don't have to look at every cell (big maps have a lot of them)
+        game_won = map.get_pellet_count() == 0;
+
+        // If all pellets are collected, prepare for level transition
+        if (game_won) {
+            pacman.set_animation_timer(0);
+        }
+    }
+    else if ((i_pacman_input | i_ghost_input) & INPUT_RESTART) {
+        // If any player wants to restart, restart the game logic
+
+        if (pacman.get_dead()) {
+            level = 0; // Reset to level 0 if Pac-Man died
+        }
+        else {
+            // Increment level if Pac-Man won
+            level++;
+        }
+
+        game_won = 0; // Reset game_won flag
+
+        // Reset the map, the ghosts and Pac-Man for the new level (this starts the hash again)
+        reset();
+
+        previous_game_won = game_won;
+    }
+
+    update_zobrist_hash(HASH_GAME_WON, 0, previous_game_won, game_won, hash);
+
+    // In the debug mode, we check the hash we updated against the hash from scratch
+    if (CHECK_HASH && get_hash() != compute_hash()) {
+        std::printf("The hash is wrong after a tick (game %d, Pacman %d, ghosts %d).\n",
+            get_game_hash(game_won, level, map) != hash, pacman.compute_hash() != pacman.get_hash(), ghost_manager.compute_hash() != ghost_manager.get_hash());
+
+        std::abort();
+    }
+}
+
+// Get the ghosts
+GhostManager& Game::get_ghost_manager() {
+    return ghost_manager;
+}
+
+// Get the map
+Map& Game::get_map() {
+    return map;
+}
+
+// Get Pac-Man
+Pacman& Game::get_pacman() {
+    return pacman;
+}
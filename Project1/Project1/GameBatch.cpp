@@ -0,0 +1,609 @@
+#include <algorithm> // For std::max and std::min
+#include <array>  // For std::array
+#include <string> // For std::string
+#include <tuple>  // For the list of ghost personalities
+#include <vector> // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components (the headers of Pacman and the ghosts need them)
+
+#ifdef __AVX2__
+#include <immintrin.h> // For the AVX2 wall checks
+#endif
+
+#include "Headers/Global.hpp"        // Header for global constants and definitions
+#include "Headers/Map.hpp"           // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "Headers/Pacman.hpp"        // Header for Pac-Man class definition
+#include "Headers/Ghost.hpp"         // Header for Ghost class definition
+#include "Headers/GhostPersonalities.hpp" // Header for the ghost personalities
+#include "Headers/MapSketch.hpp"     // Header for the default map sketch
+#include "Headers/CompiledSketch.hpp" // Header for the sketches converted while compiling (ConvertSketch.hpp needs it)
+#include "Headers/ConvertSketch.hpp" // Header for converting map sketch to a game map
+#include "Headers/Random.hpp"        // Header for the deterministic random number generator
+#include "Headers/Trace.hpp"         // Header for the trace zones
+#include "Headers/GameBatch.hpp"     // Header for the GameBatch class definition
+
+// How a direction moves something (right, up, left, down)
+constexpr int DIRECTION_X[4] = { 1, 0, -1, 0 };
+constexpr int DIRECTION_Y[4] = { 0, -1, 0, 1 };
+
+// What blocks a cell (the door only blocks the things that can't use it)
+constexpr int BLOCKER_DOOR = 1;
+constexpr int BLOCKER_WALL = 2;
+
+static_assert(BATCH_LANES <= 32, "Every lane needs a bit in the masks.");
+
+// Is the lane in the mask?
+static bool get_lane(unsigned i_mask, unsigned char i_lane) {
+    return 1 & (i_mask >> i_lane);
+}
+
+#ifdef __AVX2__
+// The AVX2 kernels divide by shifting
+constexpr unsigned char CELL_SHIFT = 4;
+
+static_assert(1 << CELL_SHIFT == CELL_SIZE, "CELL_SHIFT must match CELL_SIZE.");
+static_assert(BATCH_LANES % 8 == 0, "The AVX2 kernels do 8 lanes at a time.");
+
+// The highest blocker of the 4 cells a CELL_SIZE x CELL_SIZE square touches, in 8 lanes at once
+// The cells outside the map are clamped into its border, where nothing blocks (like the bounds check in map_collision)
+static __m256i get_blockers_avx2(__m256i i_x, __m256i i_y, const int* i_blockers, int i_map_width, int i_map_height) {
+    const __m256i border_min = _mm256_set1_epi32(-1);
+    const __m256i border_x = _mm256_set1_epi32(i_map_width);
+    const __m256i border_y = _mm256_set1_epi32(i_map_height);
+    const __m256i corner = _mm256_set1_epi32(CELL_SIZE - 1);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i row = _mm256_set1_epi32(2 + i_map_width);
+
+    // An arithmetic shift rounds down, even for the negative coordinates in the tunnels
+    __m256i left = _mm256_min_epi32(border_x, _mm256_max_epi32(border_min, _mm256_srai_epi32(i_x, CELL_SHIFT)));
+    __m256i right = _mm256_min_epi32(border_x, _mm256_max_epi32(border_min, _mm256_srai_epi32(_mm256_add_epi32(i_x, corner), CELL_SHIFT)));
+    __m256i top = _mm256_min_epi32(border_y, _mm256_max_epi32(border_min, _mm256_srai_epi32(i_y, CELL_SHIFT)));
+    __m256i bottom = _mm256_min_epi32(border_y, _mm256_max_epi32(border_min, _mm256_srai_epi32(_mm256_add_epi32(i_y, corner), CELL_SHIFT)));
+
+    // The border is the first row and the first column
+    __m256i top_row = _mm256_mullo_epi32(_mm256_add_epi32(top, one), row);
+    __m256i bottom_row = _mm256_mullo_epi32(_mm256_add_epi32(bottom, one), row);
+
+    left = _mm256_add_epi32(left, one);
+    right = _mm256_add_epi32(right, one);
+
+    __m256i output = _mm256_i32gather_epi32(i_blockers, _mm256_add_epi32(top_row, left), 4);
+    output = _mm256_max_epi32(output, _mm256_i32gather_epi32(i_blockers, _mm256_add_epi32(top_row, right), 4));
+    output = _mm256_max_epi32(output, _mm256_i32gather_epi32(i_blockers, _mm256_add_epi32(bottom_row, left), 4));
+
+    return _mm256_max_epi32(output, _mm256_i32gather_epi32(i_blockers, _mm256_add_epi32(bottom_row, right), 4));
+}
+#endif
+
+// Constructor for the GameBatch class (reset starts the games)
+GameBatch::GameBatch() :
+    simd(get_simd_available()),
+    level(0),
+    map_height(0),
+    map_width(0),
+    playing(0)
+{
+}
+
+// Check if we were compiled with the AVX2 kernels
+bool GameBatch::get_simd_available() {
+#ifdef __AVX2__
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+// Check if a game ate every pellet
+bool GameBatch::get_game_won(unsigned char i_lane) const {
+    return game_won[i_lane];
+}
+
+// Check if the ghosts of a game are chasing (1) or scattering (0)
+bool GameBatch::get_movement_mode(unsigned char i_lane) const {
+    return movement_mode[i_lane];
+}
+
+// Check if Pacman died in a game
+bool GameBatch::get_pacman_dead(unsigned char i_lane) const {
+    return pacman_dead[i_lane];
+}
+
+// Get which scatter/chase wave a game is in
+unsigned char GameBatch::get_current_wave(unsigned char i_lane) const {
+    return static_cast<unsigned char>(current_wave[i_lane]);
+}
+
+// Get where Pacman is going in a game
+unsigned char GameBatch::get_pacman_direction(unsigned char i_lane) const {
+    return static_cast<unsigned char>(pacman_direction[i_lane]);
+}
+
+// Get the energizer timer of a game
+unsigned short GameBatch::get_energizer_timer(unsigned char i_lane) const {
+    return static_cast<unsigned short>(energizer_timer[i_lane]);
+}
+
+// Get how long the current wave of a game has left
+unsigned short GameBatch::get_wave_timer(unsigned char i_lane) const {
+    return static_cast<unsigned short>(wave_timer[i_lane]);
+}
+
+// Get the games that are still playing
+unsigned GameBatch::get_playing() const {
+    return playing;
+}
+
+// Get how many pellets a game has left
+unsigned GameBatch::get_pellet_count(unsigned char i_lane) const {
+    return pellet_count[i_lane];
+}
+
+// Get the ghosts with an index in GhostManager
+const BatchGhosts& GameBatch::get_ghosts(unsigned char i_index) const {
+    return ghosts[i_index];
+}
+
+// Get where Pacman is in a game
+Position GameBatch::get_pacman_position(unsigned char i_lane) const {
+    return { static_cast<short>(pacman_x[i_lane]), static_cast<short>(pacman_y[i_lane]) };
+}
+
+// The highest blocker of the 4 cells a CELL_SIZE x CELL_SIZE square touches (the plain version of get_blockers_avx2)
+int GameBatch::get_blocker(int i_x, int i_y) const {
+    int left = 1 + std::min<int>(map_width, std::max<int>(-1, get_floor_cell(i_x)));
+    int right = 1 + std::min<int>(map_width, std::max<int>(-1, get_floor_cell(CELL_SIZE - 1 + i_x)));
+    int top_row = (2 + map_width) * (1 + std::min<int>(map_height, std::max<int>(-1, get_floor_cell(i_y))));
+    int bottom_row = (2 + map_width) * (1 + std::min<int>(map_height, std::max<int>(-1, get_floor_cell(CELL_SIZE - 1 + i_y))));
+
+    return std::max(std::max(blockers[left + top_row], blockers[right + top_row]), std::max(blockers[left + bottom_row], blockers[right + bottom_row]));
+}
+
+// Start the level in every lane, like Game::reset does
+void GameBatch::reset(const std::vector<std::string>& i_map_sketch, unsigned char i_level, const LevelSettings& i_level_settings, const std::array<unsigned, BATCH_LANES>& i_seeds) {
+    // Pacman only tells us where he starts
+    Pacman pacman;
+
+    convert_sketch(i_map_sketch, map, ghost_starts, pacman);
+
+    level = i_level;
+
+    map_height = map.get_height();
+    map_width = map.get_width();
+
+    level_settings = i_level_settings;
+
+    playing = 0;
+
+    // The blue ghost's position is the house, and the red ghost's position is its exit (see GhostManager::reset)
+    home = ghost_starts[2];
+    home_exit = ghost_starts[0];
+    pacman_start = pacman.get_position();
+
+    blockers.assign((2 + map_width) * (2 + map_height), 0);
+    energizer_lanes.assign(map_width * map_height, 0);
+    pellet_lanes.assign(map_width * map_height, 0);
+
+    for (unsigned short a = 0; a < map_height; a++) {
+        for (unsigned short b = 0; b < map_width; b++) {
+            Cell cell = map.get_cell(b, a);
+
+            blockers[1 + b + (2 + map_width) * (1 + a)] = cell == Cell::Wall ? BLOCKER_WALL : (cell == Cell::Door ? BLOCKER_DOOR : 0);
+        }
+    }
+
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        reset_lane(a, i_seeds[a]);
+    }
+}
+
+// Start the level again in one lane, with a new seed
+void GameBatch::reset_lane(unsigned char i_lane, unsigned i_seed) {
+    // The personalities that start in the house can use the door
+    std::array<bool, 4> use_door = { GhostPersonality<0>::USE_DOOR, GhostPersonality<1>::USE_DOOR, GhostPersonality<2>::USE_DOOR, GhostPersonality<3>::USE_DOOR };
+
+    unsigned bit = 1u << i_lane;
+
+    // The pellets and the energizers come back
+    for (unsigned short a = 0; a < map_height; a++) {
+        for (unsigned short b = 0; b < map_width; b++) {
+            Cell cell = map.get_cell(b, a);
+
+            energizer_lanes[b + map_width * a] = cell == Cell::Energizer ? energizer_lanes[b + map_width * a] | bit : energizer_lanes[b + map_width * a];
+            pellet_lanes[b + map_width * a] = cell == Cell::Pellet ? pellet_lanes[b + map_width * a] | bit : pellet_lanes[b + map_width * a];
+        }
+    }
+
+    playing |= bit;
+
+    current_wave[i_lane] = 0;
+    energizer_timer[i_lane] = 0;
+    game_won[i_lane] = 0;
+    movement_mode[i_lane] = 0;
+    pacman_dead[i_lane] = 0;
+    pacman_direction[i_lane] = 0;
+    pacman_movement_phase[i_lane] = 0;
+    pacman_turn[i_lane] = 0;
+    pacman_turn_timer[i_lane] = 0;
+    pacman_x[i_lane] = pacman_start.x;
+    pacman_y[i_lane] = pacman_start.y;
+    pellet_count[i_lane] = map.get_pellet_count();
+    wave_timer[i_lane] = level_settings.long_scatter_duration;
+
+    for (unsigned char a = 0; a < 4; a++) {
+        BatchGhosts& ghost = ghosts[a];
+
+        ghost.direction[i_lane] = 0;
+        ghost.frightened_mode[i_lane] = 0;
+        ghost.frightened_speed_timer[i_lane] = 0;
+        ghost.movement_phase[i_lane] = 0;
+        ghost.target_x[i_lane] = home_exit.x;
+        ghost.target_y[i_lane] = home_exit.y;
+        ghost.use_door[i_lane] = use_door[a];
+        ghost.x[i_lane] = ghost_starts[a].x;
+        ghost.y[i_lane] = ghost_starts[a].y;
+
+        // Every level gets different random numbers, and every ghost has its own
+        ghost.random_state[i_lane] = seed_random(i_seed + level, a);
+    }
+}
+
+// Choose between the AVX2 kernels and the plain ones
+void GameBatch::set_simd(bool i_simd) {
+    simd = i_simd && get_simd_available();
+}
+
+// Simulate one tick of every game that's still playing (in the same order as Game::update)
+void GameBatch::update(const std::array<unsigned char, BATCH_LANES>& i_inputs) {
+    TRACE_ZONE("GameBatch::update");
+
+    update_pacman(i_inputs);
+    update_waves();
+
+    // Every ghost reads where the red ghost was before the ghosts moved
+    BatchLanes ghost_0_x = ghosts[0].x;
+    BatchLanes ghost_0_y = ghosts[0].y;
+
+    update_ghost<GhostPersonality<0>>(0, ghost_0_x, ghost_0_y);
+    update_ghost<GhostPersonality<1>>(1, ghost_0_x, ghost_0_y);
+    update_ghost<GhostPersonality<2>>(2, ghost_0_x, ghost_0_y);
+    update_ghost<GhostPersonality<3>>(3, ghost_0_x, ghost_0_y);
+
+    update_collisions();
+}
+
+// The ghosts that touch Pacman kill him or get eaten (like Ghost::resolve_pacman_collision), then the games that are over stop playing
+void GameBatch::update_collisions() {
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        bool active = get_lane(playing, a);
+        bool caught = 0;
+
+        int x = pacman_x[a];
+        int y = pacman_y[a];
+
+        for (BatchGhosts& ghost : ghosts) {
+            bool touching = active && ghost.x[a] > x - CELL_SIZE && ghost.x[a] < CELL_SIZE + x && ghost.y[a] > y - CELL_SIZE && ghost.y[a] < CELL_SIZE + y;
+            bool eaten = touching && ghost.frightened_mode[a] != 0;
+
+            caught |= touching && ghost.frightened_mode[a] == 0;
+
+            ghost.frightened_mode[a] = eaten ? 2 : ghost.frightened_mode[a];
+            ghost.target_x[a] = eaten ? home.x : ghost.target_x[a];
+            ghost.target_y[a] = eaten ? home.y : ghost.target_y[a];
+            ghost.use_door[a] = eaten ? 1 : ghost.use_door[a];
+        }
+
+        pacman_dead[a] |= caught;
+
+        // Like Game::update, a game can be won in the tick Pacman dies
+        game_won[a] = active ? pellet_count[a] == 0 : game_won[a];
+    }
+
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        playing &= ~(static_cast<unsigned>(pacman_dead[a] | game_won[a]) << a);
+    }
+}
+
+// Update the ghosts with one personality in every lane, like GhostManager::update_ghost and Ghost::update
+template <typename Personality>
+void GameBatch::update_ghost(unsigned char i_index, const BatchLanes& i_ghost_0_x, const BatchLanes& i_ghost_0_y) {
+    BatchGhosts& ghost = ghosts[i_index];
+
+    // Where we'll draw the random numbers again (see below), and where going back is
+    unsigned redraw = 0;
+
+    BatchLanes moving;
+    BatchLanes reverse;
+
+    Position scatter_target = Personality::get_scatter_target(map);
+
+    unsigned char escape_alignment = static_cast<unsigned char>(std::max(1, level_settings.ghost_escape_speed / TICK_MULTIPLIER));
+
+    // The target, the frightened mode and the speed
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        bool active = get_lane(playing, a);
+
+        int frightened_mode = ghost.frightened_mode[a];
+        int frightened_speed_timer = ghost.frightened_speed_timer[a];
+        int movement_phase = ghost.movement_phase[a];
+        int x = ghost.x[a];
+        int y = ghost.y[a];
+
+        // Our personality picks the target outside the house
+        Position chase_target = Personality::get_chase_target(
+            Position{ static_cast<short>(x), static_cast<short>(y) },
+            static_cast<unsigned char>(pacman_direction[a]),
+            Position{ static_cast<short>(i_ghost_0_x[a]), static_cast<short>(i_ghost_0_y[a]) },
+            Position{ static_cast<short>(pacman_x[a]), static_cast<short>(pacman_y[a]) },
+            map,
+            level_settings);
+
+        bool outside = ghost.use_door[a] == 0;
+
+        int target_x = outside ? (movement_mode[a] ? chase_target.x : scatter_target.x) : ghost.target_x[a];
+        int target_y = outside ? (movement_mode[a] ? chase_target.y : scatter_target.y) : ghost.target_y[a];
+        int use_door = ghost.use_door[a];
+
+        int speed = get_step(level_settings.ghost_speed, static_cast<unsigned char>(movement_phase));
+
+        // Pacman ate an energizer, or it ran out
+        bool frighten = frightened_mode == 0 && energizer_timer[a] == level_settings.energizer_duration;
+        bool calm = !frighten && energizer_timer[a] == 0 && frightened_mode == 1;
+
+        frightened_speed_timer = frighten ? level_settings.ghost_frightened_speed : frightened_speed_timer;
+        frightened_mode = frighten ? 1 : (calm ? 0 : frightened_mode);
+
+        // The eaten ghost runs home faster (once it's aligned to the escape steps), and the frightened one has its own timer
+        bool escaping = frightened_mode == 2 && x % escape_alignment == 0 && y % escape_alignment == 0;
+
+        speed = escaping ? get_step(level_settings.ghost_escape_speed, static_cast<unsigned char>(movement_phase)) : (frightened_mode == 1 ? level_settings.ghost_speed : speed);
+
+        movement_phase = (1 + movement_phase) % TICK_MULTIPLIER;
+
+        // Leaving the house, or back in it (like Ghost::update_house_target)
+        bool arrived = use_door && x == target_x && y == target_y;
+        bool out = arrived && target_x == home_exit.x && target_y == home_exit.y;
+        bool in = arrived && !out && target_x == home.x && target_y == home.y;
+
+        use_door = out ? 0 : use_door;
+        frightened_mode = in ? 0 : frightened_mode;
+        target_x = in ? home_exit.x : target_x;
+        target_y = in ? home_exit.y : target_y;
+
+        ghost.frightened_mode[a] = active ? frightened_mode : ghost.frightened_mode[a];
+        ghost.frightened_speed_timer[a] = active ? frightened_speed_timer : ghost.frightened_speed_timer[a];
+        ghost.movement_phase[a] = active ? movement_phase : ghost.movement_phase[a];
+        ghost.target_x[a] = active ? target_x : ghost.target_x[a];
+        ghost.target_y[a] = active ? target_y : ghost.target_y[a];
+        ghost.use_door[a] = active ? use_door : ghost.use_door[a];
+
+        speeds[a] = speed;
+    }
+
+    update_walls(ghost.use_door, ghost.x, ghost.y);
+
+    // The direction
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        bool active = get_lane(playing, a);
+
+        int direction = ghost.direction[a];
+        int frightened_mode = ghost.frightened_mode[a];
+        int frightened_speed_timer = ghost.frightened_speed_timer[a];
+
+        unsigned random_state = ghost.random_state[a];
+
+        reverse[a] = (2 + direction) % 4;
+
+        // The closest way to the target that doesn't go back (the first one wins a tie)
+        int optimal_direction = 4;
+        int available_ways = 0;
+
+        unsigned optimal_distance = 0;
+
+        for (unsigned char b = 0; b < 4; b++) {
+            bool open = b != reverse[a] && !walls[b][a];
+
+            int x = GHOST_SPEED * DIRECTION_X[b] + ghost.x[a] - ghost.target_x[a];
+            int y = GHOST_SPEED * DIRECTION_Y[b] + ghost.y[a] - ghost.target_y[a];
+
+            unsigned distance = static_cast<unsigned>(x * x) + static_cast<unsigned>(y * y);
+
+            bool better = open && (optimal_direction == 4 || distance < optimal_distance);
+
+            optimal_direction = better ? b : optimal_direction;
+            optimal_distance = better ? distance : optimal_distance;
+            available_ways += open;
+        }
+
+        bool frightened = frightened_mode == 1;
+        bool chasing = !frightened && speeds[a] != 0;
+
+        // The frightened ghost draws a random direction in every tick, but only moves when its timer runs out
+        unsigned next_random_state = random_state;
+
+        int random_direction = get_random(next_random_state) % 4;
+
+        bool frightened_move = frightened && frightened_speed_timer == 0;
+
+        frightened_speed_timer = frightened ? (frightened_speed_timer == 0 ? level_settings.ghost_frightened_speed : frightened_speed_timer - 1) : frightened_speed_timer;
+        random_state = frightened ? next_random_state : random_state;
+
+        // The random direction can hit a wall (or go back), then we draw again below
+        bool draw_again = active && frightened_move && available_ways > 0 && (walls[random_direction][a] || random_direction == reverse[a]);
+
+        int chase_direction = optimal_direction == 4 ? reverse[a] : optimal_direction;
+        int frightened_direction = available_ways > 0 ? random_direction : reverse[a];
+
+        direction = chasing ? chase_direction : (frightened_move ? frightened_direction : direction);
+
+        redraw |= static_cast<unsigned>(draw_again) << a;
+        moving[a] = chasing || frightened_move;
+
+        ghost.direction[a] = active ? direction : ghost.direction[a];
+        ghost.frightened_speed_timer[a] = active ? frightened_speed_timer : ghost.frightened_speed_timer[a];
+        ghost.random_state[a] = active ? random_state : ghost.random_state[a];
+    }
+
+    // Like the while loop in Ghost::update: every game has its own random numbers, so the lanes that found a way just wait for the others
+    while (redraw != 0) {
+        for (unsigned char a = 0; a < BATCH_LANES; a++) {
+            bool again = get_lane(redraw, a);
+
+            unsigned random_state = ghost.random_state[a];
+
+            int random_direction = get_random(random_state) % 4;
+
+            bool blocked = walls[random_direction][a] || random_direction == reverse[a];
+
+            ghost.direction[a] = again ? random_direction : ghost.direction[a];
+            ghost.random_state[a] = again ? random_state : ghost.random_state[a];
+
+            redraw &= ~(static_cast<unsigned>(again && !blocked) << a);
+        }
+    }
+
+    // The move, and the warp tunnels
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        bool move = get_lane(playing, a) && moving[a];
+
+        int speed = move ? speeds[a] : 0;
+        int x = DIRECTION_X[ghost.direction[a]] * speed + ghost.x[a];
+        int y = DIRECTION_Y[ghost.direction[a]] * speed + ghost.y[a];
+
+        x = move && x < -CELL_SIZE ? x + CELL_SIZE * (1 + map_width) : (move && x >= CELL_SIZE * map_width ? x - CELL_SIZE * (1 + map_width) + speed : x);
+
+        ghost.x[a] = x;
+        ghost.y[a] = y;
+    }
+}
+
+// Update Pacman in every lane, like Pacman::update
+void GameBatch::update_pacman(const std::array<unsigned char, BATCH_LANES>& i_inputs) {
+    BatchLanes no_door = {};
+
+    // Even in the ticks he doesn't move, he looks ahead, so he can turn as soon as possible
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        speeds[a] = std::max(1, static_cast<int>(get_step(level_settings.pacman_speed, static_cast<unsigned char>(pacman_movement_phase[a]))));
+    }
+
+    update_walls(no_door, pacman_x, pacman_y);
+
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        bool active = get_lane(playing, a);
+        bool turning = (i_inputs[a] & INPUT_TURN) != 0;
+
+        int direction = pacman_direction[a];
+        int input = i_inputs[a];
+        int speed = get_step(level_settings.pacman_speed, static_cast<unsigned char>(pacman_movement_phase[a]));
+        int turn = turning ? (input >> 5) & 3 : pacman_turn[a];
+        int turn_timer = turning ? TURN_BUFFER_DURATION : pacman_turn_timer[a];
+
+        // The last direction pressed without a wall wins
+        direction = (input & 1) && !walls[0][a] ? 0 : direction;
+        direction = (input & 2) && !walls[1][a] ? 1 : direction;
+        direction = (input & 4) && !walls[2][a] ? 2 : direction;
+        direction = (input & 8) && !walls[3][a] ? 3 : direction;
+
+        // The remembered turn wins over that
+        bool turned = 0 < turn_timer && !walls[turn][a];
+
+        direction = turned ? turn : direction;
+        turn_timer = turned ? 0 : std::max(0, turn_timer - 1);
+
+        speed = walls[direction][a] ? 0 : speed;
+
+        int x = DIRECTION_X[direction] * speed + pacman_x[a];
+        int y = DIRECTION_Y[direction] * speed + pacman_y[a];
+
+        x = x < -CELL_SIZE ? x + CELL_SIZE * (1 + map_width) : (x >= CELL_SIZE * map_width ? x - CELL_SIZE * (1 + map_width) + speed : x);
+
+        pacman_direction[a] = active ? direction : pacman_direction[a];
+        pacman_movement_phase[a] = active ? (1 + pacman_movement_phase[a]) % TICK_MULTIPLIER : pacman_movement_phase[a];
+        pacman_turn[a] = active ? turn : pacman_turn[a];
+        pacman_turn_timer[a] = active ? turn_timer : pacman_turn_timer[a];
+        pacman_x[a] = active ? x : pacman_x[a];
+        pacman_y[a] = active ? y : pacman_y[a];
+    }
+
+    // The pellets and energizers he touches (the lanes can share a cell, so this one goes lane by lane)
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        bool energized = 0;
+
+        int left = get_floor_cell(pacman_x[a]);
+        int top = get_floor_cell(pacman_y[a]);
+
+        for (unsigned char b = 0; b < 4; b++) {
+            int x = b % 2 == 0 ? left : get_floor_cell(CELL_SIZE - 1 + pacman_x[a]);
+            int y = b < 2 ? top : get_floor_cell(CELL_SIZE - 1 + pacman_y[a]);
+
+            bool inside = 0 <= x && 0 <= y && x < map_width && y < map_height;
+
+            unsigned bit = static_cast<unsigned>(inside && get_lane(playing, a)) << a;
+            unsigned cell = inside ? x + map_width * y : 0;
+
+            energized |= (energizer_lanes[cell] & bit) != 0;
+            pellet_count[a] -= (pellet_lanes[cell] & bit) != 0;
+
+            energizer_lanes[cell] &= ~bit;
+            pellet_lanes[cell] &= ~bit;
+        }
+
+        int timer = energized ? level_settings.energizer_duration : std::max(0, energizer_timer[a] - 1);
+
+        energizer_timer[a] = get_lane(playing, a) ? timer : energizer_timer[a];
+    }
+}
+
+// Check the walls in the 4 directions of something at (i_x, i_y) in every lane, speeds pixels away (like the 4 map_collision calls in Pacman::update and Ghost::update)
+void GameBatch::update_walls(const BatchLanes& i_use_door, const BatchLanes& i_x, const BatchLanes& i_y) {
+#ifdef __AVX2__
+    if (simd) {
+        const __m256i one = _mm256_set1_epi32(1);
+
+        for (unsigned char a = 0; a < BATCH_LANES; a += 8) {
+            __m256i use_door = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&i_use_door[a]));
+            __m256i speed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&speeds[a]));
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&i_x[a]));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&i_y[a]));
+
+            __m256i blocker_lanes[4] = {
+                get_blockers_avx2(_mm256_add_epi32(x, speed), y, blockers.data(), map_width, map_height),
+                get_blockers_avx2(x, _mm256_sub_epi32(y, speed), blockers.data(), map_width, map_height),
+                get_blockers_avx2(_mm256_sub_epi32(x, speed), y, blockers.data(), map_width, map_height),
+                get_blockers_avx2(x, _mm256_add_epi32(y, speed), blockers.data(), map_width, map_height)
+            };
+
+            // The door only blocks the ones that can't use it (a blocker higher than use_door)
+            for (unsigned char b = 0; b < 4; b++) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&walls[b][a]), _mm256_and_si256(one, _mm256_cmpgt_epi32(blocker_lanes[b], use_door)));
+            }
+        }
+
+        return;
+    }
+#endif
+
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        walls[0][a] = i_use_door[a] < get_blocker(speeds[a] + i_x[a], i_y[a]);
+        walls[1][a] = i_use_door[a] < get_blocker(i_x[a], i_y[a] - speeds[a]);
+        walls[2][a] = i_use_door[a] < get_blocker(i_x[a] - speeds[a], i_y[a]);
+        walls[3][a] = i_use_door[a] < get_blocker(i_x[a], speeds[a] + i_y[a]);
+    }
+}
+
+// Update the scatter/chase waves in every lane, like GhostManager::update (they wait while Pacman is energized)
+void GameBatch::update_waves() {
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        bool counting = get_lane(playing, a) && energizer_timer[a] == 0;
+        bool next_wave = counting && wave_timer[a] == 0;
+        bool switch_mode = next_wave && current_wave[a] < 7;
+
+        current_wave[a] += switch_mode;
+        movement_mode[a] ^= static_cast<int>(switch_mode);
+
+        int duration = current_wave[a] % 2 == 1 ? level_settings.chase_duration : (current_wave[a] == 2 ? level_settings.long_scatter_duration : level_settings.short_scatter_duration);
+
+        wave_timer[a] = next_wave ? duration : wave_timer[a] - counting;
+    }
+}
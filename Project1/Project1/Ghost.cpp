@@ -1,19 +1,49 @@
+#include <algorithm> // For std::max
 #include <array>  // For std::array
-#include <cmath>  // For mathematical operations like sqrt and pow
+#include <cmath>  // For mathematical operations like floor
+#include <vector> // For std::vector
 #include <SFML/Graphics.hpp> // For SFML graphics components
 
 #include "Headers/Global.hpp"     // Header for global constants and definitions
+#include "Headers/Map.hpp"           // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
 #include "Headers/Pacman.hpp"     // Header for Pac-Man class definition
 #include "Headers/Ghost.hpp"      // Header for Ghost class definition
 #include "Headers/MapCollision.hpp" // Header for map collision handling
+#include "Headers/Random.hpp"     // Header for the deterministic random number generator
+#include "Headers/Trace.hpp"      // Header for the trace zones
+#include "Headers/Zobrist.hpp"    // Header for the Zobrist hash
 
 // Constructor for the Ghost class with a unique ID
 Ghost::Ghost(unsigned char i_id) :
-    id(i_id)  // Initialize the ghost ID
+    id(i_id),  // Initialize the ghost ID
+    hash(0),  // The hash starts when the ghost is reset
+    position({ 0, 0 })
 {
     // Fun comment about a common typo
 }
 
+// Outside the house, the target is picked again at the start of every tick, so it's not part of the game (or the hash)
+static Position get_hashed_target(bool i_use_door, const Position& i_target) {
+    return i_use_door ? i_target : Position{ 0, 0 };
+}
+
+// Check if the ghost is chasing (1) or scattering (0)
+bool Ghost::get_movement_mode() {
+    return movement_mode;
+}
+
+// Check if the ghost may go through the door of the house
+bool Ghost::get_use_door() {
+    return use_door;
+}
+
+// Check if the second player drives the ghost
+bool Ghost::get_player_controlled() {
+    return player_controlled;
+}
+
 // Check if the ghost collides with Pac-Man
 bool Ghost::pacman_collision(const Position& i_pacman_position) {
     // Basic collision check: if the ghost is within one CELL_SIZE of Pac-Man in both x and y axes
@@ -23,8 +53,60 @@ bool Ghost::pacman_collision(const Position& i_pacman_position) {
         position.y < i_pacman_position.y + CELL_SIZE);
 }
 
-// Get the distance from the ghost to its target in a specific direction
-float Ghost::get_target_distance(unsigned char i_direction) {
+// Get the ghost's current direction
+unsigned char Ghost::get_direction() {
+    return direction;
+}
+
+// Get the ghost's frightened mode
+unsigned char Ghost::get_frightened_mode() {
+    return frightened_mode;
+}
+
+// Pick the direction the player wants, if the walls let us go there (4 means none)
+unsigned char Ghost::get_player_direction(unsigned char i_input, const std::array<bool, 4>& i_walls) {
+    unsigned char output = 4;
+
+    // Just like Pacman, the last pressed direction wins
+    for (unsigned char a = 0; a < 4; a++) {
+        if ((i_input & (1 << a)) && !i_walls[a]) {
+            output = a;
+        }
+    }
+
+    return output;
+}
+
+// Compute our part of the hash from scratch (while playing, we only update it when something changes)
+unsigned long long Ghost::compute_hash() {
+    Position hashed_target = get_hashed_target(use_door, target);
+
+    return get_zobrist_key(HASH_GHOST_DIRECTION, id, direction) ^
+        get_zobrist_key(HASH_GHOST_FRIGHTENED_MODE, id, frightened_mode) ^
+        get_zobrist_key(HASH_GHOST_FRIGHTENED_SPEED_TIMER, id, frightened_speed_timer) ^
+        get_zobrist_key(HASH_GHOST_HOME, 4 * id, home.x) ^
+        get_zobrist_key(HASH_GHOST_HOME, 1 + 4 * id, home.y) ^
+        get_zobrist_key(HASH_GHOST_HOME, 2 + 4 * id, home_exit.x) ^
+        get_zobrist_key(HASH_GHOST_HOME, 3 + 4 * id, home_exit.y) ^
+        get_zobrist_key(HASH_GHOST_MOVEMENT_MODE, id, movement_mode) ^
+        get_zobrist_key(HASH_GHOST_MOVEMENT_PHASE, id, movement_phase) ^
+        get_zobrist_key(HASH_GHOST_PLAYER_CONTROLLED, id, player_controlled) ^
+        get_zobrist_key(HASH_GHOST_POSITION, 2 * id, position.x) ^
+        get_zobrist_key(HASH_GHOST_POSITION, 1 + 2 * id, position.y) ^
+        get_zobrist_key(HASH_GHOST_RANDOM_STATE, id, random_state) ^
+        get_zobrist_key(HASH_GHOST_TARGET, 2 * id, hashed_target.x) ^
+        get_zobrist_key(HASH_GHOST_TARGET, 1 + 2 * id, hashed_target.y) ^
+        get_zobrist_key(HASH_GHOST_USE_DOOR, id, use_door);
+}
+
+// Get our part of the hash
+unsigned long long Ghost::get_hash() {
+    return hash;
+}
+
+// Get the squared distance from the ghost to its target in a specific direction
+// We only compare distances, so there's no need for sqrt (and integers are the same on every computer)
+unsigned Ghost::get_target_distance(unsigned char i_direction) {
     // Copy the ghost's current position
     short x = position.x;
     short y = position.y;
@@ -37,71 +119,35 @@ float Ghost::get_target_distance(unsigned char i_direction) {
     case 3: y += GHOST_SPEED; break;  // Down
     }
 
-    // Calculate the distance to the target using the Pythagorean theorem
-    return static_cast<float>(sqrt(pow(x - target.x, 2) + pow(y - target.y, 2)));
+    // Calculate the squared distance to the target using the Pythagorean theorem
+    return static_cast<unsigned>((x - target.x) * (x - target.x)) + static_cast<unsigned>((y - target.y) * (y - target.y));
 }
 
-// Draw the ghost on the SFML render window, handling animation and frightened states
-void Ghost::draw(bool i_flash, sf::RenderWindow& i_window) {
+// Add the ghost to the sprites of this frame, handling animation and frightened states
+void Ghost::draw(bool i_flash, const sf::Color& i_color, EntityRenderer& i_renderer) {
     // Determine the current frame of animation based on the animation timer and speed
     unsigned char body_frame = static_cast<unsigned char>(floor(animation_timer / static_cast<float>(GHOST_ANIMATION_SPEED)));
 
-    sf::Sprite body;  // Sprite for the ghost's body
-    sf::Sprite face;  // Sprite for the ghost's face
-
-    // Load the ghost texture
-    sf::Texture texture;
-    texture.loadFromFile("Resources/Images/Ghost" + std::to_string(CELL_SIZE) + ".png");
-
-    // Set up the body sprite and its position
-    body.setTexture(texture);
-    body.setPosition(position.x, position.y);
-    // Set the texture rectangle to get the correct frame for animation
-    body.setTextureRect(sf::IntRect(CELL_SIZE * body_frame, 0, CELL_SIZE, CELL_SIZE));
-
-    // Set up the face sprite and its position
-    face.setTexture(texture);
-    face.setPosition(position.x, position.y);
-
     // Handle the animation and coloring based on the ghost's state
     if (frightened_mode == 0) {  // Not frightened
-        // Set the body color based on the ghost's ID (red, pink, cyan, orange)
-        switch (id) {
-        case 0: body.setColor(sf::Color(255, 0, 0)); break;
-        case 1: body.setColor(sf::Color(255, 182, 255)); break;
-        case 2: body.setColor(sf::Color(0, 255, 255)); break;
-        case 3: body.setColor(sf::Color(255, 182, 85)); break;
-        }
-
-        // Set the face's texture rectangle based on the ghost's direction
-        face.setTextureRect(sf::IntRect(CELL_SIZE * direction, CELL_SIZE, CELL_SIZE, CELL_SIZE));
-
-        // Draw the body sprite on the window
-        i_window.draw(body);
-
+        // Our personality decides the color of the body, and the face looks where we're going
+        i_renderer.add_sprite(EntitySheet::GhostSheet, CELL_SIZE * body_frame, 0, position.x, position.y, i_color);
+        i_renderer.add_sprite(EntitySheet::GhostSheet, CELL_SIZE * direction, CELL_SIZE, position.x, position.y, sf::Color(255, 255, 255));
     }
     else if (frightened_mode == 1) {  // Frightened mode
-        body.setColor(sf::Color(36, 36, 255)); // Frightened ghosts are blue
-
-        // Set the texture rectangle for the frightened face
-        face.setTextureRect(sf::IntRect(4 * CELL_SIZE, CELL_SIZE, CELL_SIZE, CELL_SIZE));
-
-        // Flash the ghost's body and face when frightened (for flashing state)
+        // Frightened ghosts are blue, and they flash white (with a red face) when the energizer is running out
         if (i_flash && (body_frame % 2 == 0)) {
-            body.setColor(sf::Color(255, 255, 255));
-            face.setColor(sf::Color(255, 0, 0));
+            i_renderer.add_sprite(EntitySheet::GhostSheet, CELL_SIZE * body_frame, 0, position.x, position.y, sf::Color(255, 255, 255));
+            i_renderer.add_sprite(EntitySheet::GhostSheet, 4 * CELL_SIZE, CELL_SIZE, position.x, position.y, sf::Color(255, 0, 0));
         }
         else {
-            face.setColor(sf::Color(255, 255, 255));
+            i_renderer.add_sprite(EntitySheet::GhostSheet, CELL_SIZE * body_frame, 0, position.x, position.y, sf::Color(36, 36, 255));
+            i_renderer.add_sprite(EntitySheet::GhostSheet, 4 * CELL_SIZE, CELL_SIZE, position.x, position.y, sf::Color(255, 255, 255));
         }
-
-        i_window.draw(body);  // Draw the frightened body
-
     }
     else {  // If the ghost is fleeing (ghost has been eaten)
-        face.setTextureRect(sf::IntRect(CELL_SIZE * direction, 2 * CELL_SIZE, CELL_SIZE, CELL_SIZE));
-
-        i_window.draw(face); // Draw only the face (body is missing)
+        // Draw only the eyes (body is missing)
+        i_renderer.add_sprite(EntitySheet::GhostSheet, CELL_SIZE * direction, 2 * CELL_SIZE, position.x, position.y, sf::Color(255, 255, 255));
     }
 
     // Update the animation timer to create a looping effect for the ghost animation
@@ -109,72 +155,97 @@ void Ghost::draw(bool i_flash, sf::RenderWindow& i_window) {
 }
 
 // Reset the ghost's state to its home position and exit
-void Ghost::reset(const Position& i_home, const Position& i_home_exit) {
+void Ghost::reset(const Position& i_home, const Position& i_home_exit, unsigned i_seed, bool i_player_controlled, bool i_use_door) {
     movement_mode = 0;  // Set default mode
-    use_door = id > 0;  // Only ghosts other than red can use the door
+    player_controlled = i_player_controlled;
+    use_door = i_use_door;  // Only the ghosts that start in the house can use the door
 
     direction = 0;  // Default direction
     frightened_mode = 0;  // Not frightened
     frightened_speed_timer = 0;  // Reset speed timer
+    movement_phase = 0;  // Start at the first tick of the frame
 
     animation_timer = 0;  // Reset animation timer
 
+    random_state = seed_random(i_seed, id);  // Every ghost gets its own random numbers
+
     // Set home, home exit, and initial target
     home = i_home;
     home_exit = i_home_exit;
     target = i_home_exit;
+
+    hash = compute_hash();  // Almost everything changed, so we start the hash again
 }
 
 // Set the ghost's position
 void Ghost::set_position(short i_x, short i_y) {
+    update_zobrist_hash(HASH_GHOST_POSITION, 2 * id, position.x, i_x, hash);
+    update_zobrist_hash(HASH_GHOST_POSITION, 1 + 2 * id, position.y, i_y, hash);
+
     position = { i_x, i_y };
 }
 
 // Toggle between scatter and chase modes
 void Ghost::switch_mode() {
+    update_zobrist_hash(HASH_GHOST_MOVEMENT_MODE, id, movement_mode, 1 - movement_mode, hash);
+
     movement_mode = 1 - movement_mode;  // Toggle between scatter and chase
 }
 
-// Update the ghost's behavior based on game level, Pac-Man's state, and other factors
+// Update the ghost's behavior based on the level settings, Pac-Man's state, and other factors
+// The target outside the house was already picked by update_target
 void Ghost::update(
-    unsigned char i_level,
-    std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map,
-    Ghost& i_ghost_0,
-    Pacman& i_pacman
+    const LevelSettings& i_level_settings,
+    unsigned char i_input,
+    unsigned short i_pacman_energizer_timer,
+    const Map& i_map
 ) {
+    TRACE_ZONE("Ghost::update");
+
+    // How we were before this tick, so at the end we only change the keys of the things that changed
+    const Ghost previous = *this;
+
     bool move = false;  // Whether the ghost can move
     unsigned char available_ways = 0;  // Number of available directions to move
-    unsigned char speed = GHOST_SPEED;  // Ghost speed
+    unsigned char speed = get_step(i_level_settings.ghost_speed, movement_phase);  // How many pixels we move in this tick
 
     std::array<bool, 4> walls{};  // Walls around the ghost
 
     // Handle frightened mode transitions based on Pac-Man's energizer timer
-    if (frightened_mode == 0 && i_pacman.get_energizer_timer() == ENERGIZER_DURATION / pow(2, i_level)) {
-        frightened_speed_timer = GHOST_FRIGHTENED_SPEED;
+    if (frightened_mode == 0 && i_pacman_energizer_timer == i_level_settings.energizer_duration) {
+        frightened_speed_timer = i_level_settings.ghost_frightened_speed;
         frightened_mode = 1;
     }
-    else if (i_pacman.get_energizer_timer() == 0 && frightened_mode == 1) {
+    else if (i_pacman_energizer_timer == 0 && frightened_mode == 1) {
         frightened_mode = 0;  // Frightened mode ends
     }
 
-    // Adjust ghost speed for escaping
+    // Adjust ghost speed for escaping (once we're aligned to the escape steps)
+    unsigned char escape_alignment = std::max(1, i_level_settings.ghost_escape_speed / TICK_MULTIPLIER);
+
     if (frightened_mode == 2 &&
-        (position.x % GHOST_ESCAPE_SPEED == 0) &&
-        (position.y % GHOST_ESCAPE_SPEED == 0)) {
-        speed = GHOST_ESCAPE_SPEED;
+        (position.x % escape_alignment == 0) &&
+        (position.y % escape_alignment == 0)) {
+        speed = get_step(i_level_settings.ghost_escape_speed, movement_phase);
     }
+    else if (frightened_mode == 1) {
+        speed = i_level_settings.ghost_speed;  // The frightened ghost has its own timer
+    }
+
+    movement_phase = (1 + movement_phase) % TICK_MULTIPLIER;
 
-    // Update the ghost's target based on Pac-Man's direction, other ghosts' positions, and game modes
-    update_target(i_pacman.get_direction(), i_ghost_0.get_position(), i_pacman.get_position());
+    // Update the ghost's target if it's in the house or going back there
+    update_house_target();
 
     // Check if the ghost can move in each direction, considering doors and walls
-    walls[0] = map_collision(0, use_door, speed + position.x, position.y, i_map);  // Right
-    walls[1] = map_collision(0, use_door, position.x, position.y - speed, i_map);  // Up
-    walls[2] = map_collision(0, use_door, position.x - speed, position.y, i_map);  // Left
-    walls[3] = map_collision(0, use_door, speed + position.y, i_map);  // Down
+    walls[0] = map_collision(use_door, speed + position.x, position.y, i_map);  // Right
+    walls[1] = map_collision(use_door, position.x, position.y - speed, i_map);  // Up
+    walls[2] = map_collision(use_door, position.x - speed, position.y, i_map);  // Left
+    walls[3] = map_collision(use_door, position.x, speed + position.y, i_map);  // Down
 
-    if (frightened_mode != 1) {  // Non-frightened logic
+    if (frightened_mode != 1 && speed != 0) {  // Non-frightened logic (we only think in the ticks we move)
         unsigned char optimal_direction = 4;  // Best direction for the ghost
+        unsigned char previous_direction = direction;  // Where we were going before thinking about it
 
         move = true;  // Ghost can move
 
@@ -204,14 +275,27 @@ void Ghost::update(
             direction = optimal_direction;  // Follow the best path
         }
 
+        // The player drives the ghost when it's outside the house
+        // If they don't press anything we can use, the ghost keeps going and only turns (like above) when it hits a wall
+        if (player_controlled && !use_door) {
+            unsigned char player_direction = get_player_direction(i_input, walls);
+
+            if (player_direction != 4) {
+                direction = player_direction;
+            }
+            else if (!walls[previous_direction]) {
+                direction = previous_direction;
+            }
+        }
+
     }
-    else {  // Frightened logic
-        unsigned char random_direction = rand() % 4;  // Random direction for frightened ghost
+    else if (frightened_mode == 1) {  // Frightened logic
+        unsigned char random_direction = get_random(random_state) % 4;  // Random direction for frightened ghost
 
         if (frightened_speed_timer == 0) {
             move = true;  // Ghost can move
 
-            frightened_speed_timer = GHOST_FRIGHTENED_SPEED;  // Reset speed timer
+            frightened_speed_timer = i_level_settings.ghost_frightened_speed;  // Reset speed timer
 
             // Check for available directions without turning back
             for (unsigned char a = 0; a < 4; a++) {
@@ -221,10 +305,32 @@ void Ghost::update(
                 }
             }
 
-            if (available_ways > 0) {
+            if (player_controlled && !use_door) {
+                // A frightened player is still a player, just a slower one
+                unsigned char player_direction = get_player_direction(i_input, walls);
+
+                if (player_direction != 4) {
+                    direction = player_direction;
+                }
+                else if (walls[direction]) {
+                    unsigned char back = (2 + direction) % 4;
+
+                    // Turn back if we can't go anywhere else
+                    direction = back;
+
+                    // Otherwise take the first free way
+                    for (unsigned char a = 0; a < 4; a++) {
+                        if (!walls[a] && a != back) {
+                            direction = a;
+                            break;
+                        }
+                    }
+                }
+            }
+            else if (available_ways > 0) {
                 // Choose a random direction that is valid and does not turn back
                 while (walls[random_direction] || random_direction == ((2 + direction) % 4)) {
-                    random_direction = rand() % 4;
+                    random_direction = get_random(random_state) % 4;
                 }
                 direction = random_direction;
             }
@@ -249,32 +355,58 @@ void Ghost::update(
 
         // Handle warp tunnels
         if (position.x < -CELL_SIZE) {
-            position.x = CELL_SIZE * MAP_WIDTH - speed;
+            position.x += CELL_SIZE * (1 + i_map.get_width());
         }
-        else if (position.x >= CELL_SIZE * MAP_WIDTH) {
-            position.x = speed - CELL_SIZE;
+        else if (position.x >= CELL_SIZE * i_map.get_width()) {
+            position.x -= CELL_SIZE * (1 + i_map.get_width()) - speed;
         }
     }
 
-    // Handle collision with Pac-Man
-    if (pacman_collision(i_pacman.get_position())) {
-        if (frightened_mode == 0) {  // If ghost is not frightened, it kills Pac-Man
-            i_pacman.set_dead(1);
-        }
-        else {  // If ghost is frightened, it runs towards its home
-            use_door = true;  // Allow ghost to use the door
-            frightened_mode = 2;  // Set frightened mode to escape
-            target = home;  // Target is the ghost's home
-        }
+    update_hash(previous);
+}
+
+// Check if we touch Pac-Man, after every ghost and Pac-Man moved
+// A ghost that isn't frightened kills him (we return 1, and the ghost manager tells him, so the order of the ghosts doesn't matter)
+// A frightened one gets eaten and runs towards its home
+bool Ghost::resolve_pacman_collision(const Position& i_pacman_position) {
+    if (!pacman_collision(i_pacman_position)) {
+        return 0;
+    }
+
+    if (frightened_mode == 0) {
+        return 1;
     }
+
+    const Ghost previous = *this;
+
+    use_door = true;  // Allow ghost to use the door
+    frightened_mode = 2;  // Set frightened mode to escape
+    target = home;  // Target is the ghost's home
+
+    update_hash(previous);
+
+    return 0;
 }
 
-// Update the ghost's target based on Pac-Man's direction and other game parameters
-void Ghost::update_target(
-    unsigned char i_pacman_direction,
-    const Position& i_ghost_0_position,
-    const Position& i_pacman_position
-) {
+// Change the keys of the things that changed since i_previous in our part of the hash
+void Ghost::update_hash(const Ghost& i_previous) {
+    Position previous_target = get_hashed_target(i_previous.use_door, i_previous.target);
+    Position hashed_target = get_hashed_target(use_door, target);
+
+    update_zobrist_hash(HASH_GHOST_DIRECTION, id, i_previous.direction, direction, hash);
+    update_zobrist_hash(HASH_GHOST_FRIGHTENED_MODE, id, i_previous.frightened_mode, frightened_mode, hash);
+    update_zobrist_hash(HASH_GHOST_FRIGHTENED_SPEED_TIMER, id, i_previous.frightened_speed_timer, frightened_speed_timer, hash);
+    update_zobrist_hash(HASH_GHOST_MOVEMENT_PHASE, id, i_previous.movement_phase, movement_phase, hash);
+    update_zobrist_hash(HASH_GHOST_POSITION, 2 * id, i_previous.position.x, position.x, hash);
+    update_zobrist_hash(HASH_GHOST_POSITION, 1 + 2 * id, i_previous.position.y, position.y, hash);
+    update_zobrist_hash(HASH_GHOST_RANDOM_STATE, id, i_previous.random_state, random_state, hash);
+    update_zobrist_hash(HASH_GHOST_TARGET, 2 * id, previous_target.x, hashed_target.x, hash);
+    update_zobrist_hash(HASH_GHOST_TARGET, 1 + 2 * id, previous_target.y, hashed_target.y, hash);
+    update_zobrist_hash(HASH_GHOST_USE_DOOR, id, i_previous.use_door, use_door, hash);
+}
+
+// Update the ghost's target when it's leaving the house or going back there
+void Ghost::update_house_target() {
     if (use_door) {  // If the ghost is in escape mode (using the door)
         if (position == target) {
             if (target == home_exit) {  // If ghost has reached the home exit
@@ -286,68 +418,14 @@ void Ghost::update_target(
             }
         }
     }
-    else {
-        if (movement_mode == 0) {  // Scatter mode
-            // Assign targets to ghosts based on their ID
-            switch (id) {
-            case 0:  // Red ghost target: top-right corner
-                target = { CELL_SIZE * (MAP_WIDTH - 1), 0 };
-                break;
-            case 1:  // Pink ghost target: top-left corner
-                target = { 0, 0 };
-                break;
-            case 2:  // Cyan ghost target: bottom-right corner
-                target = { CELL_SIZE * (MAP_WIDTH - 1), CELL_SIZE * (MAP_HEIGHT - 1) };
-                break;
-            case 3:  // Orange ghost target: bottom-left corner
-                target = { 0, CELL_SIZE * (MAP_HEIGHT - 1) };
-                break;
-            }
-        }
-        else {  // Chase mode
-            switch (id) {
-            case 0:  // Red ghost chases Pac-Man directly
-                target = i_pacman_position;
-                break;
-
-            case 1:  // Pink ghost targets four cells ahead of Pac-Man
-                target = i_pacman_position;
-                switch (i_pacman_direction) {
-                case 0: target.x += CELL_SIZE * GHOST_1_CHASE; break;  // Right
-                case 1: target.y -= CELL_SIZE * GHOST_1_CHASE; break;  // Up
-                case 2: target.x -= CELL_SIZE * GHOST_1_CHASE; break;  // Left
-                case 3: target.y += CELL_SIZE * GHOST_1_CHASE; break;  // Down
-                }
-                break;
-
-            case 2:  // Cyan ghost targets two cells ahead and moves away from red ghost
-                target = i_pacman_position;
-                switch (i_pacman_direction) {
-                case 0: target.x += CELL_SIZE * GHOST_2_CHASE; break;  // Right
-                case 1: target.y -= CELL_SIZE * GHOST_2_CHASE; break;  // Up
-                case 2: target.x -= CELL_SIZE * GHOST_2_CHASE; break;  // Left
-                case 3: target.y += CELL_SIZE * GHOST_2_CHASE; break;  // Down
-                }
-                // Double the distance from red ghost
-                target.x += target.x - i_ghost_0_position.x;
-                target.y += target.y - i_ghost_0_position.y;
-                break;
-
-            case 3:  // Orange ghost chases Pac-Man if far away, but switches to scatter when close
-                float distance = static_cast<float>(sqrt(pow(position.x - i_pacman_position.x, 2) + pow(position.y - i_pacman_position.y, 2)));
-                if (distance > CELL_SIZE * GHOST_3_CHASE) {
-                    target = i_pacman_position;
-                }
-                else {
-                    target = { 0, CELL_SIZE * (MAP_HEIGHT - 1) };
-                }
-                break;
-            }
-        }
-    }
 }
 
 // Get the current position of the ghost
 Position Ghost::get_position() {
     return position;
 }
+
+// Get where the ghost is going
+Position Ghost::get_target() {
+    return target;
+}
@@ -1,37 +1,125 @@
+#include <algorithm> // For std::max
 #include <array>  // For std::array
-#include <cmath>  // For mathematical operations like pow
+#include <cstdlib> // For std::abs
+#include <tuple>  // For the list of ghost personalities
+#include <vector> // For std::vector
 #include <SFML/Graphics.hpp> // For SFML graphics components
 
 #include "Headers/Global.hpp"     // Header for global constants and definitions
+#include "Headers/Map.hpp"        // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
 #include "Headers/Pacman.hpp"     // Header for Pac-Man class definition
 #include "Headers/Ghost.hpp"      // Header for Ghost class definition
+#include "Headers/GhostPersonalities.hpp" // Header for the ghost personalities
+#include "Headers/Zobrist.hpp"      // Header for the Zobrist hash
 #include "Headers/GhostManager.hpp" // Header for GhostManager class definition
 
+// Far from Pacman, a ghost only moves in one of this many ticks (if the game asks for that)
+constexpr unsigned char FAR_GHOST_TICK_INTERVAL = 4;
+
+static_assert(std::tuple_size<GhostPersonalities>::value == 4, "Every ghost needs a personality");
+
+// Compute the hash of the waves and the tick from scratch
+static unsigned long long get_wave_hash(unsigned char i_current_wave, unsigned short i_wave_timer, unsigned char i_tick) {
+    return get_zobrist_key(HASH_WAVE, 0, i_current_wave) ^ get_zobrist_key(HASH_WAVE_TIMER, 0, i_wave_timer) ^ get_zobrist_key(HASH_GHOST_TICK, 0, i_tick);
+}
+
+// Check if a ghost moves in this tick
+// On a big map, nobody sees the ghosts far from Pacman, so they take turns moving (and don't cost much)
+// But every ghost sees Pacman eat an energizer, and the player's ghost always moves
+static bool get_ghost_awake(
+    unsigned char i_index,
+    unsigned char i_tick,
+    unsigned short i_simulation_radius,
+    const LevelSettings& i_level_settings,
+    Ghost& i_ghost,
+    Pacman& i_pacman
+) {
+    if (i_simulation_radius == 0 || i_ghost.get_player_controlled() || i_pacman.get_energizer_timer() == i_level_settings.energizer_duration) {
+        return 1;
+    }
+
+    Position ghost_position = i_ghost.get_position();
+    Position pacman_position = i_pacman.get_position();
+
+    // A square around Pacman, so the ghosts that can touch him are always inside
+    int distance = std::max(std::abs(ghost_position.x - pacman_position.x), std::abs(ghost_position.y - pacman_position.y));
+
+    return distance <= CELL_SIZE * i_simulation_radius || i_tick == i_index % FAR_GHOST_TICK_INTERVAL;
+}
+
+// Update one ghost, with a personality that's picked when we compile (so its functions are inlined)
+// Everything it reads is from before the ghosts moved, and it only writes the next state of its ghost
+template <typename Personality>
+static void update_ghost(
+    bool i_awake,
+    Ghost& i_next_ghost,
+    unsigned char i_pacman_direction,
+    unsigned short i_pacman_energizer_timer,
+    const Position& i_ghost_0_position,
+    const Position& i_pacman_position,
+    const LevelSettings& i_level_settings,
+    unsigned char i_input,
+    const Map& i_map
+) {
+    if (!i_awake) {
+        return;
+    }
+
+    i_next_ghost.update_target<Personality>(i_pacman_direction, i_ghost_0_position, i_pacman_position, i_map, i_level_settings);
+    i_next_ghost.update(i_level_settings, i_input, i_pacman_energizer_timer, i_map);
+}
+
 // Constructor for the GhostManager class
 GhostManager::GhostManager() :
     current_wave(0),  // Initialize the current wave to 0
+    tick(0),
     wave_timer(LONG_SCATTER_DURATION),  // Initialize the wave timer for the first scatter mode
+    hash(get_wave_hash(0, LONG_SCATTER_DURATION, 0)),
     ghosts({ Ghost(0), Ghost(1), Ghost(2), Ghost(3) })  // Create four ghosts with unique IDs
 {
 }
 
-// Draws all the ghosts managed by this GhostManager on the provided SFML render window
-void GhostManager::draw(bool i_flash, sf::RenderWindow& i_window) {
-    // Loop through all the ghosts and draw each one
+// Compute the hash of the waves and the ghosts from scratch
+unsigned long long GhostManager::compute_hash() {
+    unsigned long long output = get_wave_hash(current_wave, wave_timer, tick);
+
     for (Ghost& ghost : ghosts) {
-        ghost.draw(i_flash, i_window);  // Draw the ghost with possible flash effect
+        output ^= ghost.compute_hash();
     }
+
+    return output;
+}
+
+// Get the hash of the waves and the ghosts (the ghosts update their own parts)
+unsigned long long GhostManager::get_hash() {
+    return hash ^ ghosts[0].get_hash() ^ ghosts[1].get_hash() ^ ghosts[2].get_hash() ^ ghosts[3].get_hash();
+}
+
+// Adds all the ghosts managed by this GhostManager to the sprites of this frame
+void GhostManager::draw(bool i_flash, EntityRenderer& i_renderer) {
+    // Draw every ghost with the color of its personality (and a possible flash effect)
+    ghosts[0].draw(i_flash, GhostPersonality<0>::get_color(), i_renderer);
+    ghosts[1].draw(i_flash, GhostPersonality<1>::get_color(), i_renderer);
+    ghosts[2].draw(i_flash, GhostPersonality<2>::get_color(), i_renderer);
+    ghosts[3].draw(i_flash, GhostPersonality<3>::get_color(), i_renderer);
 }
 
 // Reset the GhostManager for a specific level and set the initial positions for ghosts
 void GhostManager::reset(
-    unsigned char i_level,
+    const LevelSettings& i_level_settings,
+    unsigned i_seed,
+    bool i_versus,
     const std::array<Position, 4>& i_ghost_positions
 ) {
     current_wave = 0;  // Reset the current wave
+    tick = 0;
 
     // Adjust the wave timer based on the level to increase difficulty
-    wave_timer = static_cast<unsigned short>(LONG_SCATTER_DURATION / pow(2, i_level));
+    wave_timer = i_level_settings.long_scatter_duration;
+
+    hash = get_wave_hash(current_wave, wave_timer, tick);
 
     // Set the initial positions for each ghost based on the provided array
     for (unsigned char a = 0; a < 4; a++) {
@@ -39,17 +127,28 @@ void GhostManager::reset(
     }
 
     // Reset each ghost, using the blue ghost's position for the house and the red ghost's position for the exit
-    for (Ghost& ghost : ghosts) {
-        ghost.reset(ghosts[2].get_position(), ghosts[0].get_position());
-    }
+    // In versus mode, the second player drives the red ghost
+    // The personality tells us if the ghost starts in the house (and needs the door to get out)
+    ghosts[0].reset(ghosts[2].get_position(), ghosts[0].get_position(), i_seed, i_versus, GhostPersonality<0>::USE_DOOR);
+    ghosts[1].reset(ghosts[2].get_position(), ghosts[0].get_position(), i_seed, 0, GhostPersonality<1>::USE_DOOR);
+    ghosts[2].reset(ghosts[2].get_position(), ghosts[0].get_position(), i_seed, 0, GhostPersonality<2>::USE_DOOR);
+    ghosts[3].reset(ghosts[2].get_position(), ghosts[0].get_position(), i_seed, 0, GhostPersonality<3>::USE_DOOR);
 }
 
-// Update the GhostManager and all managed ghosts based on the game level, map, and Pac-Man's state
+// Update the GhostManager and all managed ghosts based on the level settings, map, and Pac-Man's state
 void GhostManager::update(
-    unsigned char i_level,
-    std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map,
+    const LevelSettings& i_level_settings,
+    unsigned short i_simulation_radius,
+    unsigned char i_input,
+    const Map& i_map,
     Pacman& i_pacman
 ) {
+    // The waves and the tick before this tick, so we can update the hash
+    unsigned char previous_tick = tick;
+    unsigned char previous_wave = current_wave;
+
+    unsigned short previous_wave_timer = wave_timer;
+
     // If Pac-Man's energizer timer is zero (not energized)
     if (i_pacman.get_energizer_timer() == 0) {
         // If the wave timer has reached zero, it's time to switch modes
@@ -65,13 +164,13 @@ void GhostManager::update(
 
             // Determine the new wave timer duration based on the current wave
             if (current_wave % 2 == 1) {
-                wave_timer = CHASE_DURATION;  // Set to chase mode duration
+                wave_timer = i_level_settings.chase_duration;  // Set to chase mode duration
             }
             else if (current_wave == 2) {
-                wave_timer = static_cast<unsigned short>(LONG_SCATTER_DURATION / pow(2, i_level));  // Adjusted scatter mode duration
+                wave_timer = i_level_settings.long_scatter_duration;  // Adjusted scatter mode duration
             }
             else {
-                wave_timer = static_cast<unsigned short>(SHORT_SCATTER_DURATION / pow(2, i_level));  // Shorter scatter mode
+                wave_timer = i_level_settings.short_scatter_duration;  // Shorter scatter mode
             }
         }
         else {
@@ -79,8 +178,54 @@ void GhostManager::update(
         }
     }
 
-    // Update each ghost with the current level, map, and Pac-Man's information
+    // Every ghost reads the game as it was before the ghosts moved (Pacman, the map and where the red ghost was), and writes its next state into a copy
+    // So no ghost sees another one move, and the order we update them in doesn't change the game (they could be updated on different cores)
+    // Only the player's ghost cares about the input
+    unsigned char pacman_direction = i_pacman.get_direction();
+    unsigned short pacman_energizer_timer = i_pacman.get_energizer_timer();
+
+    Position ghost_0_position = ghosts[0].get_position();
+    Position pacman_position = i_pacman.get_position();
+
+    std::array<Ghost, 4> next_ghosts = ghosts;
+
+    update_ghost<GhostPersonality<0>>(get_ghost_awake(0, tick, i_simulation_radius, i_level_settings, ghosts[0], i_pacman), next_ghosts[0], pacman_direction, pacman_energizer_timer, ghost_0_position, pacman_position, i_level_settings, i_input, i_map);
+    update_ghost<GhostPersonality<1>>(get_ghost_awake(1, tick, i_simulation_radius, i_level_settings, ghosts[1], i_pacman), next_ghosts[1], pacman_direction, pacman_energizer_timer, ghost_0_position, pacman_position, i_level_settings, i_input, i_map);
+    update_ghost<GhostPersonality<2>>(get_ghost_awake(2, tick, i_simulation_radius, i_level_settings, ghosts[2], i_pacman), next_ghosts[2], pacman_direction, pacman_energizer_timer, ghost_0_position, pacman_position, i_level_settings, i_input, i_map);
+    update_ghost<GhostPersonality<3>>(get_ghost_awake(3, tick, i_simulation_radius, i_level_settings, ghosts[3], i_pacman), next_ghosts[3], pacman_direction, pacman_energizer_timer, ghost_0_position, pacman_position, i_level_settings, i_input, i_map);
+
+    ghosts = next_ghosts;
+
+    // Then the collisions, once everybody moved
+    // The eaten ghosts only change themselves, and Pacman dies if any ghost that isn't frightened touches him, so the order doesn't matter here either
+    bool pacman_caught = 0;
+
     for (Ghost& ghost : ghosts) {
-        ghost.update(i_level, i_map, ghosts[0], i_pacman);  // Update ghost behavior
+        pacman_caught |= ghost.resolve_pacman_collision(pacman_position);
+    }
+
+    if (pacman_caught) {
+        i_pacman.set_dead(1);
     }
+
+    tick = (1 + tick) % FAR_GHOST_TICK_INTERVAL;
+
+    update_zobrist_hash(HASH_GHOST_TICK, 0, previous_tick, tick, hash);
+    update_zobrist_hash(HASH_WAVE, 0, previous_wave, current_wave, hash);
+    update_zobrist_hash(HASH_WAVE_TIMER, 0, previous_wave_timer, wave_timer, hash);
+}
+
+// Get which scatter/chase wave we're in
+unsigned char GhostManager::get_current_wave() {
+    return current_wave;
+}
+
+// Get how long the current wave has left
+unsigned short GhostManager::get_wave_timer() {
+    return wave_timer;
+}
+
+// Get all the ghosts
+std::array<Ghost, 4>& GhostManager::get_ghosts() {
+    return ghosts;
 }
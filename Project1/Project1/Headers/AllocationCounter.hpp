@@ -0,0 +1,6 @@
+#pragma once
+
+//Every operator new of the program is counted (AllocationCounter.cpp replaces it).
+//Allocations take a random amount of time, so once the game is running, the ticks and the frames shouldn't make any. This is how we check.
+//(Memory that SFML or the C library get with malloc isn't counted.)
+unsigned long long get_allocation_count();
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+//The messages between the BatchFleet coordinator and its workers. They're sent over TCP, they have fixed sizes, and the numbers are little-endian.
+//The port the coordinator listens on.
+constexpr unsigned short BATCH_PORT = 54200;
+
+//Worker -> coordinator, always the first message: the worker's process id (4 bytes), so the report can tell the workers apart.
+constexpr unsigned char BATCH_MESSAGE_HELLO = 0;
+//Coordinator -> worker: a work unit to play. Its index (4 bytes), the level (1 byte), the policy (1 byte), the first seed (4 bytes), the number of games (4 bytes) and the most ticks a game may last (4 bytes).
+//The games of a unit have the seeds first seed, first seed + 1, and so on, so any worker plays exactly the same games.
+constexpr unsigned char BATCH_MESSAGE_UNIT = 1;
+//Worker -> coordinator, when it played a unit: the index (4 bytes), the games, the wins, the deaths and the games that reached the tick limit (4 * 4 bytes),
+//the ticks and the eaten pellets (8 + 8 bytes), the sum of the final hashes of the games (8 bytes) and how long it took in microseconds (8 bytes).
+constexpr unsigned char BATCH_MESSAGE_RESULT = 2;
+//Coordinator -> worker: every unit is done, so the worker can stop.
+constexpr unsigned char BATCH_MESSAGE_DONE = 3;
+
+//How the workers play Pacman.
+//POLICY_RANDOM - Holds a direction and sometimes picks another one.
+//POLICY_PELLETS - Goes to the closest pellet.
+constexpr unsigned char POLICY_RANDOM = 0;
+constexpr unsigned char POLICY_PELLETS = 1;
+constexpr unsigned char POLICY_COUNT = 2;
+
+constexpr unsigned char BATCH_DONE_MESSAGE_SIZE = 1;
+constexpr unsigned char BATCH_HELLO_MESSAGE_SIZE = 5;
+constexpr unsigned char BATCH_RESULT_MESSAGE_SIZE = 53;
+constexpr unsigned char BATCH_UNIT_MESSAGE_SIZE = 19;
\ No newline at end of file
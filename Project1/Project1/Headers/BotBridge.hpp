@@ -0,0 +1,223 @@
+#pragma once
+
+//The shared memory between BotHost (the game without a window) and a bot in another process (Linux only, it uses shm_open and futexes).
+//Nothing is serialized: the game writes every observation straight into a slot of a ring in the shared memory, the bot reads it there and writes its action into the other ring.
+//Both rings have one writer and one reader, so they only need two counters each. The side that waits spins for a bit, then sleeps on a futex on the counter it waits for.
+//Everything is in the machine's byte order, and every process must be built from the same version of this file (see BOT_BRIDGE_VERSION).
+constexpr unsigned BOT_BRIDGE_MAGIC = 0x554b4150;
+constexpr unsigned BOT_BRIDGE_VERSION = 1;
+//How many messages fit in each ring (a power of 2).
+constexpr unsigned BOT_RING_SLOTS = 256;
+//How many times the waiting side checks the counter before sleeping. (On a single core, spinning only wastes time, so BotHost and the client spin only when there are more.)
+constexpr unsigned BOT_SPIN_COUNT = 4096;
+//The name of the shared memory in /dev/shm, if the host and the bot don't pick another one.
+constexpr char BOT_BRIDGE_NAME[] = "/pakku-bot";
+
+//What the game looks like after a tick. The map isn't in here, it's in the plane after the bridge (see get_bot_map).
+struct BotObservation
+{
+	bool game_won;
+	bool pacman_dead;
+
+	unsigned char level;
+	unsigned char pacman_direction;
+
+	//0 - scatter, 1 - chase.
+	std::array<unsigned char, 4> ghost_movement_modes;
+	std::array<unsigned char, 4> ghost_directions;
+	//See Ghost::frightened_mode.
+	std::array<unsigned char, 4> ghost_frightened_modes;
+
+	unsigned short energizer_timer;
+
+	//The bot must answer with the same frame.
+	unsigned frame;
+	unsigned pellet_count;
+
+	unsigned long long hash;
+
+	//In pixels (a cell is CELL_SIZE pixels).
+	Position pacman_position;
+
+	std::array<Position, 4> ghost_positions;
+};
+
+//What the bot wants Pacman to do.
+struct BotAction
+{
+	//The input bitmask (see INPUT_RESTART in Global.hpp).
+	unsigned char input;
+
+	//The frame of the observation we're answering.
+	unsigned frame;
+};
+
+//One writer, one reader. The counters only grow (and wrap around), and the slot of message i is i % BOT_RING_SLOTS.
+//Each counter has its own cache line, so the two processes don't steal each other's lines.
+template <typename Message>
+struct BotRing
+{
+	//How many messages the writer wrote.
+	alignas(64) std::atomic<unsigned> head;
+	//Is the reader sleeping on head?
+	std::atomic<unsigned> head_waiting;
+
+	//How many messages the reader read.
+	alignas(64) std::atomic<unsigned> tail;
+
+	alignas(64) std::array<Message, BOT_RING_SLOTS> slots;
+};
+
+//The start of the shared memory. The map plane comes right after it: map_width * map_height cells (see Cell in Global.hpp), row by row.
+struct BotBridge
+{
+	//BotHost writes BOT_BRIDGE_MAGIC here when everything else is ready.
+	std::atomic<unsigned> magic;
+
+	unsigned version;
+
+	unsigned short map_height;
+	unsigned short map_width;
+
+	//Either side sets it when it's done.
+	std::atomic<unsigned> closed;
+
+	BotRing<BotObservation> observations;
+	BotRing<BotAction> actions;
+};
+
+//How big the shared memory is for a map.
+inline unsigned long get_bot_bridge_size(unsigned short i_map_width, unsigned short i_map_height)
+{
+	return sizeof(BotBridge) + static_cast<unsigned long>(i_map_width) * i_map_height;
+}
+
+//The map plane. The game updates it in place after every tick, so it shows the map of the newest observation.
+//(A bot that answers every observation in time is never more than one observation behind it.)
+inline Cell* get_bot_map(BotBridge& i_bridge)
+{
+	return reinterpret_cast<Cell*>(&i_bridge + 1);
+}
+
+//The futex is on the counter itself, so a write to it between the check and the sleep can't be missed.
+//(These aren't the private futexes, because the two processes map the memory at different addresses.)
+inline void wait_on_futex(std::atomic<unsigned>& i_counter, unsigned i_value, const timespec* i_timeout)
+{
+	syscall(SYS_futex, reinterpret_cast<unsigned*>(&i_counter), FUTEX_WAIT, i_value, i_timeout, nullptr, 0);
+}
+
+inline void wake_futex(std::atomic<unsigned>& i_counter)
+{
+	syscall(SYS_futex, reinterpret_cast<unsigned*>(&i_counter), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+//The slot to write the next message in, or nullptr if the ring is full. Write it there, then call push_message.
+template <typename Message>
+Message* get_free_slot(BotRing<Message>& i_ring)
+{
+	unsigned head = i_ring.head.load(std::memory_order_relaxed);
+
+	if (head - i_ring.tail.load(std::memory_order_acquire) == BOT_RING_SLOTS)
+	{
+		return nullptr;
+	}
+
+	return &i_ring.slots[head % BOT_RING_SLOTS];
+}
+
+//Publish the message in the slot get_free_slot gave us, and wake the reader if it's sleeping.
+template <typename Message>
+void push_message(BotRing<Message>& i_ring)
+{
+	//Sequentially consistent, so either the reader sees the new head before it sleeps, or we see that it's waiting.
+	i_ring.head.fetch_add(1);
+
+	if (i_ring.head_waiting.load() == 1)
+	{
+		wake_futex(i_ring.head);
+	}
+}
+
+//The oldest message we didn't read, or nullptr if there's none. Call pop_message when we're done with it.
+template <typename Message>
+const Message* get_message(BotRing<Message>& i_ring)
+{
+	unsigned tail = i_ring.tail.load(std::memory_order_relaxed);
+
+	if (tail == i_ring.head.load(std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+
+	return &i_ring.slots[tail % BOT_RING_SLOTS];
+}
+
+//We're done with the message get_message gave us, so the writer can use its slot again.
+template <typename Message>
+void pop_message(BotRing<Message>& i_ring)
+{
+	i_ring.tail.store(1 + i_ring.tail.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+//Wait until there's a message to read: spin i_spin_count times, then sleep until i_deadline (CLOCK_MONOTONIC, nullptr means forever).
+//Returns the message, or nullptr if the deadline passed. (Nobody wakes us when the other side closes the bridge, so check BotBridge::closed between waits.)
+template <typename Message>
+const Message* wait_for_message(BotRing<Message>& i_ring, unsigned i_spin_count, const timespec* i_deadline)
+{
+	for (unsigned a = 0; a < i_spin_count; a++)
+	{
+		const Message* message = get_message(i_ring);
+
+		if (message != nullptr)
+		{
+			return message;
+		}
+	}
+
+	while (1)
+	{
+		unsigned tail = i_ring.tail.load(std::memory_order_relaxed);
+
+		//The timeout of FUTEX_WAIT is relative, so we compute what's left of the deadline every time we sleep.
+		timespec timeout = {};
+
+		i_ring.head_waiting.store(1);
+
+		if (tail != i_ring.head.load())
+		{
+			i_ring.head_waiting.store(0);
+
+			return get_message(i_ring);
+		}
+
+		if (i_deadline != nullptr)
+		{
+			timespec now;
+
+			clock_gettime(CLOCK_MONOTONIC, &now);
+
+			long long nanoseconds = 1000000000ll * (i_deadline->tv_sec - now.tv_sec) + i_deadline->tv_nsec - now.tv_nsec;
+
+			if (nanoseconds <= 0)
+			{
+				i_ring.head_waiting.store(0);
+
+				return nullptr;
+			}
+
+			timeout.tv_sec = static_cast<time_t>(nanoseconds / 1000000000);
+			timeout.tv_nsec = static_cast<long>(nanoseconds % 1000000000);
+		}
+
+		wait_on_futex(i_ring.head, tail, i_deadline == nullptr ? nullptr : &timeout);
+
+		i_ring.head_waiting.store(0);
+
+		const Message* message = get_message(i_ring);
+
+		if (message != nullptr)
+		{
+			return message;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+//A map sketch that was converted while compiling (see compile_sketch).
+//Starting a level on it only copies the cells, and everything else in here is a constant the compiler can fold.
+template <unsigned short Width, unsigned short Height>
+struct CompiledSketch
+{
+	unsigned pellet_count;
+
+	Position pacman_position;
+
+	//Plain arrays, because the operator[] of std::array can't change anything while compiling (before C++17).
+	Position ghost_positions[4];
+
+	//Row by row.
+	Cell cells[Width * Height];
+
+	//Which part of the wall texture every wall cell uses (the same index MapRenderer works out for the other maps), row by row.
+	unsigned char wall_tiles[Width * Height];
+};
+
+//The wall tile of the cell (i_x, i_y): 1 if there's a wall below, 2 on the left, 4 on the right and 8 above. The sides of the map count as walls.
+template <std::size_t Height, std::size_t Length>
+constexpr unsigned char get_sketch_wall_tile(const char (&i_sketch)[Height][Length], std::size_t i_x, std::size_t i_y)
+{
+	bool down = i_y < Height - 1 && i_sketch[1 + i_y][i_x] == '#';
+	bool left = i_x == 0 || i_sketch[i_y][i_x - 1] == '#';
+	bool right = i_x == Length - 2 || i_sketch[i_y][1 + i_x] == '#';
+	bool up = 0 < i_y && i_sketch[i_y - 1][i_x] == '#';
+
+	return static_cast<unsigned char>(down + 2 * (left + 2 * (right + 2 * up)));
+}
+
+//convert_sketch, but while compiling. The result must be a constexpr variable, so a bad sketch is a compile error:
+//a character convert_sketch doesn't know, a short row (the long ones don't even fit in the array), or Pacman or a ghost missing (or there twice).
+//(The compiler shows the message we throw. The checks that need a path through the maze are still done by validate_maze.)
+template <std::size_t Height, std::size_t Length>
+constexpr CompiledSketch<Length - 1, Height> compile_sketch(const char (&i_sketch)[Height][Length])
+{
+	CompiledSketch<Length - 1, Height> output{};
+
+	//Pacman, and then the 4 ghosts
+	unsigned char counts[5] = {};
+
+	for (std::size_t a = 0; a < Height; a++)
+	{
+		//Whatever goes out on one side comes back on the other side
+		if ((i_sketch[a][0] == '#') != (i_sketch[a][Length - 2] == '#'))
+		{
+			throw "A tunnel doesn't come out on the other side.";
+		}
+
+		for (std::size_t b = 0; b < Length - 1; b++)
+		{
+			std::size_t cell = b + (Length - 1) * a;
+
+			output.cells[cell] = Cell::Empty;
+
+			switch (i_sketch[a][b])
+			{
+				case ' ':
+				{
+					break;
+				}
+				case '#':
+				{
+					output.cells[cell] = Cell::Wall;
+					output.wall_tiles[cell] = get_sketch_wall_tile(i_sketch, b, a);
+
+					break;
+				}
+				case '.':
+				{
+					output.cells[cell] = Cell::Pellet;
+					output.pellet_count++;
+
+					break;
+				}
+				case '=':
+				{
+					output.cells[cell] = Cell::Door;
+
+					break;
+				}
+				case 'o':
+				{
+					output.cells[cell] = Cell::Energizer;
+
+					break;
+				}
+				case 'P':
+				{
+					counts[0]++;
+
+					output.pacman_position.x = static_cast<short>(CELL_SIZE * b);
+					output.pacman_position.y = static_cast<short>(CELL_SIZE * a);
+
+					break;
+				}
+				case '0':
+				case '1':
+				case '2':
+				case '3':
+				{
+					counts[1 + i_sketch[a][b] - '0']++;
+
+					output.ghost_positions[i_sketch[a][b] - '0'].x = static_cast<short>(CELL_SIZE * b);
+					output.ghost_positions[i_sketch[a][b] - '0'].y = static_cast<short>(CELL_SIZE * a);
+
+					break;
+				}
+				case '\0':
+				{
+					throw "The rows don't have the same length.";
+				}
+				default:
+				{
+					throw "There's a character convert_sketch doesn't know.";
+				}
+			}
+		}
+	}
+
+	for (unsigned char a = 0; a < 5; a++)
+	{
+		if (counts[a] != 1)
+		{
+			throw "Pacman and every ghost must be in the sketch exactly once.";
+		}
+	}
+
+	return output;
+}
+
+//The default map, converted while compiling. Game::reset uses it instead of converting get_map_sketch every level.
+constexpr CompiledSketch<MAP_WIDTH, MAP_HEIGHT> DEFAULT_MAP = compile_sketch(MAP_SKETCH);
+
+static_assert(0 < DEFAULT_MAP.pellet_count, "The default map needs pellets.");
\ No newline at end of file
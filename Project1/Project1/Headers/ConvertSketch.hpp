@@ -1,3 +1,17 @@
 #pragma once
 
-std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH> convert_sketch(const std::array<std::string, MAP_HEIGHT>& i_map_sketch, std::array<Position, 4>& i_ghost_positions, Pacman& i_pacman);
\ No newline at end of file
+void convert_sketch(const std::vector<std::string>& i_map_sketch, Map& i_map, std::array<Position, 4>& i_ghost_positions, Pacman& i_pacman);
+
+//The same thing for a sketch that was converted while compiling, so it only copies the cells.
+template <unsigned short Width, unsigned short Height>
+void convert_sketch(const CompiledSketch<Width, Height>& i_sketch, Map& i_map, std::array<Position, 4>& i_ghost_positions, Pacman& i_pacman)
+{
+	i_map.load(Width, Height, i_sketch.cells, i_sketch.wall_tiles, i_sketch.pellet_count);
+
+	for (unsigned char a = 0; a < 4; a++)
+	{
+		i_ghost_positions[a] = i_sketch.ghost_positions[a];
+	}
+
+	i_pacman.set_position(i_sketch.pacman_position.x, i_sketch.pacman_position.y);
+}
\ No newline at end of file
@@ -1,3 +0,0 @@
-#pragma once
-
-void draw_map(const std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map, sf::RenderWindow& i_window);
\ No newline at end of file
@@ -1,3 +1,3 @@
 #pragma once
 
-void draw_text(bool i_center, unsigned short i_x, unsigned short i_y, const std::string& i_text, sf::RenderWindow& i_window);
\ No newline at end of file
+void draw_text(bool i_center, unsigned short i_x, unsigned short i_y, const char* i_text, sf::RenderWindow& i_window);
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+//The sprite sheets of Pacman and the ghosts, packed into one atlas from top to bottom.
+enum EntitySheet : unsigned char
+{
+	GhostSheet,
+	PacmanSheet,
+	PacmanDeathSheet
+};
+
+//Draws Pacman and every ghost in one draw call.
+//They add their sprites (a part of a sheet, a position and a color) while the frame is drawn, and the renderer puts them all in one vertex array.
+class EntityRenderer
+{
+	//How many draw calls the last draw made (always 1, however many sprites there are).
+	unsigned short draw_calls;
+
+	//Where every sheet starts in the atlas.
+	std::array<unsigned short, 3> sheet_positions;
+
+	sf::Texture atlas;
+
+	//The quads of this frame. It keeps its memory when it's cleared, so a frame doesn't allocate after the first one.
+	sf::VertexArray vertices;
+
+	void load_atlas();
+public:
+	EntityRenderer();
+
+	unsigned short get_draw_calls();
+
+	//A CELL_SIZE x CELL_SIZE sprite, from (i_texture_x, i_texture_y) in the sheet. The color multiplies the texture (like sf::Sprite::setColor).
+	void add_sprite(EntitySheet i_sheet, unsigned short i_texture_x, unsigned short i_texture_y, short i_x, short i_y, const sf::Color& i_color);
+	//Draws every sprite added since the last draw, in the order they were added, and forgets them.
+	void draw(sf::RenderTarget& i_target);
+};
\ No newline at end of file
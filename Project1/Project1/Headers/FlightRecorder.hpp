@@ -0,0 +1,96 @@
+#pragma once
+
+//The flight recorder keeps the last seconds of the game in a file, one small record per tick, so there's something to look at after a crash or a strange bug.
+//The file is mapped into memory and used as a ring buffer: recording a tick is just writing a record, and the operating system writes the pages to the disk even if the game crashes.
+//Tools/FlightDump.cpp prints the records.
+constexpr unsigned FLIGHT_MAGIC = 0x544c4650;
+constexpr unsigned FLIGHT_VERSION = 1;
+
+//The bits of FlightRecord::events. They say what happened in that tick.
+constexpr unsigned char FLIGHT_EVENT_ENERGIZER = 1;
+constexpr unsigned char FLIGHT_EVENT_GHOST_EATEN = 2;
+constexpr unsigned char FLIGHT_EVENT_LEVEL_START = 4;
+constexpr unsigned char FLIGHT_EVENT_LEVEL_WON = 8;
+constexpr unsigned char FLIGHT_EVENT_PACMAN_DIED = 16;
+constexpr unsigned char FLIGHT_EVENT_SLOW_TICK = 32;
+
+//The bits of FlightRecord::flags.
+constexpr unsigned char FLIGHT_FLAG_GAME_WON = 1;
+constexpr unsigned char FLIGHT_FLAG_PACMAN_DEAD = 2;
+
+//The bits of FlightRecord::ghost_states: the frightened mode in the first 2 bits, then these.
+constexpr unsigned char FLIGHT_GHOST_CHASE = 4;
+constexpr unsigned char FLIGHT_GHOST_USE_DOOR = 8;
+
+//The game after one tick.
+struct FlightRecord
+{
+	unsigned char events;
+	unsigned char flags;
+	//The inputs of the tick.
+	unsigned char ghost_input;
+	unsigned char input;
+	unsigned char level;
+	unsigned char pacman_direction;
+	unsigned char wave;
+
+	std::array<unsigned char, 4> ghost_directions;
+	std::array<unsigned char, 4> ghost_states;
+
+	unsigned short energizer_timer;
+	unsigned short wave_timer;
+	//In microseconds (65535 means that or more). The frame is the last one shown before the tick.
+	unsigned short frame_duration;
+	unsigned short tick_duration;
+
+	unsigned frame;
+
+	Position pacman_position;
+
+	std::array<Position, 4> ghost_positions;
+	std::array<Position, 4> ghost_targets;
+};
+
+//The start of the file. The records come right after it.
+struct FlightHeader
+{
+	unsigned magic;
+	unsigned version;
+	unsigned record_size;
+	//How many records fit in the ring.
+	unsigned capacity;
+
+	//The signal that crashed the game, or 0.
+	int crash_signal;
+
+	//The frame of the last slow tick, or 0.
+	unsigned slow_frame;
+
+	//How many records were ever written (the newest one is at (record_count - 1) % capacity).
+	unsigned long long record_count;
+};
+
+class FlightRecorder
+{
+	//The size of the mapped file.
+	std::size_t size;
+
+	//Where the file is mapped (nullptr if it isn't, then recording does nothing).
+	FlightHeader* header;
+	FlightRecord* records;
+public:
+	FlightRecorder();
+	~FlightRecorder();
+
+	//The mapping belongs to one recorder.
+	FlightRecorder(const FlightRecorder&) = delete;
+	FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+	//Create (or overwrite) the file, with room for i_seconds of ticks. From then on, a crash signal (SIGSEGV, SIGABRT from a failed check, SIGFPE, SIGILL) is written into the header before the game dies.
+	bool open(const std::string& i_file_name, unsigned short i_seconds);
+	//Copy the ring into another file (the ring itself is overwritten after a few seconds).
+	bool save(const std::string& i_file_name);
+
+	//Call this after every tick.
+	void record(unsigned i_frame, unsigned char i_input, unsigned char i_ghost_input, unsigned i_tick_duration, unsigned i_frame_duration, bool i_slow, Game& i_game);
+};
\ No newline at end of file
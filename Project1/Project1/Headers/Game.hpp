@@ -0,0 +1,64 @@
+#pragma once
+
+//Everything that changes while playing is in here, so saving and loading the game is just copying this object.
+//(That's how the versus mode travels back in time.)
+class Game
+{
+	//Did we eat every pellet?
+	bool game_won;
+	//Is the red ghost driven by the second player?
+	bool versus;
+
+	unsigned char level;
+
+	//The ghosts further than this many cells from Pacman move less often (see GhostManager::update). 0 means never.
+	unsigned short ghost_simulation_radius;
+
+	//The settings of the current level (looked up when the level starts).
+	LevelSettings level_settings;
+
+	//The random numbers of every level come from this.
+	unsigned seed;
+
+	//The part of the game's hash with game_won, the level and the map (Pacman and the ghosts have their own parts).
+	unsigned long long hash;
+
+	//Where the ghosts start.
+	std::array<Position, 4> ghost_positions;
+
+	Map map;
+
+	//We don't copy the sketch around, we just remember where it is.
+	const std::vector<std::string>* map_sketch;
+
+	GhostManager ghost_manager;
+
+	Pacman pacman;
+public:
+	//The sketch can have any size (the camera follows Pacman on the big ones), and it must live as long as the game.
+	Game(bool i_versus, unsigned i_seed, const std::vector<std::string>& i_map_sketch);
+
+	bool get_game_won();
+
+	unsigned char get_level();
+
+	//The Zobrist hash of everything the simulation cares about, so two computers (or two replays) can compare their games.
+	//It's updated as things change, so getting it is cheap. compute_hash computes it from scratch, to check it.
+	unsigned long long compute_hash();
+	unsigned long long get_hash();
+
+	//The renderers keep their vertices and textures between frames, so they live outside the game (the game is copied a lot in versus mode).
+	void draw(MapRenderer& i_map_renderer, EntityRenderer& i_entity_renderer, sf::RenderWindow& i_window);
+	void reset();
+	//Start a level with settings that aren't in the table (to try them, like GhostTuner does). The next level uses the table again.
+	void reset(unsigned char i_level, const LevelSettings& i_level_settings);
+	//Every player must use the same radius, because it changes the game.
+	void set_ghost_simulation_radius(unsigned short i_ghost_simulation_radius);
+	void update(unsigned char i_pacman_input, unsigned char i_ghost_input);
+
+	GhostManager& get_ghost_manager();
+
+	Map& get_map();
+
+	Pacman& get_pacman();
+};
\ No newline at end of file
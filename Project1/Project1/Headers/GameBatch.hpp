@@ -0,0 +1,125 @@
+#pragma once
+
+//How many games a batch plays together. The lanes are 32 bits, so every number of the batch fills 2 AVX2 registers (or 1 AVX-512 register).
+constexpr unsigned char BATCH_LANES = 16;
+
+//The same number of every game in the batch, next to each other in memory, so one instruction can work on all of them.
+typedef std::array<int, BATCH_LANES> BatchLanes;
+
+//The ghosts with the same index in GhostManager (so the same personality) of every game in the batch.
+struct BatchGhosts
+{
+	BatchLanes direction;
+	BatchLanes frightened_mode;
+	BatchLanes frightened_speed_timer;
+	BatchLanes movement_phase;
+	BatchLanes target_x;
+	BatchLanes target_y;
+	BatchLanes use_door;
+	BatchLanes x;
+	BatchLanes y;
+
+	std::array<unsigned, BATCH_LANES> random_state;
+};
+
+//Plays BATCH_LANES games of the same level on the same map in lockstep, for the tools that play millions of games. It doesn't draw anything.
+//Every game has its own seed and inputs, and it plays exactly like a Game would (GameBatchBenchmark checks that), but it doesn't keep a hash.
+//The ghosts move in every tick (like a ghost simulation radius of 0), there's no versus mode, and a finished game stays finished until its lane is reset.
+//The games end at very different times, so the tools should start a new game in a lane as soon as it's free (reset_lane), or most of the lanes would just be masked out.
+//A tick is a few small kernels that go over all the lanes without branching on them: a game that has finished, or goes another way, is masked out.
+//The wall checks have an AVX2 kernel (when it's compiled with /arch:AVX2 or -mavx2). The plain one gives the same results.
+class GameBatch
+{
+	//Do we use the AVX2 kernels?
+	bool simd;
+
+	unsigned char level;
+
+	unsigned short map_height;
+	unsigned short map_width;
+
+	//A bit for every game that's still playing.
+	unsigned playing;
+
+	LevelSettings level_settings;
+
+	//The ghost house is the same in every game.
+	Position home;
+	Position home_exit;
+	Position pacman_start;
+
+	std::array<Position, 4> ghost_starts;
+
+	BatchLanes current_wave;
+	BatchLanes energizer_timer;
+	BatchLanes game_won;
+	//The ghosts of a game always switch between scattering and chasing together.
+	BatchLanes movement_mode;
+	BatchLanes pacman_dead;
+	BatchLanes pacman_direction;
+	BatchLanes pacman_movement_phase;
+	BatchLanes pacman_turn;
+	BatchLanes pacman_turn_timer;
+	BatchLanes pacman_x;
+	BatchLanes pacman_y;
+	BatchLanes pellet_count;
+	BatchLanes wave_timer;
+
+	//What the kernels pass to each other: how far the thing we're moving goes in this tick, and if there's a wall in each direction.
+	BatchLanes speeds;
+	std::array<BatchLanes, 4> walls;
+
+	std::array<BatchGhosts, 4> ghosts;
+
+	//Which games still have the pellet or the energizer of a cell (a bit for every lane).
+	std::vector<unsigned> energizer_lanes;
+	std::vector<unsigned> pellet_lanes;
+
+	//What blocks every cell (2 for a wall, 1 for the door, 0 for nothing), with a border of empty cells around the map.
+	//The wall checks clamp the cells into the border, so they don't need to check the bounds.
+	std::vector<int> blockers;
+
+	//The map at the start of the level, for the personalities (they don't see the pellets the games ate).
+	Map map;
+
+	int get_blocker(int i_x, int i_y) const;
+
+	void update_collisions();
+	template <typename Personality>
+	void update_ghost(unsigned char i_index, const BatchLanes& i_ghost_0_x, const BatchLanes& i_ghost_0_y);
+	void update_pacman(const std::array<unsigned char, BATCH_LANES>& i_inputs);
+	void update_walls(const BatchLanes& i_use_door, const BatchLanes& i_x, const BatchLanes& i_y);
+	void update_waves();
+public:
+	GameBatch();
+
+	//Was it compiled with the AVX2 kernels?
+	static bool get_simd_available();
+
+	bool get_game_won(unsigned char i_lane) const;
+	bool get_movement_mode(unsigned char i_lane) const;
+	bool get_pacman_dead(unsigned char i_lane) const;
+
+	unsigned char get_current_wave(unsigned char i_lane) const;
+	unsigned char get_pacman_direction(unsigned char i_lane) const;
+
+	unsigned short get_energizer_timer(unsigned char i_lane) const;
+	unsigned short get_wave_timer(unsigned char i_lane) const;
+
+	//A bit for every game that's still playing.
+	unsigned get_playing() const;
+	unsigned get_pellet_count(unsigned char i_lane) const;
+
+	//Every game starts the level with the ghosts' random numbers from its seed (like Game(0, seed, map_sketch) at that level).
+	void reset(const std::vector<std::string>& i_map_sketch, unsigned char i_level, const LevelSettings& i_level_settings, const std::array<unsigned, BATCH_LANES>& i_seeds);
+	//Start a new game in one lane, on the same map and level as the others.
+	void reset_lane(unsigned char i_lane, unsigned i_seed);
+	//The plain kernels are always there. The AVX2 ones are only used if they're available.
+	void set_simd(bool i_simd);
+	//One tick of every game that's still playing.
+	void update(const std::array<unsigned char, BATCH_LANES>& i_inputs);
+
+	const BatchGhosts& get_ghosts(unsigned char i_index) const;
+
+	Position get_pacman_position(unsigned char i_lane) const;
+};
\ No newline at end of file
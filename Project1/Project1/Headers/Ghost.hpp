@@ -4,6 +4,8 @@ class Ghost
 {
 	//It can be the scatter mode or the chase mode.
 	bool movement_mode;
+	//In versus mode, the second player is driving this ghost.
+	bool player_controlled;
 	//"Can I use the door, pwease?"
 	bool use_door;
 
@@ -15,14 +17,20 @@ class Ghost
 	unsigned char frightened_mode;
 	//To make the ghost move more slowly, we'll move it after a certain number of frames. So we need a timer.
 	unsigned char frightened_speed_timer;
-	//0 - Red
-	//1 - Pink
-	//2 - Blue (It's actually cyan, but the website said it's blue. And I didn't wanna argue.)
-	//3 - Orange
+	//Which tick of the 60 Hz frame we're in (see get_step).
+	unsigned char movement_phase;
+	//Which ghost we are in the ghost manager (0 is the one the second player drives in versus mode).
+	//What we do is decided by our personality (see GhostPersonalities.hpp), not by this.
 	unsigned char id;
 
 	unsigned short animation_timer;
 
+	//Every ghost has its own random numbers, so the frightened ghosts behave the same on every computer.
+	unsigned random_state;
+
+	//Our part of the game's hash (see Zobrist.hpp). The animation isn't in it, because it doesn't change the game.
+	unsigned long long hash;
+
 	//The ghost will go here when escaping.
 	Position home;
 	//You can't stay in your house forever (sadly).
@@ -31,19 +39,57 @@ class Ghost
 	Position position;
 	//Current target.
 	Position target;
+
+	//The house and the way back to it don't care about our personality, so update does them.
+	void update_house_target();
+	//Change the keys of what changed since i_previous in our part of the hash.
+	void update_hash(const Ghost& i_previous);
 public:
 	Ghost(unsigned char i_id);
 
+	bool get_movement_mode();
+	bool get_player_controlled();
+	bool get_use_door();
 	bool pacman_collision(const Position& i_pacman_position);
+	//After everybody moved: if we're frightened and touch Pacman, we're eaten. Returns 1 if we kill him instead (he's told by the ghost manager).
+	bool resolve_pacman_collision(const Position& i_pacman_position);
 
-	float get_target_distance(unsigned char i_direction);
+	unsigned char get_direction();
+	unsigned char get_frightened_mode();
+	unsigned char get_player_direction(unsigned char i_input, const std::array<bool, 4>& i_walls);
 
-	void draw(bool i_flash, sf::RenderWindow& i_window);
-	void reset(const Position& i_home, const Position& i_home_exit);
+	unsigned get_target_distance(unsigned char i_direction);
+
+	//The hash we updated while playing, and the same hash computed from scratch (to check it).
+	unsigned long long compute_hash();
+	unsigned long long get_hash();
+
+	void draw(bool i_flash, const sf::Color& i_color, EntityRenderer& i_renderer);
+	void reset(const Position& i_home, const Position& i_home_exit, unsigned i_seed, bool i_player_controlled, bool i_use_door);
 	void set_position(short i_x, short i_y);
 	void switch_mode();
-	void update(unsigned char i_level, std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map, Ghost& i_ghost_0, Pacman& i_pacman);
-	void update_target(unsigned char i_pacman_direction, const Position& i_ghost_0_position, const Position& i_pacman_position);
+	//Call update_target first, and resolve_pacman_collision after every ghost moved.
+	//We only change ourselves, and we only read the map and what we're given, so the ghosts can be updated in any order (or at the same time).
+	void update(const LevelSettings& i_level_settings, unsigned char i_input, unsigned short i_pacman_energizer_timer, const Map& i_map);
+
+	//Our personality picks the target when we're outside the house.
+	//It's a template, so the personality is picked when we compile and its functions are inlined here.
+	template <typename Personality>
+	void update_target(unsigned char i_pacman_direction, const Position& i_ghost_0_position, const Position& i_pacman_position, const Map& i_map, const LevelSettings& i_level_settings)
+	{
+		if (use_door == 0)
+		{
+			if (movement_mode == 0)
+			{
+				target = Personality::get_scatter_target(i_map);
+			}
+			else
+			{
+				target = Personality::get_chase_target(position, i_pacman_direction, i_ghost_0_position, i_pacman_position, i_map, i_level_settings);
+			}
+		}
+	}
 
 	Position get_position();
+	Position get_target();
 };
\ No newline at end of file
@@ -5,15 +5,32 @@ class GhostManager
 	//The ghosts will switch between the scatter mode and the chase mode before permanently chasing Pacman.
 	//So we need this to keep track of the waves.
 	unsigned char current_wave;
+	//Counts the ticks, so the ghosts far from Pacman know when it's their turn to move.
+	unsigned char tick;
 
 	//Damn, I really used a lot of timers.
 	unsigned short wave_timer;
 
+	//The part of the game's hash with the waves and the tick (the ghosts have their own parts).
+	unsigned long long hash;
+
 	std::array<Ghost, 4> ghosts;
 public:
 	GhostManager();
 
-	void draw(bool i_flash, sf::RenderWindow& i_window);
-	void reset(unsigned char i_level, const std::array<Position, 4>& i_ghost_positions);
-	void update(unsigned char i_level, std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map, Pacman& i_pacman);
+	unsigned char get_current_wave();
+
+	unsigned short get_wave_timer();
+
+	//The hash we updated while playing (with the ghosts), and the same hash computed from scratch (to check it).
+	unsigned long long compute_hash();
+	unsigned long long get_hash();
+
+	void draw(bool i_flash, EntityRenderer& i_renderer);
+	void reset(const LevelSettings& i_level_settings, unsigned i_seed, bool i_versus, const std::array<Position, 4>& i_ghost_positions);
+	//The ghosts further than i_simulation_radius cells from Pacman move less often (0 means they all move in every tick).
+	//All of them move first, from the game as it was before, and then they're checked against Pacman (so the order of the ghosts doesn't matter).
+	void update(const LevelSettings& i_level_settings, unsigned short i_simulation_radius, unsigned char i_input, const Map& i_map, Pacman& i_pacman);
+
+	std::array<Ghost, 4>& get_ghosts();
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+#pragma once
+
+//A ghost personality is a type with these static members (look at RedGhost):
+//USE_DOOR - Does it start in the house? Then it can use the door to get out.
+//get_color - The color of its body.
+//get_scatter_target - The corner it goes to in the scatter mode.
+//get_chase_target - Where it goes in the chase mode. It gets the settings of the level too, for the distances it uses (so they can be tuned without compiling).
+//Both get the map, because the maps can have any size (and a personality might want to look at the cells).
+//The ghost manager picks the personalities when we compile, so their functions are inlined into the ghost's tick (no switch on the id).
+//To make a new ghost, write a type like these and put it in GhostPersonalities. You don't need to touch Ghost.cpp.
+
+//Narrows a target to a position, clamped to the pixels of the map.
+//(The chase distances come from the level files and the maps can be big, so the math would wrap around in a short.)
+inline Position get_map_position(int i_x, int i_y, const Map& i_map)
+{
+	return {static_cast<short>(std::max(0, std::min(CELL_SIZE * (i_map.get_width() - 1), i_x))), static_cast<short>(std::max(0, std::min(CELL_SIZE * (i_map.get_height() - 1), i_y)))};
+}
+
+//Where Pacman will be after some cells, if he keeps going.
+inline Position get_position_ahead(const Position& i_pacman_position, unsigned char i_pacman_direction, unsigned char i_cells, const Map& i_map)
+{
+	int x = i_pacman_position.x;
+	int y = i_pacman_position.y;
+
+	switch (i_pacman_direction)
+	{
+		case 0: x += CELL_SIZE * i_cells; break; //Right
+		case 1: y -= CELL_SIZE * i_cells; break; //Up
+		case 2: x -= CELL_SIZE * i_cells; break; //Left
+		case 3: y += CELL_SIZE * i_cells; break; //Down
+	}
+
+	return get_map_position(x, y, i_map);
+}
+
+//Chases Pacman directly.
+struct RedGhost
+{
+	//It starts outside the house.
+	static constexpr bool USE_DOOR = 0;
+
+	static sf::Color get_color()
+	{
+		return sf::Color(255, 0, 0);
+	}
+
+	static Position get_scatter_target(const Map& i_map)
+	{
+		return {static_cast<short>(CELL_SIZE * (i_map.get_width() - 1)), 0};
+	}
+
+	static Position get_chase_target(const Position&, unsigned char, const Position&, const Position& i_pacman_position, const Map&, const LevelSettings&)
+	{
+		return i_pacman_position;
+	}
+};
+
+//Goes where Pacman will be.
+struct PinkGhost
+{
+	static constexpr bool USE_DOOR = 1;
+
+	static sf::Color get_color()
+	{
+		return sf::Color(255, 182, 255);
+	}
+
+	static Position get_scatter_target(const Map&)
+	{
+		return {0, 0};
+	}
+
+	static Position get_chase_target(const Position&, unsigned char i_pacman_direction, const Position&, const Position& i_pacman_position, const Map& i_map, const LevelSettings& i_level_settings)
+	{
+		return get_position_ahead(i_pacman_position, i_pacman_direction, i_level_settings.ghost_1_chase, i_map);
+	}
+};
+
+//Goes to the other side of Pacman from the red ghost, so they trap him together.
+//(It's actually cyan, but the website said it's blue. And I didn't wanna argue.)
+struct BlueGhost
+{
+	static constexpr bool USE_DOOR = 1;
+
+	static sf::Color get_color()
+	{
+		return sf::Color(0, 255, 255);
+	}
+
+	static Position get_scatter_target(const Map& i_map)
+	{
+		return {static_cast<short>(CELL_SIZE * (i_map.get_width() - 1)), static_cast<short>(CELL_SIZE * (i_map.get_height() - 1))};
+	}
+
+	static Position get_chase_target(const Position&, unsigned char i_pacman_direction, const Position& i_ghost_0_position, const Position& i_pacman_position, const Map& i_map, const LevelSettings& i_level_settings)
+	{
+		Position ahead = get_position_ahead(i_pacman_position, i_pacman_direction, i_level_settings.ghost_2_chase, i_map);
+
+		//Double the distance from the red ghost.
+		return get_map_position(2 * ahead.x - i_ghost_0_position.x, 2 * ahead.y - i_ghost_0_position.y, i_map);
+	}
+};
+
+//Chases Pacman when he's far away, and runs to its corner when he's close.
+struct OrangeGhost
+{
+	static constexpr bool USE_DOOR = 1;
+
+	static sf::Color get_color()
+	{
+		return sf::Color(255, 182, 85);
+	}
+
+	static Position get_scatter_target(const Map& i_map)
+	{
+		return {0, static_cast<short>(CELL_SIZE * (i_map.get_height() - 1))};
+	}
+
+	static Position get_chase_target(const Position& i_position, unsigned char, const Position&, const Position& i_pacman_position, const Map& i_map, const LevelSettings& i_level_settings)
+	{
+		//Squared distances, so we don't need sqrt.
+		int distance = (i_position.x - i_pacman_position.x) * (i_position.x - i_pacman_position.x) + (i_position.y - i_pacman_position.y) * (i_position.y - i_pacman_position.y);
+
+		if (distance > CELL_SIZE * i_level_settings.ghost_3_chase * CELL_SIZE * i_level_settings.ghost_3_chase)
+		{
+			return i_pacman_position;
+		}
+
+		return get_scatter_target(i_map);
+	}
+};
+
+//The personalities of the 4 ghosts, in the order of the map sketch (the first one is the player's ghost in versus mode).
+typedef std::tuple<RedGhost, PinkGhost, BlueGhost, OrangeGhost> GhostPersonalities;
+
+template <unsigned char Index>
+using GhostPersonality = typename std::tuple_element<Index, GhostPersonalities>::type;
\ No newline at end of file
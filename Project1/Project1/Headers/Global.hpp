@@ -1,5 +1,11 @@
 #pragma once
 
+//How many simulation ticks there are in one 60 Hz frame: 1 (60 Hz), 2 (120 Hz) or 4 (240 Hz).
+//The speeds below stay in pixels per 60 Hz frame and the durations are scaled with this, so the game plays the same, just in smaller steps (and reads the input more often).
+constexpr unsigned char TICK_MULTIPLIER = 1;
+
+static_assert(4 % TICK_MULTIPLIER == 0, "The speeds must be split into whole pixels per tick.");
+
 //I won't explain this.
 constexpr unsigned char CELL_SIZE = 16;
 //This too.
@@ -16,32 +22,58 @@ constexpr unsigned char GHOST_3_CHASE = 4;
 //How many frames are in the ghost body animation
 constexpr unsigned char GHOST_ANIMATION_FRAMES = 6;
 //What do you think?
-constexpr unsigned char GHOST_ANIMATION_SPEED = 4;
+constexpr unsigned char GHOST_ANIMATION_SPEED = 4 * TICK_MULTIPLIER;
 //The speed of the ghost after the Pacman touches it while being energized.
 constexpr unsigned char GHOST_ESCAPE_SPEED = 4;
 //Since the normal speed of the ghost is 1, and I didn't like the idea of using floating numbers, I decided to move the ghost after this number of frames.
-//So the higher the value, the slower the ghost.
-constexpr unsigned char GHOST_FRIGHTENED_SPEED = 3;
+//So the higher the value, the slower the ghost. (The frightened ghost moves once every 4 frames.)
+constexpr unsigned char GHOST_FRIGHTENED_SPEED = 4 * TICK_MULTIPLIER - 1;
 //I won't explain the rest. Bite me!
 constexpr unsigned char GHOST_SPEED = 1;
+//Inputs are bitmasks. The first 4 bits are the directions (right, up, left, down), so the direction "a" is (1 << a).
+//This one restarts the game after winning or losing.
+constexpr unsigned char INPUT_RESTART = 16;
+//This one says a direction was just pressed, and the 2 bits before it say which one. Pacman remembers it until he can turn there.
+constexpr unsigned char INPUT_TURN = 128;
+//The size of the default map. The maps from the maze files can have any size.
 constexpr unsigned char MAP_HEIGHT = 21;
 constexpr unsigned char MAP_WIDTH = 21;
 constexpr unsigned char PACMAN_ANIMATION_FRAMES = 6;
-constexpr unsigned char PACMAN_ANIMATION_SPEED = 4;
+constexpr unsigned char PACMAN_ANIMATION_SPEED = 4 * TICK_MULTIPLIER;
 constexpr unsigned char PACMAN_DEATH_FRAMES = 12;
 constexpr unsigned char PACMAN_SPEED = 2;
+//In versus mode, this is how many frames we're allowed to guess the other player's input before waiting for them.
+constexpr unsigned char ROLLBACK_FRAMES = 32;
 constexpr unsigned char SCREEN_RESIZE = 2;
+//How long Pacman remembers a turn he couldn't take yet.
+constexpr unsigned char TURN_BUFFER_DURATION = 16 * TICK_MULTIPLIER;
+//How many cells the camera shows. Bigger maps scroll with Pacman.
+constexpr unsigned char VIEW_HEIGHT = 21;
+constexpr unsigned char VIEW_WIDTH = 21;
 
 //This is in frames. So don't be surprised if the numbers are too big.
-constexpr unsigned short CHASE_DURATION = 1024;
-constexpr unsigned short ENERGIZER_DURATION = 512;
-constexpr unsigned short FRAME_DURATION = 16667;
-constexpr unsigned short GHOST_FLASH_START = 64;
-constexpr unsigned short LONG_SCATTER_DURATION = 512;
-constexpr unsigned short SHORT_SCATTER_DURATION = 256;
+constexpr unsigned short CHASE_DURATION = 1024 * TICK_MULTIPLIER;
+constexpr unsigned short ENERGIZER_DURATION = 512 * TICK_MULTIPLIER;
+//In microseconds. This is one tick, not one 60 Hz frame.
+constexpr unsigned short FRAME_DURATION = 16667 / TICK_MULTIPLIER;
+constexpr unsigned short GHOST_FLASH_START = 64 * TICK_MULTIPLIER;
+constexpr unsigned short LONG_SCATTER_DURATION = 512 * TICK_MULTIPLIER;
+//The most cells a maze can have on either side. The positions are shorts in pixels, and the tunnels go one cell past the side.
+constexpr unsigned short MAX_MAZE_SIZE = 32767 / CELL_SIZE - 1;
+//The default port for the versus mode.
+constexpr unsigned short NETPLAY_PORT = 54000;
+constexpr unsigned short SHORT_SCATTER_DURATION = 256 * TICK_MULTIPLIER;
+
+//The cell a pixel coordinate is in, rounded down (the tunnels have negative coordinates, so a plain / would round them the wrong way).
+//This is floor(i_coordinate / CELL_SIZE) without the floats, which made map_collision the slowest part of a tick.
+constexpr short get_floor_cell(int i_coordinate)
+{
+	return static_cast<short>((i_coordinate - (i_coordinate < 0 ? CELL_SIZE - 1 : 0)) / CELL_SIZE);
+}
 
 //I used enums! I rarely use them, so enjoy this historical moment.
-enum Cell
+//(One byte each, because big maps have a lot of them.)
+enum Cell : unsigned char
 {
 	Door,
 	Empty,
@@ -60,4 +92,11 @@ struct Position
 	{
 		return this->x == i_position.x && this->y == i_position.y;
 	}
-};
\ No newline at end of file
+};
+
+//How many pixels something moving at i_speed pixels per 60 Hz frame moves in the tick number i_phase of that frame.
+//With 1 tick per frame, that's just i_speed.
+constexpr unsigned char get_step(unsigned char i_speed, unsigned char i_phase)
+{
+	return static_cast<unsigned char>(i_speed * (1 + i_phase) / TICK_MULTIPLIER - i_speed * i_phase / TICK_MULTIPLIER);
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+//How many key presses and releases we can remember between two ticks. (The queue doesn't grow, so reading the keyboard never allocates memory.)
+constexpr unsigned char INPUT_QUEUE_SIZE = 64;
+
+//A key press or release, and when it happened.
+struct InputEvent
+{
+	bool pressed;
+
+	//Which input bit (a direction or INPUT_RESTART).
+	unsigned char input;
+
+	std::chrono::time_point<std::chrono::steady_clock> time;
+};
+
+//We read the window events as soon as they arrive, and every tick turns them into one input.
+//That way a tap between two ticks isn't lost, and the newest direction becomes a turn Pacman remembers.
+class InputQueue
+{
+	//Did the last tick get a new press?
+	bool pressed;
+
+	unsigned char event_count;
+	//The keys being held right now.
+	unsigned char held;
+
+	//When the first press of the last tick happened.
+	std::chrono::time_point<std::chrono::steady_clock> press_time;
+
+	std::array<InputEvent, INPUT_QUEUE_SIZE> events;
+
+	void push(const InputEvent& i_event);
+public:
+	InputQueue();
+
+	bool get_pressed();
+
+	unsigned char update();
+
+	void poll(sf::RenderWindow& i_window);
+
+	std::chrono::time_point<std::chrono::steady_clock> get_press_time();
+};
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+//Measures the time from a key press to the frame that shows it.
+//The square in the corner flips between black and white with every press, so a camera or a light sensor can measure the rest of the way (the monitor).
+class LatencyTest
+{
+	bool enabled;
+	//Is there a press we haven't shown yet?
+	bool waiting;
+	bool white;
+
+	//Counts the frames we showed, for the moving bar (so a camera can count them).
+	unsigned char frame;
+
+	//In microseconds.
+	long long max_latency;
+	long long total_latency;
+
+	unsigned samples;
+
+	std::chrono::time_point<std::chrono::steady_clock> press_time;
+
+	//We make the shapes once, because making them allocates memory.
+	sf::RectangleShape bar;
+	sf::RectangleShape square;
+public:
+	LatencyTest(bool i_enabled);
+
+	bool get_enabled();
+
+	void displayed();
+	void draw(sf::RenderWindow& i_window);
+	void press(const std::chrono::time_point<std::chrono::steady_clock>& i_time);
+};
\ No newline at end of file
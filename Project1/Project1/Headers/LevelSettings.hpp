@@ -0,0 +1,27 @@
+#pragma once
+
+//Everything that changes from one level to the next. The game looks it up once when a level starts, so the ticks only compare integers.
+//The durations are in ticks, and the speeds and the chase distances work like the constants in Global.hpp.
+struct LevelSettings
+{
+	//In cells (see GhostPersonalities.hpp).
+	unsigned char ghost_1_chase;
+	unsigned char ghost_2_chase;
+	unsigned char ghost_3_chase;
+	unsigned char ghost_escape_speed;
+	unsigned char ghost_frightened_speed;
+	unsigned char ghost_speed;
+	unsigned char pacman_speed;
+
+	unsigned short chase_duration;
+	unsigned short energizer_duration;
+	unsigned short ghost_flash_start;
+	unsigned short long_scatter_duration;
+	unsigned short short_scatter_duration;
+};
+
+//The levels after the last one in the table use the last one.
+const LevelSettings& get_level_settings(unsigned char i_level);
+
+//Replace the table with the one in a file. Every player (and the server) must use the same file, or the games won't be the same.
+bool load_level_settings(const std::string& i_file_name);
\ No newline at end of file
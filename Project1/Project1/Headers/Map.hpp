@@ -0,0 +1,51 @@
+#pragma once
+
+//The map is cut into square chunks of cells. The cells of a chunk are next to each other in memory, and the renderer keeps the vertices of every chunk (see MapRenderer.hpp).
+constexpr unsigned char CHUNK_SIZE = 16;
+
+//The cells of the map. Its size comes from the sketch, so it can be much bigger than the screen.
+class Map
+{
+	//In cells.
+	unsigned short height;
+	unsigned short width;
+	//How many chunks there are in a row and in a column.
+	unsigned short chunk_columns;
+	unsigned short chunk_rows;
+
+	//How many Cell::Pellet cells are left. (Pacman wins when there are none.)
+	unsigned pellet_count;
+
+	//Row by row, and the cells inside every chunk are row by row too.
+	std::vector<std::array<Cell, CHUNK_SIZE * CHUNK_SIZE>> chunks;
+
+	//Every change to a chunk gives it a new version (from a counter every map shares), so the renderer knows which chunks changed.
+	//Even after the versus mode copies an older map back, the same version always means the same cells.
+	std::vector<unsigned long long> chunk_versions;
+
+	//The wall tiles of a map converted while compiling (see CompiledSketch.hpp), row by row, or nullptr if the renderer works them out.
+	//Playing never changes the walls, so they stay right until the next reset.
+	const unsigned char* wall_tiles;
+public:
+	Map();
+
+	Cell get_cell(unsigned short i_x, unsigned short i_y) const;
+
+	unsigned get_pellet_count() const;
+
+	unsigned short get_chunk_columns() const;
+	unsigned short get_chunk_rows() const;
+	unsigned short get_height() const;
+	unsigned short get_width() const;
+
+	unsigned long long get_chunk_version(unsigned short i_chunk_x, unsigned short i_chunk_y) const;
+
+	const unsigned char* get_wall_tiles() const;
+
+	//Copy the cells (row by row) of a map converted while compiling. The wall tiles must live as long as the map uses them.
+	void load(unsigned short i_width, unsigned short i_height, const Cell* i_cells, const unsigned char* i_wall_tiles, unsigned i_pellet_count);
+
+	//Empty cells. If the size didn't change, this doesn't allocate any memory.
+	void reset(unsigned short i_width, unsigned short i_height);
+	void set_cell(unsigned short i_x, unsigned short i_y, Cell i_cell);
+};
\ No newline at end of file
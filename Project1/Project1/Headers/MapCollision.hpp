@@ -1,3 +1,6 @@
 #pragma once
 
-bool map_collision(bool i_collect_pellets, bool i_use_door, short i_x, short i_y, std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map);
\ No newline at end of file
+//Only the walls (and the door, if we can't use it). It only reads the map, so the ghosts can check it at the same time.
+bool map_collision(bool i_use_door, short i_x, short i_y, const Map& i_map);
+//The walls, or the pellets and energizers we collect (they're also taken out of the map's hash, see Zobrist.hpp).
+bool map_collision(bool i_collect_pellets, bool i_use_door, short i_x, short i_y, Map& i_map, unsigned long long& i_map_hash);
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+//Draws the map one chunk at a time (see Map.hpp).
+//Every chunk keeps its vertices until one of its cells changes, and we only draw the chunks the view touches, so a frame costs the same on a map of any size.
+class MapRenderer
+{
+	//How many chunks we drew in the last frame.
+	unsigned short drawn_chunks;
+
+	//The version of the map chunk that the vertices of every chunk show (0 means none, the map never gives out 0).
+	std::vector<unsigned long long> chunk_versions;
+
+	//The cells of every chunk, as quads of the map texture.
+	std::vector<sf::VertexArray> chunks;
+
+	sf::Texture texture;
+
+	void build_chunk(unsigned short i_chunk_x, unsigned short i_chunk_y, const Map& i_map);
+public:
+	MapRenderer();
+
+	unsigned short get_drawn_chunks();
+
+	//Draws the part of the map inside the view of i_target.
+	void draw(const Map& i_map, sf::RenderTarget& i_target);
+};
\ No newline at end of file
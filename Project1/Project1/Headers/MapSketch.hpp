@@ -0,0 +1,31 @@
+#pragma once
+
+//The default map is MAP_WIDTH x MAP_HEIGHT, but the game can play sketches of any size (see MazeGenerator.hpp).
+//It's a constant, so it's converted while compiling (see CompiledSketch.hpp). A row that's too long doesn't fit, and compile_sketch rejects the short ones.
+constexpr char MAP_SKETCH[MAP_HEIGHT][1 + MAP_WIDTH] =
+{
+	" ################### ",
+	" #........#........# ",
+	" #o##.###.#.###.##o# ",
+	" #.................# ",
+	" #.##.#.#####.#.##.# ",
+	" #....#...#...#....# ",
+	" ####.### # ###.#### ",
+	"    #.#   0   #.#    ",
+	"#####.# ##=## #.#####",
+	"     .  #123#  .     ",
+	"#####.# ##### #.#####",
+	"    #.#       #.#    ",
+	" ####.# ##### #.#### ",
+	" #........#........# ",
+	" #.##.###.#.###.##.# ",
+	" #o.#.....P.....#.o# ",
+	" ##.#.#.#####.#.#.## ",
+	" #....#...#...#....# ",
+	" #.######.#.######.# ",
+	" #.................# ",
+	" ################### "
+};
+
+//The same map, in the format of the maze files.
+const std::vector<std::string>& get_map_sketch();
\ No newline at end of file
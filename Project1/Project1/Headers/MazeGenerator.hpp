@@ -0,0 +1,28 @@
+#pragma once
+
+//What kind of maze we want.
+struct MazeSettings
+{
+	//Is the right half a mirror of the left half (like the original map)?
+	bool symmetric;
+
+	//How many of the walls between corridors we keep, in percent. 100 gives a perfect maze (no loops, lots of dead ends).
+	unsigned char density;
+	unsigned char energizers;
+	//How many rows go through the side of the map (and come out on the other side).
+	unsigned char tunnels;
+
+	//Both sizes are made odd, at least 11 and at most MAX_MAZE_SIZE. The game plays any size up to that (the camera follows Pacman).
+	unsigned short height;
+	unsigned short width;
+};
+
+//Mazes are sketches, like get_map_sketch(), but they can have any size.
+std::vector<std::string> generate_maze(const MazeSettings& i_settings, unsigned i_seed);
+
+//Returns nullptr if the maze can be played, otherwise what's wrong with it.
+const char* validate_maze(const std::vector<std::string>& i_maze);
+
+//In a maze file, the mazes are separated by empty lines.
+bool load_mazes(const std::string& i_file_name, std::vector<std::vector<std::string>>& i_mazes);
+bool save_mazes(const std::string& i_file_name, const std::vector<std::vector<std::string>>& i_mazes);
\ No newline at end of file
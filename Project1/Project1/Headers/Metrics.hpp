@@ -0,0 +1,37 @@
+#pragma once
+
+//Counters for monitoring the game and the servers (in the Prometheus text format, see format_metrics and Headers/MetricsEndpoint.hpp).
+//Every thread counts into its own block, with plain stores that no other thread writes, so counting never waits for a lock or another core.
+//The blocks are only added up when someone reads the metrics.
+enum Metric : unsigned char
+{
+	DrawCallMetric,
+	//A game is completed when Pacman dies (the next one starts at the first level).
+	GameCompletedMetric,
+	LevelWonMetric,
+	TextureLoadMetric,
+	TickMetric,
+	//Ticks slower than their budget (or, on a server, ticks the timer had to skip).
+	TickOverrunMetric
+};
+
+constexpr unsigned char METRIC_COUNT = 6;
+
+//The histograms, in microseconds.
+enum MetricHistogram : unsigned char
+{
+	FrameTimeHistogram,
+	TickTimeHistogram
+};
+
+constexpr unsigned char METRIC_HISTOGRAM_COUNT = 2;
+
+void add_metric(Metric i_metric, unsigned long long i_value = 1);
+void add_metric_sample(MetricHistogram i_histogram, unsigned i_microseconds);
+//Pacman died on this level (that's also a completed game).
+void add_death_metric(unsigned char i_level);
+//The level the thread plays now. With more than one thread (or room), the highest one is shown.
+void set_level_metric(unsigned char i_level);
+
+//Every metric of every thread (the ones that ended too), added up. Any thread can call this at any time.
+std::string format_metrics();
\ No newline at end of file
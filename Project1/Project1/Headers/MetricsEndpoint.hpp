@@ -0,0 +1,26 @@
+#pragma once
+
+//Serves format_metrics from its own thread, on 127.0.0.1 over HTTP (any path), or on a Unix socket (Linux only, the metrics are written as soon as someone connects).
+class MetricsEndpoint
+{
+	std::atomic<bool> running;
+
+	//The listening socket (a SOCKET on Windows), -1 if we aren't serving.
+	long long listener;
+
+	std::string socket_path;
+
+	std::thread thread;
+
+	void serve(bool i_http);
+public:
+	MetricsEndpoint();
+	~MetricsEndpoint();
+
+	MetricsEndpoint(const MetricsEndpoint&) = delete;
+	MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+	//Only one of them, once (make two endpoints to serve both).
+	bool start_http(unsigned short i_port);
+	bool start_unix(const std::string& i_path);
+};
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+//How the versus mode is doing. It's refreshed every second.
+struct NetplayStatistics
+{
+	//How far back in time we had to go.
+	unsigned char max_rollback_depth;
+
+	//How many times we went back in time.
+	unsigned short rollbacks;
+
+	//Frames we had to simulate again after a wrong guess.
+	unsigned resimulated_frames;
+	//Bytes per second, including the IP and UDP headers.
+	unsigned received_bytes;
+	unsigned sent_bytes;
+	//Frames we waited for the other player.
+	unsigned stalled_frames;
+
+	float average_rollback_depth;
+};
+
+//The biggest packet: the header (22 bytes) and 255 inputs.
+constexpr unsigned short MAX_PACKET_SIZE = 277;
+//How many packets can wait for the fake latency (a second of them, with some room to spare).
+constexpr unsigned short MAX_DELAYED_PACKETS = 256;
+
+//A packet waiting for the fake latency to pass.
+struct DelayedPacket
+{
+	unsigned short size;
+
+	std::chrono::time_point<std::chrono::steady_clock> send_time;
+
+	std::array<unsigned char, MAX_PACKET_SIZE> data;
+};
+
+//GGPO-style rollback: we guess the other player's input, and when we guess wrong, we load an older copy of the game and simulate it again.
+class Netplay
+{
+	//Did the handshake finish?
+	bool connected;
+	//0 - I'm Pacman
+	//1 - I'm the red ghost
+	bool player;
+
+	//Fake packet loss, in percent.
+	unsigned char loss;
+
+	//Fake latency (one way), in milliseconds.
+	unsigned short latency;
+	unsigned short remote_port;
+
+	//Every input of the other player before this frame is known.
+	unsigned confirmed_frame;
+	//The first frame where the hashes of the two games were different (UINT_MAX if they never were).
+	unsigned desync_frame;
+	//The first frame we haven't simulated yet.
+	unsigned frame;
+	//The host picks it and sends it to the other player, so both games have the same random numbers.
+	unsigned seed;
+	//This is for the fake packet loss. The game has its own random numbers.
+	unsigned random_state;
+	//The other player knows our inputs before this frame.
+	unsigned remote_ack;
+	//The newest input of the other player we have (plus 1).
+	unsigned remote_frame;
+	//The other player's game had remote_hash after every frame before this one was confirmed (0 if we don't know yet).
+	unsigned remote_hash_frame;
+	//The oldest frame we guessed wrong. If we didn't, it's equal to "frame".
+	unsigned rollback_frame;
+	//This divided by the number of rollbacks is the average depth.
+	unsigned total_rollback_depth;
+
+	//The packets waiting for the fake latency are in a ring too, starting here.
+	unsigned short delayed_packet_count;
+	unsigned short first_delayed_packet;
+
+	unsigned long long remote_hash;
+
+	//The inputs are stored in rings, indexed by (frame % 256).
+	std::array<unsigned char, 256> local_inputs;
+	//If we didn't receive an input yet, this is our guess.
+	std::array<unsigned char, 256> remote_inputs;
+
+	//Which frame every remote input belongs to, so we know if we actually received it.
+	std::array<unsigned, 256> remote_input_frames;
+
+	//The hash of our game after every frame, indexed by (frame % 256), so we can compare it with the other player's.
+	std::array<unsigned long long, 256> hashes;
+
+	std::chrono::time_point<std::chrono::steady_clock> statistics_time;
+
+	//Made once, so sending a packet never allocates memory.
+	std::vector<DelayedPacket> delayed_packets;
+
+	//The game before every frame that may still be wrong, indexed by (frame % (1 + ROLLBACK_FRAMES)).
+	std::vector<Game> snapshots;
+
+	NetplayStatistics current_statistics;
+	NetplayStatistics statistics;
+
+	sf::IpAddress remote_address;
+
+	sf::UdpSocket socket;
+
+	unsigned char get_remote_input(unsigned i_frame);
+
+	void check_hash();
+	void flush();
+	void receive();
+	void refresh_statistics();
+	void rollback(Game& i_game);
+	void send(const unsigned char* i_data, unsigned short i_size);
+	void send_inputs();
+	void simulate(unsigned i_frame, Game& i_game);
+public:
+	Netplay(unsigned short i_latency, unsigned char i_loss);
+
+	bool get_player();
+	bool host(unsigned short i_port, unsigned& i_seed);
+	bool join(const sf::IpAddress& i_address, unsigned short i_port, unsigned& i_seed);
+	bool update(unsigned char i_input, Game& i_game);
+
+	unsigned get_confirmed_frame();
+	//Where the games went different ways (UINT_MAX if they didn't). It may be a few frames after the real one, because we don't compare every frame.
+	unsigned get_desync_frame();
+	unsigned get_frame();
+
+	void poll(Game& i_game);
+
+	NetplayStatistics get_statistics();
+};
\ No newline at end of file
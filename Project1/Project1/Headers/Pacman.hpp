@@ -8,11 +8,19 @@ class Pacman
 	bool dead;
 
 	unsigned char direction;
+	//Which tick of the 60 Hz frame we're in (see get_step).
+	unsigned char movement_phase;
+	//The direction the player pressed last, and how long we'll keep trying to turn there.
+	unsigned char turn;
+	unsigned char turn_timer;
 
 	//More timers!
 	unsigned short animation_timer;
 	unsigned short energizer_timer;
 
+	//Our part of the game's hash (see Zobrist.hpp). The animations aren't in it, because they don't change the game.
+	unsigned long long hash;
+
 	//Current location of this creature, commonly known as Pacman.
 	Position position;
 public:
@@ -25,12 +33,17 @@ public:
 
 	unsigned short get_energizer_timer();
 
-	void draw(bool i_victory, sf::RenderWindow& i_window);
+	//The hash we updated while playing, and the same hash computed from scratch (to check it).
+	unsigned long long compute_hash();
+	unsigned long long get_hash();
+
+	void draw(bool i_victory, EntityRenderer& i_renderer);
 	void reset();
 	void set_animation_timer(unsigned short i_animation_timer);
 	void set_dead(bool i_dead);
 	void set_position(short i_x, short i_y);
-	void update(unsigned char i_level, std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map);
+	//The pellets we eat are taken out of i_map_hash.
+	void update(const LevelSettings& i_level_settings, unsigned char i_input, Map& i_map, unsigned long long& i_map_hash);
 
 	Position get_position();
 };
\ No newline at end of file
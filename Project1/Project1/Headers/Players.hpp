@@ -0,0 +1,30 @@
+#pragma once
+
+//The players of the tools that play without a person: they only depend on their random numbers and on the game, so the same seed always plays the same game.
+//A player that holds a direction and sometimes changes it (pressing it early, like the turn buffer in Pacman::update allows).
+struct RandomPlayer
+{
+	unsigned char direction;
+
+	unsigned random_state;
+};
+
+//What the pellet player searches with. It's kept between the ticks, so the search doesn't allocate.
+struct PelletSearch
+{
+	std::vector<unsigned> queue;
+
+	std::vector<unsigned char> directions;
+};
+
+//A new random player for the game with this seed (the ghosts use the streams 0 to 3 of the seed, the player uses stream 4).
+RandomPlayer get_random_player(unsigned i_seed);
+
+//What the random player presses in the next tick.
+unsigned char get_random_input(RandomPlayer& i_player);
+
+//The first step towards the closest pellet (or energizer), breadth first over the cells (4 if there's none).
+unsigned char get_pellet_direction(const Position& i_position, const Map& i_map, PelletSearch& i_search);
+
+//What a player that goes to the closest pellet presses in the next tick (it keeps going when it can't find one, and takes a random turn at a wall).
+unsigned char get_pellet_input(unsigned char i_input, unsigned& i_random_state, Game& i_game, PelletSearch& i_search);
\ No newline at end of file
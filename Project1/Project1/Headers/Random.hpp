@@ -0,0 +1,6 @@
+#pragma once
+
+//rand() gives different results on different computers, so we use our own generator to keep the game deterministic.
+unsigned get_random(unsigned& i_random_state);
+
+unsigned seed_random(unsigned i_seed, unsigned char i_stream);
\ No newline at end of file
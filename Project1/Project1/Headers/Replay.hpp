@@ -0,0 +1,67 @@
+#pragma once
+
+//A replay is everything needed to play a game again: the seed, the settings that change the game, and the inputs of every tick.
+//The game is deterministic, so playing the inputs again must end with the same level and the same hash (that's how Tools/ReplayVerifier checks the submitted runs).
+//In a file, the replays come one after the other, and the numbers are little-endian.
+//(The replays from before the setup hash have another magic number, so they're read as a broken stream instead of being played with the wrong maze.)
+constexpr unsigned REPLAY_MAGIC = 0x32524b50;
+
+//A replay longer than this is refused without playing it, so a hostile file can't keep a verifier busy for hours (or make us allocate gigabytes).
+//That's almost 5 hours of play at 60 Hz, and a fraction of a second for the verifier.
+constexpr unsigned MAX_REPLAY_TICKS = 1 << 20;
+
+//The magic number (4 bytes), the id (4), the seed (4), the run count (4), the ghost simulation radius (2), versus (1), the level (1), the hash (8) and the setup hash (8).
+constexpr unsigned char REPLAY_HEADER_SIZE = 36;
+//The Pacman input (1 byte), the ghost input (1) and the length (2).
+constexpr unsigned char REPLAY_RUN_SIZE = 4;
+
+//The same inputs for a number of ticks in a row (the inputs don't change often, so this keeps the replays small).
+struct ReplayRun
+{
+	unsigned char ghost_input;
+	unsigned char pacman_input;
+
+	unsigned short length;
+};
+
+struct Replay
+{
+	bool versus;
+
+	//The result the player claims: the level and the hash after the last tick.
+	unsigned char level;
+
+	unsigned short ghost_simulation_radius;
+
+	//Whatever the leaderboard uses to know which submission this is.
+	unsigned id;
+	unsigned seed;
+
+	unsigned long long hash;
+	//The maze and the level settings the game was played with (see get_replay_setup_hash). Another maze or other settings play another game.
+	unsigned long long setup_hash;
+
+	std::vector<ReplayRun> runs;
+};
+
+//What read_replay found.
+enum ReplayStatus : unsigned char
+{
+	//The file ended (or broke) before a whole replay, so we can't know where the next one starts.
+	BrokenReplay,
+	//A whole replay we refuse to play: it's longer than MAX_REPLAY_TICKS, or it has a run of 0 ticks (add_replay_input never writes one).
+	//The next replay starts right after it. The runs of a replay with too many of them aren't kept.
+	RefusedReplay,
+	ValidReplay
+};
+
+//Add the inputs of one more tick.
+void add_replay_input(unsigned char i_pacman_input, unsigned char i_ghost_input, Replay& i_replay);
+
+unsigned long long get_replay_ticks(const Replay& i_replay);
+//The hash of the maze and of the settings of every level (after load_level_settings), so the verifier can tell a replay of another setup from a cheat.
+unsigned long long get_replay_setup_hash(const std::vector<std::string>& i_map_sketch);
+
+//The runs keep their memory, so reading into the same replay again doesn't allocate unless it's longer than every one before.
+ReplayStatus read_replay(std::FILE* i_file, Replay& i_replay);
+bool write_replay(std::FILE* i_file, const Replay& i_replay);
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+//The messages between pakku-server and its clients. They're sent over TCP, they have fixed sizes, and the numbers are little-endian.
+//The port pakku-server listens on.
+constexpr unsigned short SERVER_PORT = 54100;
+
+//Client -> server, always the first message: the room (4 bytes), the player (1 byte, 0 - Pacman, 1 - the red ghost) and versus (1 byte).
+//The first player to join a room decides if it's a versus room.
+constexpr unsigned char MESSAGE_JOIN = 0;
+//Client -> server: the input bitmask (1 byte). The server uses the newest one every tick.
+constexpr unsigned char MESSAGE_INPUT = 1;
+//Server -> client, after every tick: the frame (4 bytes), the level (1 byte), Pacman's x and y (2 + 2 bytes), every ghost's x and y (4 * (2 + 2) bytes) and the checksum (the lower 4 bytes of Game::get_hash).
+constexpr unsigned char MESSAGE_STATE = 2;
+
+constexpr unsigned char INPUT_MESSAGE_SIZE = 2;
+constexpr unsigned char JOIN_MESSAGE_SIZE = 7;
+constexpr unsigned char STATE_MESSAGE_SIZE = 30;
\ No newline at end of file
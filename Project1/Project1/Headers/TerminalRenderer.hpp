@@ -0,0 +1,90 @@
+#pragma once
+
+//Every cell of the map takes this many columns of the terminal (the characters are about twice as tall as they're wide, so the cells stay square).
+constexpr unsigned char TERMINAL_CELL_COLUMNS = 2;
+//The longest status line we write (the level, the pellets, and the note of the caller).
+constexpr unsigned char TERMINAL_STATUS_SIZE = 120;
+
+//What a cell of the terminal shows: a glyph (see TerminalRenderer.cpp) in a color of the 256 color palette.
+struct TerminalCell
+{
+	unsigned char color;
+	unsigned char glyph;
+
+	bool operator==(const TerminalCell& i_cell) const
+	{
+		return this->color == i_cell.color && this->glyph == i_cell.glyph;
+	}
+};
+
+//Draws a game in a terminal with ANSI escape sequences and Unicode, so the games on a server can be watched over SSH. It doesn't need a window or a display.
+//It keeps what the terminal shows (a shadow framebuffer), and a frame only writes the cells that changed since the last one.
+//It doesn't look at the whole map every frame either: only the chunks whose version changed (that's how it sees the pellets Pacman ate) and the cells Pacman and the ghosts left or entered.
+//So a frame usually writes a few dozen bytes, and nothing at all when nothing moved.
+class TerminalRenderer
+{
+	//Do we have to clear the terminal and write every cell (the first frame, and after a resize)?
+	bool redraw;
+
+	//The color the terminal writes with now.
+	unsigned char color;
+
+	//The size of the terminal.
+	unsigned short columns;
+	unsigned short rows;
+	//The map cell in the top left corner of the view.
+	unsigned short camera_x;
+	unsigned short camera_y;
+	//Where the cursor is, in the cells of the view. (It's at the start of a cell, because we always write whole cells.)
+	unsigned short cursor_x;
+	unsigned short cursor_y;
+	unsigned short map_height;
+	unsigned short map_width;
+	//How many map cells the view shows.
+	unsigned short view_height;
+	unsigned short view_width;
+
+	//How many cells the last frame wrote.
+	unsigned changed_cells;
+
+	//The cell of Pacman and of every ghost in the view in the last frame (the size of the view if they weren't in it).
+	std::array<unsigned, 5> entity_cells;
+
+	//The status line the terminal shows.
+	std::array<char, TERMINAL_STATUS_SIZE> shown_status;
+
+	//The version of every map chunk (see Map.hpp) that map_cells shows.
+	std::vector<unsigned long long> chunk_versions;
+
+	//The cells of the view we have to compare in this frame, and a mark for each one so it's only there once.
+	std::vector<unsigned> dirty_cells;
+	std::vector<bool> dirty_marks;
+
+	//The map without Pacman and the ghosts, and what the terminal shows, in the cells of the view, row by row.
+	std::vector<TerminalCell> map_cells;
+	std::vector<TerminalCell> shown_cells;
+
+	//The escape sequences of a frame. It keeps its memory, so a frame doesn't allocate.
+	std::string output;
+
+	void mark_cell(unsigned i_cell);
+	void move_cursor(unsigned short i_x, unsigned short i_y);
+	void set_color(unsigned char i_color);
+	void update_camera(Position i_pacman_position);
+	void update_map(const Map& i_map);
+	void write_status(const char* i_status);
+public:
+	TerminalRenderer();
+
+	//How many cells the last frame wrote.
+	unsigned get_changed_cells();
+
+	//The terminal has a new size (or was cleared), so the next frame clears it and writes every cell again.
+	void resize(unsigned short i_columns, unsigned short i_rows);
+
+	//The escape sequences that turn what the terminal shows into the game (nothing if the game looks the same). i_note goes at the end of the status line.
+	//They're only valid until the next frame, and the caller must write all of them, or the terminal won't show what we think it does.
+	const std::string& draw(Game& i_game, const char* i_note);
+	//The escape sequences that leave the terminal like we found it: the normal color, the cursor back, and on the line under the game.
+	const std::string& finish();
+};
\ No newline at end of file
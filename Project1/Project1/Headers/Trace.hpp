@@ -0,0 +1,34 @@
+#pragma once
+
+//Trace zones show where the time of every frame goes, in chrome://tracing or ui.perfetto.dev.
+//Put TRACE_ZONE("Name"); at the top of a block, and the time until the end of the block goes into the ring buffer of the thread.
+//They only exist if PAKKU_TRACE is defined (in the project settings, or with -DPAKKU_TRACE). Otherwise TRACE_ZONE is nothing and the functions below do nothing.
+#ifdef PAKKU_TRACE
+constexpr bool TRACE_ENABLED = 1;
+
+//Use TRACE_ZONE instead of this.
+class TraceZone
+{
+	const char* name;
+
+	unsigned long long start_time;
+public:
+	TraceZone(const char* i_name);
+	~TraceZone();
+};
+
+#define TRACE_JOIN(i_a, i_b) i_a##i_b
+#define TRACE_ZONE_NAME(i_line) TRACE_JOIN(trace_zone_, i_line)
+//The name must live forever (a string literal).
+#define TRACE_ZONE(i_name) TraceZone TRACE_ZONE_NAME(__LINE__)(i_name)
+#else
+constexpr bool TRACE_ENABLED = 0;
+
+#define TRACE_ZONE(i_name)
+#endif
+
+//Save the newest zones of every thread in a Chrome trace file. Any thread can call this at any time.
+bool save_trace(const std::string& i_file_name);
+
+//How the current thread is called in the trace.
+void set_trace_thread_name(const std::string& i_name);
\ No newline at end of file
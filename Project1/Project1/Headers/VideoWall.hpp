@@ -0,0 +1,85 @@
+#pragma once
+
+//Tiles with fewer pixels than this for every cell draw the map as one pixel per cell, and Pacman and the ghosts as colored squares.
+constexpr unsigned char VIDEO_WALL_DETAIL_SIZE = 8;
+
+//One game on the wall.
+struct VideoWallTile
+{
+	//Every publish gives the tile a new version, so we know which tiles have something new to draw.
+	unsigned long long drawn_version;
+	unsigned long long version;
+	//The hash of the game we drew last. The small tiles skip the games that didn't change (a paused or finished one).
+	unsigned long long drawn_hash;
+
+	//The version of every map chunk in the pixels of a small tile (see Map.hpp).
+	std::vector<unsigned long long> chunk_versions;
+
+	//Guards the snapshot and the version.
+	std::mutex mutex;
+
+	//The game we draw, and the one the simulation published last.
+	//They're made by the first publish (a game has no empty constructor), and copying into them after that doesn't allocate.
+	std::unique_ptr<Game> game;
+	std::unique_ptr<Game> snapshot;
+
+	//Only the detailed tiles use it.
+	MapRenderer map_renderer;
+};
+
+//Shows many games in one window, every one of them in its own tile.
+//The simulation publishes a copy of a game whenever it wants (from any thread), and drawing only redraws the tiles that changed into a texture that keeps the rest.
+//Small tiles don't need the sprites: all of them are drawn together in two draw calls (the maps, then Pacman and the ghosts).
+class VideoWall
+{
+	//Are the tiles big enough for the sprites?
+	bool detailed;
+
+	unsigned short columns;
+	//How many draw calls and tiles the last draw redrew.
+	unsigned short draw_calls;
+	unsigned short map_height;
+	unsigned short map_width;
+	unsigned short redrawn_tiles;
+
+	//How many pixels a cell has (it's usually not a whole number).
+	float cell_size;
+
+	//The pixels of the chunk we're sending to cell_texture.
+	std::vector<sf::Uint8> chunk_pixels;
+
+	std::vector<std::unique_ptr<VideoWallTile>> tiles;
+
+	//The map of every small tile, one pixel per cell, in the same columns and rows as the tiles.
+	sf::Texture cell_texture;
+
+	//The quads of the small tiles that changed this frame.
+	sf::VertexArray cell_vertices;
+	sf::VertexArray entity_vertices;
+
+	//Every tile we ever drew, so a frame only has to redraw the ones that changed.
+	sf::RenderTexture canvas;
+
+	EntityRenderer entity_renderer;
+
+	void add_small_tile(unsigned short i_tile);
+	void draw_detailed_tile(unsigned short i_tile);
+	void update_cell_texture(unsigned short i_tile);
+
+	//The top left corner of a tile on the canvas.
+	sf::Vector2f get_tile_position(unsigned short i_tile) const;
+public:
+	VideoWall();
+
+	//Pick the columns and the rows that make the tiles biggest. Every game must be on a map of this size.
+	//Returns 0 if the canvas (or the map of the small tiles) is bigger than a texture can be.
+	bool create(unsigned short i_tile_count, unsigned short i_map_width, unsigned short i_map_height, unsigned i_width, unsigned i_height);
+
+	unsigned short get_draw_calls();
+	unsigned short get_redrawn_tiles();
+
+	//Copy the game into the tile. Any thread can do this at any time, and it doesn't wait for drawing (only for the copy into the tile).
+	void publish(unsigned short i_tile, Game& i_game);
+	//Redraw the tiles that were published since the last draw, then draw the wall in the view of i_target.
+	void draw(sf::RenderTarget& i_target);
+};
\ No newline at end of file
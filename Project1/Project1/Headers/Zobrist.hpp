@@ -0,0 +1,58 @@
+#pragma once
+
+//Zobrist hashing: every value of every part of the game has its own random 64-bit key, and the hash of the game is the XOR of the keys of the values it has right now.
+//When something changes, we XOR the key of the old value out and the key of the new one in, so the hash is never computed from scratch while playing.
+//The keys come from a hash function instead of a table, so they're the same on every computer and they don't need any memory.
+
+//Define PAKKU_CHECK_HASH (in the project settings, or with -DPAKKU_CHECK_HASH) to compute the hash from scratch after every tick and stop the game if it's different.
+#ifdef PAKKU_CHECK_HASH
+constexpr bool CHECK_HASH = 1;
+#else
+constexpr bool CHECK_HASH = 0;
+#endif
+
+//The parts of the game. The index tells the cells, the ghosts and the coordinates apart (it has 24 bits, so a map can have 16 million cells).
+constexpr unsigned char HASH_CELL = 0;
+constexpr unsigned char HASH_GAME_WON = 1;
+constexpr unsigned char HASH_GHOST_DIRECTION = 2;
+constexpr unsigned char HASH_GHOST_FRIGHTENED_MODE = 3;
+constexpr unsigned char HASH_GHOST_FRIGHTENED_SPEED_TIMER = 4;
+constexpr unsigned char HASH_GHOST_HOME = 5;
+constexpr unsigned char HASH_GHOST_MOVEMENT_MODE = 6;
+constexpr unsigned char HASH_GHOST_MOVEMENT_PHASE = 7;
+constexpr unsigned char HASH_GHOST_PLAYER_CONTROLLED = 8;
+constexpr unsigned char HASH_GHOST_POSITION = 9;
+constexpr unsigned char HASH_GHOST_RANDOM_STATE = 10;
+constexpr unsigned char HASH_GHOST_TARGET = 11;
+constexpr unsigned char HASH_GHOST_TICK = 12;
+constexpr unsigned char HASH_GHOST_USE_DOOR = 13;
+constexpr unsigned char HASH_LEVEL = 14;
+constexpr unsigned char HASH_PACMAN_DEAD = 15;
+constexpr unsigned char HASH_PACMAN_DIRECTION = 16;
+constexpr unsigned char HASH_PACMAN_ENERGIZER_TIMER = 17;
+constexpr unsigned char HASH_PACMAN_MOVEMENT_PHASE = 18;
+constexpr unsigned char HASH_PACMAN_POSITION = 19;
+constexpr unsigned char HASH_PACMAN_TURN = 20;
+constexpr unsigned char HASH_PACMAN_TURN_TIMER = 21;
+constexpr unsigned char HASH_WAVE = 22;
+constexpr unsigned char HASH_WAVE_TIMER = 23;
+
+//The key of one value of one part of the game (splitmix64, so every bit of the input changes half of the output).
+constexpr unsigned long long get_zobrist_key(unsigned char i_part, unsigned i_index, int i_value)
+{
+	unsigned long long output = 0x9e3779b97f4a7c15ull * (1 + ((static_cast<unsigned long long>(i_part) << 56) | (static_cast<unsigned long long>(i_index) << 32) | static_cast<unsigned>(i_value)));
+
+	output = 0xbf58476d1ce4e5b9ull * (output ^ (output >> 30));
+	output = 0x94d049bb133111ebull * (output ^ (output >> 27));
+
+	return output ^ (output >> 31);
+}
+
+//Swap the key of the old value for the key of the new one (if it changed).
+inline void update_zobrist_hash(unsigned char i_part, unsigned i_index, int i_old_value, int i_new_value, unsigned long long& i_hash)
+{
+	if (i_old_value != i_new_value)
+	{
+		i_hash ^= get_zobrist_key(i_part, i_index, i_old_value) ^ get_zobrist_key(i_part, i_index, i_new_value);
+	}
+}
\ No newline at end of file
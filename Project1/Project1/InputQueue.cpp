@@ -0,0 +1,122 @@
+#include <array>  // For the event queue
+#include <chrono> // For the event times
+#include <SFML/Graphics.hpp> // For SFML graphics components
+
+#include "Headers/Global.hpp"     // Header for global constants and definitions
+#include "Headers/InputQueue.hpp" // Header for the InputQueue class definition
+
+// Constructor for the InputQueue class with nothing pressed
+InputQueue::InputQueue() :
+    pressed(0),
+    event_count(0),
+    held(0)
+{
+}
+
+// Did the last tick get a new press?
+bool InputQueue::get_pressed() {
+    return pressed;
+}
+
+// Turn every event since the last tick into the input of this tick
+unsigned char InputQueue::update() {
+    unsigned char output = 0;
+    // The newest direction pressed (4 means none)
+    unsigned char turn = 4;
+
+    pressed = 0;
+
+    for (unsigned char a = 0; a < event_count; a++) {
+        const InputEvent& event = events[a];
+
+        if (event.pressed) {
+            if (!pressed) {
+                pressed = 1;
+                press_time = event.time;
+            }
+
+            held |= event.input;
+
+            // Even if the key was already released, this tick sees it
+            output |= event.input;
+
+            for (unsigned char b = 0; b < 4; b++) {
+                if (event.input == (1 << b)) {
+                    turn = b;
+                }
+            }
+        }
+        else {
+            held &= ~event.input;
+        }
+    }
+
+    event_count = 0;
+
+    output |= held;
+
+    if (turn != 4) {
+        output |= INPUT_TURN | (turn << 5);
+    }
+
+    return output;
+}
+
+// Add an event to the queue
+// (64 events between two ticks means something is very wrong, so we just ignore the rest)
+void InputQueue::push(const InputEvent& i_event) {
+    if (event_count < INPUT_QUEUE_SIZE) {
+        events[event_count] = i_event;
+
+        event_count++;
+    }
+}
+
+// Read every window event that arrived, and remember when we got it
+void InputQueue::poll(sf::RenderWindow& i_window) {
+    sf::Event event;
+
+    while (i_window.pollEvent(event)) {
+        std::chrono::time_point<std::chrono::steady_clock> time = std::chrono::steady_clock::now();
+
+        switch (event.type) {
+        case sf::Event::Closed:
+            // If the window close event is triggered, close the game window
+            i_window.close();
+            break;
+
+        case sf::Event::LostFocus:
+            // We won't hear about the keys released in another window, so we release them now
+            push({ 0, 0xFF, time });
+            break;
+
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            unsigned char input = 0;
+
+            switch (event.key.code) {
+            case sf::Keyboard::Right: input = 1; break;
+            case sf::Keyboard::Up: input = 2; break;
+            case sf::Keyboard::Left: input = 4; break;
+            case sf::Keyboard::Down: input = 8; break;
+            case sf::Keyboard::Enter: input = INPUT_RESTART; break;
+            default: break;
+            }
+
+            if (input != 0) {
+                push({ event.type == sf::Event::KeyPressed, input, time });
+            }
+
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
+
+// Get when the first press of the last tick happened
+std::chrono::time_point<std::chrono::steady_clock> InputQueue::get_press_time() {
+    return press_time;
+}
@@ -0,0 +1,82 @@
+#include <algorithm> // For std::max
+#include <chrono> // For measuring the latency
+#include <cstdio> // For printing the results
+#include <SFML/Graphics.hpp> // For SFML graphics components
+
+#include "Headers/Global.hpp"      // Header for global constants and definitions
+#include "Headers/LatencyTest.hpp" // Header for the LatencyTest class definition
+
+// How many frames the moving bar takes to cross the screen
+constexpr unsigned char LATENCY_BAR_FRAMES = 16;
+
+// Constructor for the LatencyTest class
+LatencyTest::LatencyTest(bool i_enabled) :
+    enabled(i_enabled),
+    waiting(0),
+    white(0),
+    frame(0),
+    max_latency(0),
+    total_latency(0),
+    samples(0),
+    bar(sf::Vector2f(CELL_SIZE * VIEW_WIDTH / static_cast<float>(LATENCY_BAR_FRAMES), 2)),
+    square(sf::Vector2f(2 * CELL_SIZE, 2 * CELL_SIZE))
+{
+    bar.setFillColor(sf::Color(255, 255, 255));
+
+    square.setPosition(CELL_SIZE * (VIEW_WIDTH - 2), 0);
+}
+
+// Is the test pattern on the screen?
+bool LatencyTest::get_enabled() {
+    return enabled;
+}
+
+// Call this right after window.display(). If a press is waiting, this frame is the one that shows it.
+void LatencyTest::displayed() {
+    if (!enabled) {
+        return;
+    }
+
+    frame = (1 + frame) % LATENCY_BAR_FRAMES;
+
+    if (waiting) {
+        long long latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - press_time).count();
+
+        waiting = 0;
+
+        max_latency = std::max(max_latency, latency);
+        total_latency += latency;
+
+        samples++;
+
+        std::printf("Input to display: %lld us (average %lld us, max %lld us, %u presses)\n", latency, total_latency / samples, max_latency, samples);
+    }
+}
+
+// Draw the test pattern on top of the game
+void LatencyTest::draw(sf::RenderWindow& i_window) {
+    if (!enabled) {
+        return;
+    }
+
+    // The square flips with every press
+    square.setFillColor(white ? sf::Color(255, 255, 255) : sf::Color(0, 0, 0));
+
+    i_window.draw(square);
+
+    // The bar moves one step every frame
+    bar.setPosition(frame * CELL_SIZE * VIEW_WIDTH / static_cast<float>(LATENCY_BAR_FRAMES), CELL_SIZE * VIEW_HEIGHT + FONT_HEIGHT - 2);
+
+    i_window.draw(bar);
+}
+
+// A tick used a new press (the time is when we read it from the window)
+void LatencyTest::press(const std::chrono::time_point<std::chrono::steady_clock>& i_time) {
+    if (!waiting) {
+        waiting = 1;
+
+        press_time = i_time;
+    }
+
+    white = !white;
+}
@@ -0,0 +1,166 @@
+#include <algorithm> // For std::min
+#include <fstream>   // For reading the level file
+#include <sstream>   // For reading the numbers in a line
+#include <string>    // For std::string
+#include <vector>    // For std::vector
+
+#include "Headers/Global.hpp"        // Header for global constants and definitions
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+
+// The original rules: every level halves the energizer and scatter durations
+// After level 9, they would round down to 0 (and the ghosts would never be frightened again), so that's where the table ends
+constexpr unsigned char DEFAULT_LEVEL_COUNT = 10;
+
+// Get the default settings of a level
+static constexpr LevelSettings get_default_level_settings(unsigned char i_level) {
+    return {
+        GHOST_1_CHASE,
+        GHOST_2_CHASE,
+        GHOST_3_CHASE,
+        GHOST_ESCAPE_SPEED,
+        GHOST_FRIGHTENED_SPEED,
+        GHOST_SPEED,
+        PACMAN_SPEED,
+        CHASE_DURATION,
+        static_cast<unsigned short>(ENERGIZER_DURATION >> i_level),
+        GHOST_FLASH_START,
+        static_cast<unsigned short>(LONG_SCATTER_DURATION >> i_level),
+        static_cast<unsigned short>(SHORT_SCATTER_DURATION >> i_level)
+    };
+}
+
+static_assert(get_default_level_settings(DEFAULT_LEVEL_COUNT - 1).energizer_duration > 0, "Every level needs a frightened mode.");
+
+// The table we're using
+static std::vector<LevelSettings>& get_level_table() {
+    static std::vector<LevelSettings> level_table = [] {
+        std::vector<LevelSettings> output;
+
+        for (unsigned char a = 0; a < DEFAULT_LEVEL_COUNT; a++) {
+            output.push_back(get_default_level_settings(a));
+        }
+
+        return output;
+    }();
+
+    return level_table;
+}
+
+// Can something move at this speed? (It has to land exactly on every cell.)
+static bool is_valid_speed(unsigned i_speed) {
+    return 0 < i_speed && i_speed < CELL_SIZE && CELL_SIZE % i_speed == 0;
+}
+
+// Get the settings of a level
+const LevelSettings& get_level_settings(unsigned char i_level) {
+    const std::vector<LevelSettings>& level_table = get_level_table();
+
+    return level_table[std::min<std::size_t>(i_level, level_table.size() - 1)];
+}
+
+// Read a level file. Every line is one level, with these numbers:
+// chase energizer ghost_flash_start long_scatter short_scatter pacman_speed ghost_speed ghost_escape_speed ghost_frightened_speed [ghost_1_chase ghost_2_chase ghost_3_chase]
+// The chase distances are in cells, and a line without them uses the ones in Global.hpp
+// The durations are in 60 Hz frames (like the original ones), and lines starting with '#' are comments
+// If anything is wrong, we keep the table we had
+bool load_level_settings(const std::string& i_file_name) {
+    std::ifstream file(i_file_name);
+
+    std::string line;
+
+    std::vector<LevelSettings> level_table;
+
+    if (!file) {
+        return 0;
+    }
+
+    while (std::getline(file, line)) {
+        std::istringstream numbers(line);
+
+        // Chase, energizer, flash start, long scatter, short scatter, then the speeds
+        unsigned durations[5];
+        unsigned speeds[4];
+        // The chase distances of the pink, blue and orange ghosts
+        unsigned chase_distances[3] = { GHOST_1_CHASE, GHOST_2_CHASE, GHOST_3_CHASE };
+
+        if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        for (unsigned& duration : durations) {
+            numbers >> duration;
+        }
+
+        for (unsigned& speed : speeds) {
+            numbers >> speed;
+        }
+
+        if (!numbers) {
+            return 0;
+        }
+
+        // The chase distances are all there or none of them is
+        unsigned char chase_distance_count = 0;
+
+        for (unsigned& chase_distance : chase_distances) {
+            unsigned distance;
+
+            if (numbers >> distance) {
+                chase_distance = distance;
+                chase_distance_count++;
+            }
+        }
+
+        // Anything after the last number (or a word instead of a number) is a mistake in the file
+        numbers.clear();
+
+        if (!(numbers >> std::ws).eof()) {
+            return 0;
+        }
+
+        if (chase_distance_count % 3 != 0 || 255 < chase_distances[0] || 255 < chase_distances[1] || 255 < chase_distances[2]) {
+            return 0;
+        }
+
+        if (durations[1] == 0 || !is_valid_speed(speeds[0]) || !is_valid_speed(speeds[1]) || !is_valid_speed(speeds[2]) || 255 < speeds[3]) {
+            return 0;
+        }
+
+        // The file is in 60 Hz frames, the table is in ticks
+        for (unsigned& duration : durations) {
+            if (65535 / TICK_MULTIPLIER < duration) {
+                return 0;
+            }
+
+            duration *= TICK_MULTIPLIER;
+        }
+
+        // The frightened ghost moves once every (1 + ghost_frightened_speed) ticks
+        if (255 < (1 + speeds[3]) * TICK_MULTIPLIER) {
+            return 0;
+        }
+
+        level_table.push_back({
+            static_cast<unsigned char>(chase_distances[0]),
+            static_cast<unsigned char>(chase_distances[1]),
+            static_cast<unsigned char>(chase_distances[2]),
+            static_cast<unsigned char>(speeds[2]),
+            static_cast<unsigned char>((1 + speeds[3]) * TICK_MULTIPLIER - 1),
+            static_cast<unsigned char>(speeds[1]),
+            static_cast<unsigned char>(speeds[0]),
+            static_cast<unsigned short>(durations[0]),
+            static_cast<unsigned short>(durations[1]),
+            static_cast<unsigned short>(durations[2]),
+            static_cast<unsigned short>(durations[3]),
+            static_cast<unsigned short>(durations[4])
+        });
+    }
+
+    if (level_table.empty()) {
+        return 0;
+    }
+
+    get_level_table() = level_table;
+
+    return 1;
+}
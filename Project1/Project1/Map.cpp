@@ -0,0 +1,144 @@
+#include <algorithm> // For std::copy and std::min
+#include <array>  // For std::array
+#include <atomic> // For the chunk version counter
+#include <vector> // For std::vector
+
+#include "Headers/Global.hpp" // Header for global constants and definitions
+#include "Headers/Map.hpp"    // Header for the Map class definition
+
+// How many chunk versions a thread takes at once (so converting a big sketch doesn't touch the atomic for every cell)
+constexpr unsigned CHUNK_VERSION_BLOCK = 65536;
+
+// The last chunk version any thread took (the server runs games on many threads, so it's atomic)
+static std::atomic<unsigned long long> last_chunk_version(0);
+
+// Get a chunk version nobody had before
+static unsigned long long get_new_chunk_version() {
+    // The versions this thread took and didn't use yet
+    thread_local unsigned long long next_version = 1;
+    thread_local unsigned long long end_version = 1;
+
+    if (next_version == end_version) {
+        next_version = 1 + last_chunk_version.fetch_add(CHUNK_VERSION_BLOCK);
+        end_version = next_version + CHUNK_VERSION_BLOCK;
+    }
+
+    return next_version++;
+}
+
+// Constructor for the Map class (an empty map, until the sketch is converted)
+Map::Map() :
+    height(0),
+    width(0),
+    chunk_columns(0),
+    chunk_rows(0),
+    pellet_count(0),
+    wall_tiles(nullptr)
+{
+}
+
+// Get the cell at a position (it must be inside the map)
+Cell Map::get_cell(unsigned short i_x, unsigned short i_y) const {
+    return chunks[i_x / CHUNK_SIZE + chunk_columns * (i_y / CHUNK_SIZE)][i_x % CHUNK_SIZE + CHUNK_SIZE * (i_y % CHUNK_SIZE)];
+}
+
+// Get how many pellets are left
+unsigned Map::get_pellet_count() const {
+    return pellet_count;
+}
+
+// Get how many chunks there are in a row
+unsigned short Map::get_chunk_columns() const {
+    return chunk_columns;
+}
+
+// Get how many chunks there are in a column
+unsigned short Map::get_chunk_rows() const {
+    return chunk_rows;
+}
+
+// Get the height of the map in cells
+unsigned short Map::get_height() const {
+    return height;
+}
+
+// Get the width of the map in cells
+unsigned short Map::get_width() const {
+    return width;
+}
+
+// Get the version of a chunk (it changes every time one of its cells changes)
+unsigned long long Map::get_chunk_version(unsigned short i_chunk_x, unsigned short i_chunk_y) const {
+    return chunk_versions[i_chunk_x + chunk_columns * i_chunk_y];
+}
+
+// Get the wall tiles worked out while compiling (nullptr if there are none)
+const unsigned char* Map::get_wall_tiles() const {
+    return wall_tiles;
+}
+
+// Copy a whole map at once, without looking at every cell
+void Map::load(unsigned short i_width, unsigned short i_height, const Cell* i_cells, const unsigned char* i_wall_tiles, unsigned i_pellet_count) {
+    reset(i_width, i_height);
+
+    // Every row of a chunk is next to each other in the source too
+    for (unsigned short a = 0; a < i_height; a++) {
+        for (unsigned short b = 0; b < i_width; b += CHUNK_SIZE) {
+            std::copy(i_cells + b + i_width * a, i_cells + std::min<unsigned>(i_width, CHUNK_SIZE + b) + i_width * a, &chunks[b / CHUNK_SIZE + chunk_columns * (a / CHUNK_SIZE)][CHUNK_SIZE * (a % CHUNK_SIZE)]);
+        }
+    }
+
+    pellet_count = i_pellet_count;
+    wall_tiles = i_wall_tiles;
+}
+
+// Make the map empty, with a new size
+void Map::reset(unsigned short i_width, unsigned short i_height) {
+    height = i_height;
+    width = i_width;
+    chunk_columns = static_cast<unsigned short>((i_width + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    chunk_rows = static_cast<unsigned short>((i_height + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    pellet_count = 0;
+
+    wall_tiles = nullptr;
+
+    // The cells of the last chunks that are outside the map are empty too, and nobody looks at them
+    chunks.resize(chunk_columns * chunk_rows);
+    chunk_versions.resize(chunk_columns * chunk_rows);
+
+    for (unsigned a = 0; a < chunks.size(); a++) {
+        chunks[a].fill(Cell::Empty);
+
+        chunk_versions[a] = get_new_chunk_version();
+    }
+}
+
+// Change a cell, and give its chunk a new version
+void Map::set_cell(unsigned short i_x, unsigned short i_y, Cell i_cell) {
+    unsigned chunk = i_x / CHUNK_SIZE + chunk_columns * (i_y / CHUNK_SIZE);
+
+    Cell& cell = chunks[chunk][i_x % CHUNK_SIZE + CHUNK_SIZE * (i_y % CHUNK_SIZE)];
+
+    if (cell == i_cell) {
+        return;
+    }
+
+    // Keep counting the pellets, so nobody has to look at the whole map to know if Pacman won
+    if (cell == Cell::Pellet) {
+        pellet_count--;
+    }
+
+    if (i_cell == Cell::Pellet) {
+        pellet_count++;
+    }
+
+    // The renderer has to work out the wall tiles again
+    if (cell == Cell::Wall || i_cell == Cell::Wall) {
+        wall_tiles = nullptr;
+    }
+
+    cell = i_cell;
+
+    chunk_versions[chunk] = get_new_chunk_version();
+}
@@ -1,8 +1,52 @@
 #include <array>  // For std::array
-#include <cmath>  // For mathematical operations like floor and ceil
+#include <string> // For std::string
+#include <vector> // For std::vector
 
 #include "Headers/Global.hpp"      // Header for global constants and definitions
+#include "Headers/Map.hpp"          // Header for the Map class definition
 #include "Headers/MapCollision.hpp" // Header for map_collision function definition
+#include "Headers/Trace.hpp"        // Header for the trace zones
+#include "Headers/Zobrist.hpp"      // Header for the Zobrist hash
+
+// The cell a coordinate is in, rounded up (get_floor_cell in Global.hpp rounds down)
+static short get_ceil_cell(int i_coordinate) {
+    return get_floor_cell(CELL_SIZE - 1 + i_coordinate);
+}
+
+// The cells a CELL_SIZE x CELL_SIZE square at (i_x, i_y) touches: top-left, top-right, bottom-left and bottom-right
+// (When the square is aligned to the cells, some of them are the same cell.)
+static std::array<Position, 4> get_touched_cells(short i_x, short i_y) {
+    short left = get_floor_cell(i_x);
+    short right = get_ceil_cell(i_x);
+    short top = get_floor_cell(i_y);
+    short bottom = get_ceil_cell(i_y);
+
+    return { Position{ left, top }, Position{ right, top }, Position{ left, bottom }, Position{ right, bottom } };
+}
+
+// Function to check for collisions with the walls (and the door, if we can't use it)
+// It only reads the map, so every ghost can check it at the same time
+bool map_collision(
+    bool i_use_door,
+    short i_x,
+    short i_y,
+    const Map& i_map
+) {
+    TRACE_ZONE("map_collision");
+
+    for (const Position& cell_position : get_touched_cells(i_x, i_y)) {
+        // Check if the cell is within the bounds of the map
+        if (cell_position.x >= 0 && cell_position.y >= 0 && cell_position.x < i_map.get_width() && cell_position.y < i_map.get_height()) {
+            Cell cell = i_map.get_cell(cell_position.x, cell_position.y);
+
+            if (cell == Cell::Wall || (!i_use_door && cell == Cell::Door)) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
 
 // Function to check for collisions or collectables on the map
 bool map_collision(
@@ -10,61 +54,35 @@ bool map_collision(
     bool i_use_door,         // Whether to consider doors as obstacles
     short i_x,               // X-coordinate of the point to check
     short i_y,               // Y-coordinate of the point to check
-    std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map // The map to check against
+    Map& i_map,              // The map to check against
+    unsigned long long& i_map_hash // The hash of the map, without the pellets we collect
 ) {
-    bool output = false;  // Collision result (default to no collision)
-
-    // Calculate the cell coordinates from the provided x and y values
-    float cell_x = i_x / static_cast<float>(CELL_SIZE);
-    float cell_y = i_y / static_cast<float>(CELL_SIZE);
-
-    // A point can intersect up to four cells (top-left, top-right, bottom-left, bottom-right)
-    for (unsigned char a = 0; a < 4; a++) {
-        short x = 0;  // x-coordinate of the current cell
-        short y = 0;  // y-coordinate of the current cell
-
-        // Determine the specific cell coordinates to check based on the index
-        switch (a) {
-        case 0:  // Top-left cell
-            x = static_cast<short>(floor(cell_x));
-            y = static_cast<short>(floor(cell_y));
-            break;
+    // If we're not collecting pellets, it's only the walls and the door
+    if (!i_collect_pellets) {
+        return map_collision(i_use_door, i_x, i_y, i_map);
+    }
 
-        case 1:  // Top-right cell
-            x = static_cast<short>(ceil(cell_x));
-            y = static_cast<short>(floor(cell_y));
-            break;
+    TRACE_ZONE("map_collision");
 
-        case 2:  // Bottom-left cell
-            x = static_cast<short>(floor(cell_x));
-            y = static_cast<short>(ceil(cell_y));
-            break;
+    bool output = false;  // Collision result (default to no collision)
 
-        case 3:  // Bottom-right cell
-            x = static_cast<short>(ceil(cell_x));
-            y = static_cast<short>(ceil(cell_y));
-            break;
-        }
+    // A point can intersect up to four cells (top-left, top-right, bottom-left, bottom-right)
+    for (const Position& cell_position : get_touched_cells(i_x, i_y)) {
+        short x = cell_position.x;
+        short y = cell_position.y;
 
         // Check if the cell is within the bounds of the map
-        if (x >= 0 && y >= 0 && x < MAP_WIDTH && y < MAP_HEIGHT) {
-            // If we're not collecting pellets, check for collisions with walls or doors
-            if (!i_collect_pellets) {
-                if (i_map[x][y] == Cell::Wall) {  // Collision with a wall
-                    output = true;
-                }
-                else if (!i_use_door && i_map[x][y] == Cell::Door) {  // Collision with a door
-                    output = true;
-                }
+        if (x >= 0 && y >= 0 && x < i_map.get_width() && y < i_map.get_height()) {
+            Cell cell = i_map.get_cell(x, y);
+
+            if (cell == Cell::Energizer) {  // Found an energizer
+                output = true;  // Collision with collectable
+                i_map.set_cell(x, y, Cell::Empty);  // Remove the energizer
+                update_zobrist_hash(HASH_CELL, x + i_map.get_width() * y, Cell::Energizer, Cell::Empty, i_map_hash);
             }
-            else {  // If we're collecting pellets and energizers
-                if (i_map[x][y] == Cell::Energizer) {  // Found an energizer
-                    output = true;  // Collision with collectable
-                    i_map[x][y] = Cell::Empty;  // Remove the energizer
-                }
-                else if (i_map[x][y] == Cell::Pellet) {  // Found a pellet
-                    i_map[x][y] = Cell::Empty;  // Remove the pellet
-                }
+            else if (cell == Cell::Pellet) {  // Found a pellet
+                i_map.set_cell(x, y, Cell::Empty);  // Remove the pellet
+                update_zobrist_hash(HASH_CELL, x + i_map.get_width() * y, Cell::Pellet, Cell::Empty, i_map_hash);
             }
         }
     }
@@ -0,0 +1,170 @@
+#include <algorithm> // For std::max and std::min
+#include <array>  // For std::array
+#include <cmath>  // For floor and ceil
+#include <string> // For std::string
+#include <vector> // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components
+
+#include "Headers/Global.hpp"      // Header for global constants and definitions
+#include "Headers/Map.hpp"         // Header for the Map class definition
+#include "Headers/MapRenderer.hpp" // Header for the MapRenderer class definition
+#include "Headers/Metrics.hpp"     // Header for counting the texture loads
+#include "Headers/Trace.hpp"       // Header for the trace zones
+
+// Add the quad of one cell, with the part of the texture at (i_texture_x, i_texture_y)
+static void append_cell(sf::VertexArray& i_vertices, unsigned short i_x, unsigned short i_y, unsigned short i_texture_x, unsigned short i_texture_y) {
+    float x = static_cast<float>(CELL_SIZE * i_x);
+    float y = static_cast<float>(CELL_SIZE * i_y);
+
+    float texture_x = i_texture_x;
+    float texture_y = i_texture_y;
+
+    i_vertices.append(sf::Vertex(sf::Vector2f(x, y), sf::Vector2f(texture_x, texture_y)));
+    i_vertices.append(sf::Vertex(sf::Vector2f(CELL_SIZE + x, y), sf::Vector2f(CELL_SIZE + texture_x, texture_y)));
+    i_vertices.append(sf::Vertex(sf::Vector2f(CELL_SIZE + x, CELL_SIZE + y), sf::Vector2f(CELL_SIZE + texture_x, CELL_SIZE + texture_y)));
+    i_vertices.append(sf::Vertex(sf::Vector2f(x, CELL_SIZE + y), sf::Vector2f(texture_x, CELL_SIZE + texture_y)));
+}
+
+// Constructor for the MapRenderer class (the chunks are built when we first see them)
+MapRenderer::MapRenderer() :
+    drawn_chunks(0)
+{
+}
+
+// Get how many chunks we drew in the last frame
+unsigned short MapRenderer::get_drawn_chunks() {
+    return drawn_chunks;
+}
+
+// Build the vertices of one chunk again
+// The vertex array keeps its memory, and a chunk only loses cells while playing, so this doesn't allocate after the first time
+void MapRenderer::build_chunk(unsigned short i_chunk_x, unsigned short i_chunk_y, const Map& i_map) {
+    TRACE_ZONE("MapRenderer::build_chunk");
+
+    sf::VertexArray& vertices = chunks[i_chunk_x + i_map.get_chunk_columns() * i_chunk_y];
+
+    // The last chunks of a row or a column can stick out of the map
+    unsigned short end_x = std::min<unsigned short>(i_map.get_width(), CHUNK_SIZE * (1 + i_chunk_x));
+    unsigned short end_y = std::min<unsigned short>(i_map.get_height(), CHUNK_SIZE * (1 + i_chunk_y));
+
+    vertices.clear();
+
+    // Iterate over the columns of the chunk
+    for (unsigned short a = CHUNK_SIZE * i_chunk_x; a < end_x; a++) {
+        // Iterate over the rows of the chunk
+        for (unsigned short b = CHUNK_SIZE * i_chunk_y; b < end_y; b++) {
+            // Determine which part of the texture to use based on the cell type
+            switch (i_map.get_cell(a, b)) {
+            case Cell::Door:
+                append_cell(vertices, a, b, 2 * CELL_SIZE, CELL_SIZE);
+                break;
+
+            case Cell::Energizer:
+                append_cell(vertices, a, b, CELL_SIZE, CELL_SIZE);
+                break;
+
+            case Cell::Pellet:
+                append_cell(vertices, a, b, 0, CELL_SIZE);
+                break;
+
+            case Cell::Wall: {
+                // The maps converted while compiling already know their wall tiles
+                if (i_map.get_wall_tiles() != nullptr) {
+                    append_cell(vertices, a, b, CELL_SIZE * i_map.get_wall_tiles()[a + i_map.get_width() * b], 0);
+                    break;
+                }
+
+                // Determine neighboring wall connections
+                bool down = 0, left = 0, right = 0, up = 0;
+
+                // Check if the cell below is a wall
+                if (b < i_map.get_height() - 1 && i_map.get_cell(a, b + 1) == Cell::Wall) {
+                    down = 1;
+                }
+
+                // Check if the cell to the left is a wall
+                if (a > 0 && i_map.get_cell(a - 1, b) == Cell::Wall) {
+                    left = 1;
+                }
+                else {
+                    // If there's a warp tunnel on the left edge
+                    left = (a == 0);
+                }
+
+                // Check if the cell to the right is a wall
+                if (a < i_map.get_width() - 1 && i_map.get_cell(a + 1, b) == Cell::Wall) {
+                    right = 1;
+                }
+                else {
+                    // If there's a warp tunnel on the right edge
+                    right = (a == i_map.get_width() - 1);
+                }
+
+                // Check if the cell above is a wall
+                if (b > 0 && i_map.get_cell(a, b - 1) == Cell::Wall) {
+                    up = 1;
+                }
+
+                // Use a unique index for wall connections
+                append_cell(vertices, a, b, CELL_SIZE * (down + 2 * (left + 2 * (right + 2 * up))), 0);
+                break;
+            }
+
+            default:
+                // Empty cells have nothing to draw
+                break;
+            }
+        }
+    }
+}
+
+// Draw the chunks inside the view, building the ones that changed first
+void MapRenderer::draw(const Map& i_map, sf::RenderTarget& i_target) {
+    TRACE_ZONE("MapRenderer::draw");
+
+    unsigned chunk_count = i_map.get_chunk_columns() * i_map.get_chunk_rows();
+
+    // How big a chunk is in pixels
+    float chunk_size = static_cast<float>(CELL_SIZE * CHUNK_SIZE);
+
+    const sf::View& view = i_target.getView();
+
+    // Load the map texture (only once, loading it every frame was slow and allocated memory)
+    if (texture.getSize().x == 0) {
+        texture.loadFromFile("Resources/Images/Map" + std::to_string(CELL_SIZE) + ".png");
+
+        add_metric(Metric::TextureLoadMetric);
+    }
+
+    // A map with a different size (this only allocates memory when there are more chunks than ever before)
+    if (chunks.size() != chunk_count) {
+        chunks.resize(chunk_count, sf::VertexArray(sf::Quads));
+        chunk_versions.resize(chunk_count, 0);
+    }
+
+    // The chunks the view touches
+    int first_x = std::max(0, static_cast<int>(floor((view.getCenter().x - 0.5f * view.getSize().x) / chunk_size)));
+    int first_y = std::max(0, static_cast<int>(floor((view.getCenter().y - 0.5f * view.getSize().y) / chunk_size)));
+    int last_x = std::min<int>(i_map.get_chunk_columns(), static_cast<int>(ceil((view.getCenter().x + 0.5f * view.getSize().x) / chunk_size)));
+    int last_y = std::min<int>(i_map.get_chunk_rows(), static_cast<int>(ceil((view.getCenter().y + 0.5f * view.getSize().y) / chunk_size)));
+
+    drawn_chunks = 0;
+
+    for (int a = first_y; a < last_y; a++) {
+        for (int b = first_x; b < last_x; b++) {
+            unsigned chunk = b + i_map.get_chunk_columns() * a;
+
+            unsigned long long version = i_map.get_chunk_version(static_cast<unsigned short>(b), static_cast<unsigned short>(a));
+
+            if (chunk_versions[chunk] != version) {
+                build_chunk(static_cast<unsigned short>(b), static_cast<unsigned short>(a), i_map);
+
+                chunk_versions[chunk] = version;
+            }
+
+            i_target.draw(chunks[chunk], sf::RenderStates(&texture));
+
+            drawn_chunks++;
+        }
+    }
+}
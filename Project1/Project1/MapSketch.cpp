@@ -0,0 +1,14 @@
+#include <iterator> // For std::begin and std::end
+#include <string> // For std::string
+#include <vector> // For std::vector
+
+#include "Headers/Global.hpp"    // Header for global constants and definitions
+#include "Headers/MapSketch.hpp" // Header for the default map sketch
+
+// Get the default map, represented as a sketch (a grid of characters)
+const std::vector<std::string>& get_map_sketch() {
+    // The map every game starts with
+    static const std::vector<std::string> map_sketch(std::begin(MAP_SKETCH), std::end(MAP_SKETCH));
+
+    return map_sketch;
+}
@@ -0,0 +1,345 @@
+#include <algorithm> // For std::max, std::min and std::swap
+#include <array>     // For std::array
+#include <fstream>   // For reading and writing maze files
+#include <string>    // For std::string
+#include <vector>    // For std::vector
+
+#include "Headers/Global.hpp"        // Header for global constants and definitions
+#include "Headers/MazeGenerator.hpp" // Header for the maze generator
+#include "Headers/Random.hpp"        // Header for the deterministic random number generator
+
+// Can Pacman (or a ghost, if it can use the door) stand on this character?
+static bool is_open(char i_cell, bool i_use_door) {
+    return i_cell != '#' && (i_use_door || i_cell != '=');
+}
+
+// Find every cell we can reach from one cell, going through the sides of the map like Pacman::update and Ghost::update do
+// If we can walk off the top or the bottom of the map, i_escaped is set
+static std::vector<bool> flood(const std::vector<std::string>& i_maze, short i_x, short i_y, bool i_use_door, bool& i_escaped) {
+    short height = static_cast<short>(i_maze.size());
+    short width = static_cast<short>(i_maze[0].size());
+
+    std::vector<bool> output(width * height, 0);
+
+    std::vector<Position> stack = { { i_x, i_y } };
+
+    output[i_x + width * i_y] = 1;
+
+    i_escaped = 0;
+
+    while (!stack.empty()) {
+        Position cell = stack.back();
+
+        stack.pop_back();
+
+        if (cell.y == 0 || cell.y == height - 1) {
+            i_escaped = 1;
+        }
+
+        for (unsigned char a = 0; a < 4; a++) {
+            short x = cell.x;
+            short y = cell.y;
+
+            switch (a) {
+            case 0: x++; break;  // Right
+            case 1: y--; break;  // Up
+            case 2: x--; break;  // Left
+            case 3: y++; break;  // Down
+            }
+
+            // The tunnels
+            x = (x + width) % width;
+
+            if (y < 0 || y >= height || output[x + width * y] || !is_open(i_maze[y][x], i_use_door)) {
+                continue;
+            }
+
+            output[x + width * y] = 1;
+
+            stack.push_back({ x, y });
+        }
+    }
+
+    return output;
+}
+
+// Generate a maze: a random maze of 1 cell wide corridors, with the ghost house in the middle
+std::vector<std::string> generate_maze(const MazeSettings& i_settings, unsigned i_seed) {
+    unsigned short height = std::min<unsigned short>((MAX_MAZE_SIZE - 1) | 1, std::max<unsigned short>(11, i_settings.height | 1));
+    unsigned short width = std::min<unsigned short>((MAX_MAZE_SIZE - 1) | 1, std::max<unsigned short>(11, i_settings.width | 1));
+
+    short center_x = width / 2;
+    short center_y = height / 2;
+    // In a symmetric maze, we only make the left half and mirror it
+    short last_x = i_settings.symmetric ? center_x : width - 2;
+
+    unsigned random_state = seed_random(i_seed, 0);
+
+    // The corridors are on the cells with odd coordinates (we call them rooms), and we remove the walls between them
+    std::vector<std::string> output(height, std::string(width, '#'));
+
+    std::vector<bool> visited(width * height, 0);
+
+    // The rooms we can use (not the ones where the ghost house goes)
+    auto is_room = [&](short i_x, short i_y) {
+        return i_x % 2 == 1 && i_y % 2 == 1 &&
+            1 <= i_x && i_x <= last_x && 1 <= i_y && i_y <= height - 2 &&
+            !(center_x - 2 <= i_x && i_x <= center_x + 2 && center_y - 1 <= i_y && i_y <= center_y + 1);
+    };
+
+    // Depth-first search from the top left room, removing the wall every time we go to a new room
+    std::vector<Position> stack = { { 1, 1 } };
+
+    output[1][1] = '.';
+    visited[1 + width] = 1;
+
+    while (!stack.empty()) {
+        Position cell = stack.back();
+
+        std::array<Position, 4> neighbors;
+
+        unsigned char neighbor_count = 0;
+
+        for (unsigned char a = 0; a < 4; a++) {
+            Position neighbor = cell;
+
+            switch (a) {
+            case 0: neighbor.x += 2; break;  // Right
+            case 1: neighbor.y -= 2; break;  // Up
+            case 2: neighbor.x -= 2; break;  // Left
+            case 3: neighbor.y += 2; break;  // Down
+            }
+
+            if (is_room(neighbor.x, neighbor.y) && !visited[neighbor.x + width * neighbor.y]) {
+                neighbors[neighbor_count] = neighbor;
+                neighbor_count++;
+            }
+        }
+
+        if (neighbor_count == 0) {
+            stack.pop_back();
+
+            continue;
+        }
+
+        Position neighbor = neighbors[get_random(random_state) % neighbor_count];
+
+        output[(cell.y + neighbor.y) / 2][(cell.x + neighbor.x) / 2] = '.';
+        output[neighbor.y][neighbor.x] = '.';
+        visited[neighbor.x + width * neighbor.y] = 1;
+
+        stack.push_back(neighbor);
+    }
+
+    // Remove some of the other walls between rooms, so there are loops to run around in
+    for (short a = 1; a < height - 1; a++) {
+        for (short b = 1; b <= last_x; b++) {
+            if (output[a][b] != '#' || get_random(random_state) % 100 < i_settings.density) {
+                continue;
+            }
+
+            if ((a % 2 == 1 && is_room(b - 1, a) && is_room(1 + b, a)) || (b % 2 == 1 && is_room(b, a - 1) && is_room(b, 1 + a))) {
+                output[a][b] = '.';
+            }
+        }
+    }
+
+    if (i_settings.symmetric) {
+        for (std::string& row : output) {
+            for (short a = 1 + center_x; a < width; a++) {
+                row[a] = row[width - 1 - a];
+            }
+        }
+    }
+
+    // The tunnels go from the first room of a row to the last one
+    for (unsigned char a = 0, attempts = 0; a < i_settings.tunnels && attempts < 64; attempts++) {
+        short y = 1 + 2 * static_cast<short>(get_random(random_state) % ((height - 1) / 2));
+
+        if (output[y][0] != '#' || (center_y - 2 <= y && y <= center_y + 2)) {
+            continue;
+        }
+
+        output[y][0] = '.';
+        output[y][width - 1] = '.';
+
+        a++;
+    }
+
+    // An empty corridor around the ghost house
+    for (short a = center_y - 2; a <= center_y + 2; a++) {
+        for (short b = center_x - 3; b <= center_x + 3; b++) {
+            output[a][b] = (center_y - 1 <= a && a <= center_y + 1 && center_x - 2 <= b && b <= center_x + 2) ? '#' : ' ';
+        }
+    }
+
+    // The ghost house (like the original one)
+    output[center_y - 2][center_x] = '0';
+    output[center_y - 1][center_x] = '=';
+    output[center_y][center_x - 1] = '1';
+    output[center_y][center_x] = '2';
+    output[center_y][1 + center_x] = '3';
+    output[center_y + 2][center_x] = 'P';
+
+    // The energizers go on random pellets (in pairs, if the maze is symmetric)
+    for (unsigned char a = 0, attempts = 0; a < i_settings.energizers && attempts < 255; attempts++) {
+        short x = 1 + static_cast<short>(get_random(random_state) % (width - 2));
+        short y = 1 + static_cast<short>(get_random(random_state) % (height - 2));
+
+        if (output[y][x] != '.') {
+            continue;
+        }
+
+        output[y][x] = 'o';
+        a++;
+
+        if (i_settings.symmetric && output[y][width - 1 - x] == '.') {
+            output[y][width - 1 - x] = 'o';
+            a++;
+        }
+    }
+
+    return output;
+}
+
+// Check that the game can be played on a maze
+const char* validate_maze(const std::vector<std::string>& i_maze) {
+    bool escaped = 0;
+
+    // Pacman, and then the 4 ghosts
+    std::array<unsigned short, 5> counts{};
+    std::array<Position, 5> positions{};
+
+    if (i_maze.empty() || i_maze[0].empty()) {
+        return "The maze is empty.";
+    }
+
+    // Bigger ones don't fit in the positions (and the casts to short below would go negative)
+    if (MAX_MAZE_SIZE < i_maze.size() || MAX_MAZE_SIZE < i_maze[0].size()) {
+        return "The maze is bigger than MAX_MAZE_SIZE cells on a side.";
+    }
+
+    for (short a = 0; a < static_cast<short>(i_maze.size()); a++) {
+        if (i_maze[a].size() != i_maze[0].size()) {
+            return "The rows don't have the same length.";
+        }
+
+        for (short b = 0; b < static_cast<short>(i_maze[a].size()); b++) {
+            unsigned char index = 5;
+
+            switch (i_maze[a][b]) {
+            case ' ': case '#': case '.': case '=': case 'o': break;
+            case 'P': index = 0; break;
+            case '0': case '1': case '2': case '3': index = 1 + i_maze[a][b] - '0'; break;
+            default: return "There's a character convert_sketch doesn't know.";
+            }
+
+            if (index < 5) {
+                counts[index]++;
+                positions[index] = { b, a };
+            }
+        }
+
+        // Whatever goes out on one side comes back on the other side
+        if (is_open(i_maze[a][0], 0) != is_open(i_maze[a].back(), 0)) {
+            return "A tunnel doesn't come out on the other side.";
+        }
+    }
+
+    for (unsigned short count : counts) {
+        if (count != 1) {
+            return "Pacman and every ghost must be in the maze exactly once.";
+        }
+    }
+
+    std::vector<bool> pacman_cells = flood(i_maze, positions[0].x, positions[0].y, 0, escaped);
+
+    if (escaped) {
+        return "Pacman can walk off the top or the bottom of the maze.";
+    }
+
+    bool pellets = 0;
+
+    for (short a = 0; a < static_cast<short>(i_maze.size()); a++) {
+        for (short b = 0; b < static_cast<short>(i_maze[a].size()); b++) {
+            if (i_maze[a][b] == '.' || i_maze[a][b] == 'o') {
+                pellets = 1;
+
+                if (!pacman_cells[b + i_maze[0].size() * a]) {
+                    return "Pacman can't reach every pellet.";
+                }
+            }
+        }
+    }
+
+    if (!pellets) {
+        return "There are no pellets.";
+    }
+
+    // The red ghost's position is where the ghosts leave the house (see GhostManager::reset)
+    if (!pacman_cells[positions[1].x + i_maze[0].size() * positions[1].y]) {
+        return "Pacman can't reach the ghost house exit.";
+    }
+
+    // The other ghosts start in the house, and only get out through the door
+    for (unsigned char a = 2; a < 5; a++) {
+        std::vector<bool> ghost_cells = flood(i_maze, positions[a].x, positions[a].y, 1, escaped);
+
+        if (escaped || !ghost_cells[positions[1].x + i_maze[0].size() * positions[1].y]) {
+            return "A ghost can't get out of the ghost house.";
+        }
+    }
+
+    return nullptr;
+}
+
+// Read every maze in a file
+bool load_mazes(const std::string& i_file_name, std::vector<std::vector<std::string>>& i_mazes) {
+    std::ifstream file(i_file_name);
+
+    std::string line;
+
+    std::vector<std::string> maze;
+
+    if (!file) {
+        return 0;
+    }
+
+    while (std::getline(file, line)) {
+        // Files saved on Windows
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (line.empty()) {
+            if (!maze.empty()) {
+                i_mazes.push_back(maze);
+                maze.clear();
+            }
+        }
+        else {
+            maze.push_back(line);
+        }
+    }
+
+    if (!maze.empty()) {
+        i_mazes.push_back(maze);
+    }
+
+    return 1;
+}
+
+// Write mazes to a file, so other programs can play them
+bool save_mazes(const std::string& i_file_name, const std::vector<std::vector<std::string>>& i_mazes) {
+    std::ofstream file(i_file_name);
+
+    for (const std::vector<std::string>& maze : i_mazes) {
+        for (const std::string& row : maze) {
+            file << row << '\n';
+        }
+
+        file << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
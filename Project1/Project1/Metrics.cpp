@@ -0,0 +1,221 @@
+#include <algorithm> // For std::max and std::lower_bound
+#include <array>  // For std::array
+#include <atomic> // For the counters
+#include <cstdio> // For formatting the numbers
+#include <memory> // For std::unique_ptr
+#include <mutex>  // For the list of blocks
+#include <string> // For std::string
+#include <vector> // For std::vector
+
+#include "Headers/AllocationCounter.hpp" // Header for counting the heap allocations
+#include "Headers/Metrics.hpp"           // Header for the metrics
+
+// The upper bounds of the histogram buckets in microseconds (a tick takes tens, a frame about 16667). The last bucket has everything slower.
+constexpr std::array<unsigned, 20> METRIC_BUCKETS = { 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 8000, 12000, 16000, 17000, 20000, 25000, 33000, 50000, 100000, 250000, 1000000 };
+
+// The names and the descriptions, in the order of the enums
+constexpr std::array<const char*, METRIC_COUNT> METRIC_NAMES = { "pakku_draw_calls_total", "pakku_games_completed_total", "pakku_levels_won_total", "pakku_texture_loads_total", "pakku_ticks_total", "pakku_tick_overruns_total" };
+constexpr std::array<const char*, METRIC_COUNT> METRIC_DESCRIPTIONS = {
+    "Draw calls of the map and the sprites.",
+    "Games that ended with Pacman dying.",
+    "Levels Pacman cleared.",
+    "Textures loaded from the disk.",
+    "Ticks simulated (without the ones the versus mode simulates again).",
+    "Ticks slower than the tick budget, or skipped by a server shard."
+};
+
+constexpr std::array<const char*, METRIC_HISTOGRAM_COUNT> METRIC_HISTOGRAM_NAMES = { "pakku_frame_time_microseconds", "pakku_tick_time_microseconds" };
+constexpr std::array<const char*, METRIC_HISTOGRAM_COUNT> METRIC_HISTOGRAM_DESCRIPTIONS = { "Time between two frames on the screen.", "Time a tick took to simulate." };
+
+// The percentiles we work out from the histograms
+constexpr std::array<unsigned char, 3> METRIC_PERCENTILES = { 50, 90, 99 };
+
+// The metrics of one thread. Only that thread writes them, so there are no locks.
+struct MetricBlock
+{
+    // 1 + the level, so 0 means the thread never played
+    std::atomic<unsigned short> level;
+
+    std::array<std::atomic<unsigned long long>, METRIC_COUNT> counters;
+    std::array<std::atomic<unsigned long long>, 256> deaths;
+
+    std::array<std::array<std::atomic<unsigned long long>, 1 + METRIC_BUCKETS.size()>, METRIC_HISTOGRAM_COUNT> buckets;
+    std::array<std::atomic<unsigned long long>, METRIC_HISTOGRAM_COUNT> sums;
+};
+
+// Every block ever made. They're never deleted, so the counts of threads that ended are still there.
+static std::mutex metric_mutex;
+
+static std::vector<std::unique_ptr<MetricBlock>> metric_blocks;
+
+// Get the block of the current thread (its first metric makes it)
+static MetricBlock& get_metric_block() {
+    thread_local MetricBlock* block = nullptr;
+
+    if (block == nullptr) {
+        std::lock_guard<std::mutex> lock(metric_mutex);
+
+        // The () zeroes the atomics
+        metric_blocks.emplace_back(new MetricBlock());
+
+        block = metric_blocks.back().get();
+    }
+
+    return *block;
+}
+
+// Only the owner writes, so a load and a store are enough (and they don't lock the cache line like fetch_add)
+static void add_to_counter(std::atomic<unsigned long long>& i_counter, unsigned long long i_value) {
+    i_counter.store(i_value + i_counter.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void add_metric(Metric i_metric, unsigned long long i_value) {
+    add_to_counter(get_metric_block().counters[i_metric], i_value);
+}
+
+void add_metric_sample(MetricHistogram i_histogram, unsigned i_microseconds) {
+    MetricBlock& block = get_metric_block();
+
+    std::size_t bucket = std::lower_bound(METRIC_BUCKETS.begin(), METRIC_BUCKETS.end(), i_microseconds) - METRIC_BUCKETS.begin();
+
+    add_to_counter(block.buckets[i_histogram][bucket], 1);
+    add_to_counter(block.sums[i_histogram], i_microseconds);
+}
+
+void add_death_metric(unsigned char i_level) {
+    MetricBlock& block = get_metric_block();
+
+    add_to_counter(block.deaths[i_level], 1);
+    add_to_counter(block.counters[Metric::GameCompletedMetric], 1);
+}
+
+void set_level_metric(unsigned char i_level) {
+    get_metric_block().level.store(1 + i_level, std::memory_order_relaxed);
+}
+
+// Add a line to the text
+static void add_metric_line(std::string& i_text, const char* i_format, const char* i_name, const char* i_labels, unsigned long long i_value) {
+    char line[256];
+
+    std::snprintf(line, sizeof(line), i_format, i_name, i_labels, i_value);
+
+    i_text += line;
+}
+
+// Add the description and the type of a metric
+static void add_metric_header(std::string& i_text, const char* i_name, const char* i_description, const char* i_type) {
+    i_text = i_text + "# HELP " + i_name + ' ' + i_description + "\n# TYPE " + i_name + ' ' + i_type + '\n';
+}
+
+std::string format_metrics() {
+    unsigned short level = 0;
+
+    std::array<unsigned long long, METRIC_COUNT> counters{};
+    std::array<unsigned long long, 256> deaths{};
+    std::array<unsigned long long, METRIC_HISTOGRAM_COUNT> sums{};
+
+    std::array<std::array<unsigned long long, 1 + METRIC_BUCKETS.size()>, METRIC_HISTOGRAM_COUNT> buckets{};
+
+    {
+        std::lock_guard<std::mutex> lock(metric_mutex);
+
+        for (std::unique_ptr<MetricBlock>& block : metric_blocks) {
+            level = std::max(level, block->level.load(std::memory_order_relaxed));
+
+            for (unsigned char a = 0; a < METRIC_COUNT; a++) {
+                counters[a] += block->counters[a].load(std::memory_order_relaxed);
+            }
+
+            for (unsigned short a = 0; a < deaths.size(); a++) {
+                deaths[a] += block->deaths[a].load(std::memory_order_relaxed);
+            }
+
+            for (unsigned char a = 0; a < METRIC_HISTOGRAM_COUNT; a++) {
+                sums[a] += block->sums[a].load(std::memory_order_relaxed);
+
+                for (unsigned char b = 0; b < buckets[a].size(); b++) {
+                    buckets[a][b] += block->buckets[a][b].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    char labels[64];
+
+    std::string output;
+
+    for (unsigned char a = 0; a < METRIC_COUNT; a++) {
+        add_metric_header(output, METRIC_NAMES[a], METRIC_DESCRIPTIONS[a], "counter");
+        add_metric_line(output, "%s%s %llu\n", METRIC_NAMES[a], "", counters[a]);
+    }
+
+    add_metric_header(output, "pakku_allocations_total", "Calls to operator new (from every thread).", "counter");
+    add_metric_line(output, "%s%s %llu\n", "pakku_allocations_total", "", get_allocation_count());
+
+    // Only the levels someone died on
+    add_metric_header(output, "pakku_deaths_total", "Deaths of Pacman on every level.", "counter");
+
+    for (unsigned short a = 0; a < deaths.size(); a++) {
+        if (deaths[a] != 0) {
+            std::snprintf(labels, sizeof(labels), "{level=\"%u\"}", 1 + a);
+
+            add_metric_line(output, "%s%s %llu\n", "pakku_deaths_total", labels, deaths[a]);
+        }
+    }
+
+    add_metric_header(output, "pakku_level", "The level being played (0 before the first tick).", "gauge");
+    add_metric_line(output, "%s%s %llu\n", "pakku_level", "", level);
+
+    for (unsigned char a = 0; a < METRIC_HISTOGRAM_COUNT; a++) {
+        std::string bucket_name = std::string(METRIC_HISTOGRAM_NAMES[a]) + "_bucket";
+        std::string percentile_name = std::string(METRIC_HISTOGRAM_NAMES[a]) + "_percentile";
+
+        // The buckets in the file count everything up to their bound
+        std::array<unsigned long long, 1 + METRIC_BUCKETS.size()> cumulative_buckets{};
+
+        for (unsigned char b = 0; b < cumulative_buckets.size(); b++) {
+            cumulative_buckets[b] = buckets[a][b] + (b == 0 ? 0 : cumulative_buckets[b - 1]);
+        }
+
+        add_metric_header(output, METRIC_HISTOGRAM_NAMES[a], METRIC_HISTOGRAM_DESCRIPTIONS[a], "histogram");
+
+        for (unsigned char b = 0; b < cumulative_buckets.size(); b++) {
+            if (b < METRIC_BUCKETS.size()) {
+                std::snprintf(labels, sizeof(labels), "{le=\"%u\"}", METRIC_BUCKETS[b]);
+            }
+            else {
+                std::snprintf(labels, sizeof(labels), "{le=\"+Inf\"}");
+            }
+
+            add_metric_line(output, "%s%s %llu\n", bucket_name.c_str(), labels, cumulative_buckets[b]);
+        }
+
+        add_metric_line(output, "%s_sum%s %llu\n", METRIC_HISTOGRAM_NAMES[a], "", sums[a]);
+        add_metric_line(output, "%s_count%s %llu\n", METRIC_HISTOGRAM_NAMES[a], "", cumulative_buckets.back());
+
+        // The bound of the bucket the percentile falls in, for dashboards that can't do histogram_quantile
+        add_metric_header(output, percentile_name.c_str(), "The upper bound of the bucket the percentile is in, since the start.", "gauge");
+
+        for (unsigned char percentile : METRIC_PERCENTILES) {
+            unsigned char bucket = 0;
+
+            while (bucket < METRIC_BUCKETS.size() && 100 * cumulative_buckets[bucket] < percentile * cumulative_buckets.back()) {
+                bucket++;
+            }
+
+            std::snprintf(labels, sizeof(labels), "{percentile=\"%u\"}", percentile);
+
+            if (cumulative_buckets.back() == 0) {
+                output = output + percentile_name + labels + " NaN\n";
+            }
+            else if (bucket < METRIC_BUCKETS.size()) {
+                add_metric_line(output, "%s%s %llu\n", percentile_name.c_str(), labels, METRIC_BUCKETS[bucket]);
+            }
+            else {
+                output = output + percentile_name + labels + " +Inf\n";
+            }
+        }
+    }
+
+    return output;
+}
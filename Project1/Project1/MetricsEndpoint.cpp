@@ -0,0 +1,244 @@
+#include <atomic>  // For stopping the thread
+#include <cstring> // For std::strstr
+#include <string>  // For std::string
+#include <thread>  // For the endpoint thread
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h> // For the sockets
+#include <ws2tcpip.h> // For inet_pton
+
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+#else
+#include <arpa/inet.h>  // For inet_pton
+#include <netinet/in.h> // For sockaddr_in
+#include <poll.h>       // For poll
+#include <sys/socket.h> // For the sockets
+#include <sys/stat.h>   // For lstat
+#include <sys/un.h>     // For sockaddr_un
+#include <unistd.h>     // For close and unlink
+#endif
+
+#include "Headers/Metrics.hpp"         // Header for the metrics
+#include "Headers/MetricsEndpoint.hpp" // Header for the MetricsEndpoint class definition
+
+#ifdef _WIN32
+typedef SOCKET MetricSocket;
+
+constexpr MetricSocket NO_METRIC_SOCKET = INVALID_SOCKET;
+
+constexpr int SEND_FLAGS = 0;
+
+static void close_metric_socket(MetricSocket i_socket) {
+    closesocket(i_socket);
+}
+
+static int poll_metric_socket(pollfd* i_sockets, unsigned long i_count, int i_milliseconds) {
+    return WSAPoll(i_sockets, i_count, i_milliseconds);
+}
+#else
+typedef int MetricSocket;
+
+constexpr MetricSocket NO_METRIC_SOCKET = -1;
+
+// A scraper that hangs up early shouldn't kill the game with SIGPIPE
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+
+static void close_metric_socket(MetricSocket i_socket) {
+    close(i_socket);
+}
+
+static int poll_metric_socket(pollfd* i_sockets, nfds_t i_count, int i_milliseconds) {
+    return poll(i_sockets, i_count, i_milliseconds);
+}
+#endif
+
+// While the endpoint waits for a connection or a request, it checks if it should stop this often (in milliseconds)
+constexpr unsigned short ENDPOINT_POLL = 100;
+// The longest request we read (we only need to know that it ended)
+constexpr unsigned short MAX_REQUEST_SIZE = 4096;
+
+// Send all of it (the socket may take it in parts)
+static void send_metric_text(MetricSocket i_socket, const std::string& i_text) {
+    std::size_t sent = 0;
+
+    while (sent < i_text.size()) {
+        int result = send(i_socket, i_text.data() + sent, static_cast<int>(i_text.size() - sent), SEND_FLAGS);
+
+        if (result <= 0) {
+            return;
+        }
+
+        sent += result;
+    }
+}
+
+// Wait until the socket has something to read, at most i_milliseconds
+// (poll and not select: a process with many files open can get a socket past FD_SETSIZE, which an fd_set can't hold)
+static bool wait_for_metric_socket(MetricSocket i_socket, unsigned short i_milliseconds) {
+    pollfd socket = {};
+    socket.fd = i_socket;
+    socket.events = POLLIN;
+
+    return poll_metric_socket(&socket, 1, i_milliseconds) > 0;
+}
+
+MetricsEndpoint::MetricsEndpoint() :
+    running(0),
+    listener(-1)
+{
+}
+
+MetricsEndpoint::~MetricsEndpoint() {
+    if (thread.joinable()) {
+        running = 0;
+
+        thread.join();
+    }
+
+    if (listener != -1) {
+        close_metric_socket(static_cast<MetricSocket>(listener));
+    }
+
+#ifndef _WIN32
+    if (!socket_path.empty()) {
+        unlink(socket_path.c_str());
+    }
+#endif
+}
+
+// Answer every connection until we're destroyed
+void MetricsEndpoint::serve(bool i_http) {
+    char request[MAX_REQUEST_SIZE];
+
+    while (running) {
+        if (!wait_for_metric_socket(static_cast<MetricSocket>(listener), ENDPOINT_POLL)) {
+            continue;
+        }
+
+        MetricSocket client = accept(static_cast<MetricSocket>(listener), nullptr, nullptr);
+
+        if (client == NO_METRIC_SOCKET) {
+            continue;
+        }
+
+        if (i_http) {
+            // Read until the end of the headers (a request without a body), but don't let a slow client keep us
+            std::size_t request_size = 0;
+
+            while (request_size < MAX_REQUEST_SIZE - 1 && wait_for_metric_socket(client, 1000)) {
+                int result = recv(client, request + request_size, static_cast<int>(MAX_REQUEST_SIZE - 1 - request_size), 0);
+
+                if (result <= 0) {
+                    break;
+                }
+
+                request_size += result;
+                request[request_size] = 0;
+
+                if (std::strstr(request, "\r\n\r\n") != nullptr) {
+                    std::string body = format_metrics();
+
+                    send_metric_text(client, "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+
+                    break;
+                }
+            }
+        }
+        else {
+            send_metric_text(client, format_metrics());
+        }
+
+        close_metric_socket(client);
+    }
+}
+
+bool MetricsEndpoint::start_http(unsigned short i_port) {
+    if (listener != -1) {
+        return 0;
+    }
+
+#ifdef _WIN32
+    WSADATA data;
+
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        return 0;
+    }
+#endif
+
+    MetricSocket new_listener = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (new_listener == NO_METRIC_SOCKET) {
+        return 0;
+    }
+
+    int enable = 1;
+
+    setsockopt(new_listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&enable), sizeof(enable));
+
+    // Only this computer can read them
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(i_port);
+
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    if (bind(new_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(new_listener, 16) != 0) {
+        close_metric_socket(new_listener);
+
+        return 0;
+    }
+
+    listener = static_cast<long long>(new_listener);
+    running = 1;
+    thread = std::thread(&MetricsEndpoint::serve, this, 1);
+
+    return 1;
+}
+
+bool MetricsEndpoint::start_unix(const std::string& i_path) {
+#ifdef _WIN32
+    (void)i_path;
+
+    return 0;
+#else
+    sockaddr_un address = {};
+
+    if (listener != -1 || sizeof(address.sun_path) <= i_path.size()) {
+        return 0;
+    }
+
+    MetricSocket new_listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (new_listener == NO_METRIC_SOCKET) {
+        return 0;
+    }
+
+    address.sun_family = AF_UNIX;
+
+    i_path.copy(address.sun_path, i_path.size());
+
+    // A socket left behind by a game that crashed (only a socket: a wrong --metrics path mustn't delete a file)
+    struct stat status;
+
+    if (lstat(i_path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+        unlink(i_path.c_str());
+    }
+
+    if (bind(new_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(new_listener, 16) != 0) {
+        close_metric_socket(new_listener);
+
+        return 0;
+    }
+
+    listener = new_listener;
+    socket_path = i_path;
+    running = 1;
+    thread = std::thread(&MetricsEndpoint::serve, this, 0);
+
+    return 1;
+#endif
+}
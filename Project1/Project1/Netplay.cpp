@@ -0,0 +1,429 @@
+#include <algorithm> // For std::max and std::min
+#include <array>     // For std::array
+#include <chrono>    // For the fake latency and the statistics
+#include <climits>   // For UINT_MAX
+#include <string>    // For std::string
+#include <thread>    // For sleeping while we wait for the other player
+#include <vector>    // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components
+#include <SFML/Network.hpp>  // For the UDP socket
+
+#include "Headers/Global.hpp"       // Header for global constants and definitions
+#include "Headers/Map.hpp"          // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "Headers/Pacman.hpp"       // Header for Pac-Man class definition
+#include "Headers/Ghost.hpp"        // Header for Ghost class definition
+#include "Headers/GhostManager.hpp" // Header for GhostManager class definition
+#include "Headers/MapRenderer.hpp"  // Header for drawing the game map
+#include "Headers/Game.hpp"         // Header for the Game class definition
+#include "Headers/Random.hpp"       // Header for the deterministic random number generator
+#include "Headers/Netplay.hpp"      // Header for the Netplay class definition
+
+// The first byte of every packet tells us what's inside
+// "Can I play?"
+constexpr unsigned char PACKET_HELLO = 0;
+// "Yes, and here's the seed." (4 bytes)
+constexpr unsigned char PACKET_WELCOME = 1;
+// The first frame (4 bytes), the ack (4 bytes), the frame before which our inputs and the other player's are confirmed (4 bytes),
+// the hash of our game after the frame before it (8 bytes), the number of inputs (1 byte) and the inputs (1 byte each)
+constexpr unsigned char PACKET_INPUTS = 2;
+
+// The bytes before the inputs in PACKET_INPUTS
+constexpr unsigned char INPUTS_HEADER_SIZE = 22;
+
+// The IP header and the UDP header, so the bandwidth isn't a lie
+constexpr unsigned char UDP_HEADER_SIZE = 28;
+
+// How long the joining player waits for the host, in milliseconds
+constexpr unsigned short JOIN_TIMEOUT = 10000;
+// How often the joining player says hello, in milliseconds
+constexpr unsigned short HELLO_INTERVAL = 100;
+
+// Write a 32-bit number (little-endian)
+static void write_u32(unsigned i_value, unsigned char* i_data) {
+    for (unsigned char a = 0; a < 4; a++) {
+        i_data[a] = static_cast<unsigned char>(i_value >> (8 * a));
+    }
+}
+
+// Read a 32-bit number (little-endian)
+static unsigned read_u32(const unsigned char* i_data) {
+    return i_data[0] | (i_data[1] << 8) | (i_data[2] << 16) | (static_cast<unsigned>(i_data[3]) << 24);
+}
+
+// Write a 64-bit number (little-endian)
+static void write_u64(unsigned long long i_value, unsigned char* i_data) {
+    write_u32(static_cast<unsigned>(i_value), i_data);
+    write_u32(static_cast<unsigned>(i_value >> 32), i_data + 4);
+}
+
+// Read a 64-bit number (little-endian)
+static unsigned long long read_u64(const unsigned char* i_data) {
+    return read_u32(i_data) | (static_cast<unsigned long long>(read_u32(i_data + 4)) << 32);
+}
+
+// Constructor for the Netplay class with the fake connection problems
+Netplay::Netplay(unsigned short i_latency, unsigned char i_loss) :
+    connected(0),
+    player(0),
+    loss(i_loss),
+    latency(i_latency),
+    remote_port(0),
+    confirmed_frame(0),
+    desync_frame(UINT_MAX),
+    frame(0),
+    seed(0),
+    random_state(seed_random(static_cast<unsigned>(std::chrono::steady_clock::now().time_since_epoch().count()), 0)),
+    remote_ack(0),
+    remote_frame(0),
+    remote_hash_frame(0),
+    rollback_frame(0),
+    total_rollback_depth(0),
+    delayed_packet_count(0),
+    first_delayed_packet(0),
+    remote_hash(0),
+    local_inputs({}),
+    remote_inputs({}),
+    hashes({}),
+    statistics_time(std::chrono::steady_clock::now()),
+    delayed_packets(MAX_DELAYED_PACKETS),
+    current_statistics({}),
+    statistics({})
+{
+    // No frame was received yet (frame 0 would look received if we used 0)
+    remote_input_frames.fill(UINT_MAX);
+}
+
+// Get the other player's input, or guess it if it didn't arrive yet
+unsigned char Netplay::get_remote_input(unsigned i_frame) {
+    if (remote_input_frames[i_frame % 256] != i_frame) {
+        // We guess they're still pressing what they pressed last time
+        remote_inputs[i_frame % 256] = (remote_frame == 0) ? 0 : remote_inputs[(remote_frame - 1) % 256];
+    }
+
+    return remote_inputs[i_frame % 256];
+}
+
+// Compare our hash with the other player's, once we both know every input before their frame
+// (After the rollback, so our hashes aren't based on wrong guesses.)
+void Netplay::check_hash() {
+    if (desync_frame == UINT_MAX && remote_hash_frame > 0 && remote_hash_frame <= get_confirmed_frame() && frame < 256 + remote_hash_frame) {
+        if (hashes[(remote_hash_frame - 1) % 256] != remote_hash) {
+            desync_frame = remote_hash_frame - 1;
+        }
+    }
+}
+
+// Send the packets whose fake latency has passed
+void Netplay::flush() {
+    std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+    // The latency is the same for every packet, so they leave in order
+    while (delayed_packet_count > 0 && delayed_packets[first_delayed_packet].send_time <= now) {
+        DelayedPacket& packet = delayed_packets[first_delayed_packet];
+
+        socket.send(packet.data.data(), packet.size, remote_address, remote_port);
+
+        first_delayed_packet = (1 + first_delayed_packet) % MAX_DELAYED_PACKETS;
+        delayed_packet_count--;
+    }
+}
+
+// Read every packet that arrived
+void Netplay::receive() {
+    unsigned char buffer[512];
+
+    unsigned short port;
+
+    std::size_t size;
+
+    sf::IpAddress address;
+
+    while (socket.receive(buffer, sizeof(buffer), size, address, port) == sf::Socket::Done) {
+        // Ignore empty packets and strangers
+        if (size == 0 || (connected && (address != remote_address || port != remote_port))) {
+            continue;
+        }
+
+        current_statistics.received_bytes += static_cast<unsigned>(size) + UDP_HEADER_SIZE;
+
+        switch (buffer[0]) {
+        case PACKET_HELLO:
+            if (player == 0) {
+                if (!connected) {
+                    // Somebody wants to play with us!
+                    connected = 1;
+
+                    remote_address = address;
+                    remote_port = port;
+                }
+
+                // We answer every hello, in case our welcome got lost
+                unsigned char welcome[5] = { PACKET_WELCOME };
+                write_u32(seed, welcome + 1);
+
+                send(welcome, sizeof(welcome));
+            }
+            break;
+
+        case PACKET_WELCOME:
+            if (player == 1 && !connected && size >= 5) {
+                connected = 1;
+
+                seed = read_u32(buffer + 1);
+            }
+            break;
+
+        case PACKET_INPUTS:
+            if (connected && size >= INPUTS_HEADER_SIZE && size >= INPUTS_HEADER_SIZE + static_cast<unsigned>(buffer[INPUTS_HEADER_SIZE - 1])) {
+                unsigned first_frame = read_u32(buffer + 1);
+
+                remote_ack = std::max(remote_ack, read_u32(buffer + 5));
+
+                // Keep the newest hash, the older ones were probably checked already
+                if (remote_hash_frame < read_u32(buffer + 9)) {
+                    remote_hash_frame = read_u32(buffer + 9);
+                    remote_hash = read_u64(buffer + 13);
+                }
+
+                for (unsigned char a = 0; a < buffer[INPUTS_HEADER_SIZE - 1]; a++) {
+                    unsigned input_frame = first_frame + a;
+
+                    // Skip the inputs we already have (they're sent again until we ack them) and the ones that don't fit in the ring
+                    if (input_frame < confirmed_frame || input_frame >= confirmed_frame + 256 || remote_input_frames[input_frame % 256] == input_frame) {
+                        continue;
+                    }
+
+                    // If we already simulated this frame with a wrong guess, we have to go back
+                    if (input_frame < frame && remote_inputs[input_frame % 256] != buffer[INPUTS_HEADER_SIZE + a]) {
+                        rollback_frame = std::min(rollback_frame, input_frame);
+                    }
+
+                    remote_inputs[input_frame % 256] = buffer[INPUTS_HEADER_SIZE + a];
+                    remote_input_frames[input_frame % 256] = input_frame;
+
+                    remote_frame = std::max(remote_frame, 1 + input_frame);
+                }
+
+                // Every input before the first hole is confirmed
+                while (remote_input_frames[confirmed_frame % 256] == confirmed_frame) {
+                    confirmed_frame++;
+                }
+            }
+        }
+    }
+}
+
+// Every second, publish the statistics of the last second
+void Netplay::refresh_statistics() {
+    std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+    if (std::chrono::seconds(1) <= now - statistics_time) {
+        statistics = current_statistics;
+        statistics.average_rollback_depth = (statistics.rollbacks == 0) ? 0 : total_rollback_depth / static_cast<float>(statistics.rollbacks);
+
+        current_statistics = {};
+        total_rollback_depth = 0;
+
+        statistics_time = now;
+    }
+}
+
+// If we guessed wrong, load the game from before the wrong guess and simulate it again with the right inputs
+void Netplay::rollback(Game& i_game) {
+    if (rollback_frame < frame) {
+        unsigned char depth = static_cast<unsigned char>(frame - rollback_frame);
+
+        i_game = snapshots[rollback_frame % (1 + ROLLBACK_FRAMES)];
+
+        for (unsigned a = rollback_frame; a < frame; a++) {
+            // The old snapshots after the wrong guess are wrong too
+            if (a != rollback_frame) {
+                snapshots[a % (1 + ROLLBACK_FRAMES)] = i_game;
+            }
+
+            simulate(a, i_game);
+        }
+
+        current_statistics.max_rollback_depth = std::max(current_statistics.max_rollback_depth, depth);
+        current_statistics.resimulated_frames += depth;
+        current_statistics.rollbacks++;
+
+        total_rollback_depth += depth;
+
+        rollback_frame = frame;
+    }
+}
+
+// Put a packet in the queue, unless the fake packet loss eats it (or the queue is full, which is just more packet loss)
+void Netplay::send(const unsigned char* i_data, unsigned short i_size) {
+    current_statistics.sent_bytes += i_size + UDP_HEADER_SIZE;
+
+    if (get_random(random_state) % 100 >= loss && delayed_packet_count < MAX_DELAYED_PACKETS) {
+        DelayedPacket& packet = delayed_packets[(first_delayed_packet + delayed_packet_count) % MAX_DELAYED_PACKETS];
+        packet.size = i_size;
+        packet.send_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(latency);
+
+        std::copy(i_data, i_data + i_size, packet.data.begin());
+
+        delayed_packet_count++;
+    }
+
+    flush();
+}
+
+// Send every input the other player doesn't have yet (so a lost packet doesn't matter)
+void Netplay::send_inputs() {
+    unsigned first_frame = std::max(remote_ack, (frame < 255) ? 0 : frame - 255);
+    // Every input before this frame is confirmed and simulated, so the other player can check our hash
+    unsigned hash_frame = get_confirmed_frame();
+
+    std::array<unsigned char, MAX_PACKET_SIZE> packet;
+    packet[0] = PACKET_INPUTS;
+    write_u32(first_frame, &packet[1]);
+    write_u32(confirmed_frame, &packet[5]);
+    write_u32(hash_frame, &packet[9]);
+    write_u64((hash_frame == 0) ? 0 : hashes[(hash_frame - 1) % 256], &packet[13]);
+    packet[INPUTS_HEADER_SIZE - 1] = static_cast<unsigned char>(frame - first_frame);
+
+    for (unsigned a = first_frame; a < frame; a++) {
+        packet[INPUTS_HEADER_SIZE + a - first_frame] = local_inputs[a % 256];
+    }
+
+    send(packet.data(), static_cast<unsigned short>(INPUTS_HEADER_SIZE + frame - first_frame));
+}
+
+// Simulate one frame with both inputs
+void Netplay::simulate(unsigned i_frame, Game& i_game) {
+    if (player == 0) {
+        i_game.update(local_inputs[i_frame % 256], get_remote_input(i_frame));
+    }
+    else {
+        i_game.update(get_remote_input(i_frame), local_inputs[i_frame % 256]);
+    }
+
+    hashes[i_frame % 256] = i_game.get_hash();
+}
+
+// Am I Pacman (0) or the red ghost (1)?
+bool Netplay::get_player() {
+    return player;
+}
+
+// Wait until somebody joins (we're Pacman)
+bool Netplay::host(unsigned short i_port, unsigned& i_seed) {
+    if (socket.bind(i_port) != sf::Socket::Done) {
+        return 0;
+    }
+
+    player = 0;
+    seed = i_seed;
+
+    socket.setBlocking(0);
+
+    while (!connected) {
+        receive();
+        flush();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return 1;
+}
+
+// Join the host (we're the red ghost) and get the seed from them
+bool Netplay::join(const sf::IpAddress& i_address, unsigned short i_port, unsigned& i_seed) {
+    if (socket.bind(sf::Socket::AnyPort) != sf::Socket::Done) {
+        return 0;
+    }
+
+    player = 1;
+
+    remote_address = i_address;
+    remote_port = i_port;
+
+    socket.setBlocking(0);
+
+    for (unsigned short a = 0; a < JOIN_TIMEOUT && !connected; a++) {
+        if (a % HELLO_INTERVAL == 0) {
+            send(&PACKET_HELLO, 1);
+        }
+
+        receive();
+        flush();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    i_seed = seed;
+
+    return connected;
+}
+
+// Simulate the next frame with our input and a guess of the other player's input
+// Returns 0 if we're too far ahead and have to wait for the other player
+bool Netplay::update(unsigned char i_input, Game& i_game) {
+    bool output = 0;
+
+    if (snapshots.empty()) {
+        snapshots.assign(1 + ROLLBACK_FRAMES, i_game);
+    }
+
+    receive();
+    rollback(i_game);
+
+    // The other player may be ahead of us, so don't subtract here
+    if (frame < confirmed_frame + ROLLBACK_FRAMES) {
+        output = 1;
+
+        local_inputs[frame % 256] = i_input;
+
+        // Remember the game before this frame, in case we guess wrong
+        snapshots[frame % (1 + ROLLBACK_FRAMES)] = i_game;
+
+        simulate(frame, i_game);
+
+        frame++;
+
+        rollback_frame = frame;
+    }
+    else {
+        current_statistics.stalled_frames++;
+    }
+
+    check_hash();
+    send_inputs();
+    refresh_statistics();
+
+    return output;
+}
+
+// Get the frame before which we know every input of both players
+unsigned Netplay::get_confirmed_frame() {
+    return std::min(confirmed_frame, frame);
+}
+
+// Get the first frame where the games went different ways
+unsigned Netplay::get_desync_frame() {
+    return desync_frame;
+}
+
+// Get the first frame we haven't simulated yet
+unsigned Netplay::get_frame() {
+    return frame;
+}
+
+// Talk to the other player without simulating a new frame
+void Netplay::poll(Game& i_game) {
+    receive();
+    rollback(i_game);
+    check_hash();
+    send_inputs();
+    refresh_statistics();
+}
+
+// Get the statistics of the last second
+NetplayStatistics Netplay::get_statistics() {
+    return statistics;
+}
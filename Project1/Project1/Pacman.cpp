@@ -1,20 +1,32 @@
+#include <algorithm> // For std::max
 #include <array>  // For std::array
 #include <cmath>  // For mathematical operations like floor and ceil
+#include <vector> // For std::vector
 #include <SFML/Graphics.hpp> // For SFML graphics components
 
 #include "Headers/Global.hpp"      // Header for global constants and definitions
+#include "Headers/Map.hpp"           // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
 #include "Headers/Pacman.hpp"      // Header for Pac-Man class definition
 #include "Headers/MapCollision.hpp" // Header for map collision handling
+#include "Headers/Trace.hpp"        // Header for the trace zones
+#include "Headers/Zobrist.hpp"      // Header for the Zobrist hash
 
 // Constructor for the Pacman class with default initialization
 Pacman::Pacman() :
     animation_over(0),  // Animation hasn't ended yet
     dead(0),            // Pac-Man is not dead initially
     direction(0),       // Default direction (right)
+    movement_phase(0),  // Start at the first tick of the frame
+    turn(0),            // No turn to remember
+    turn_timer(0),
+    animation_timer(0), // Start the animation from the first frame
     energizer_timer(0), // No energizer effect initially
     position({ 0, 0 })    // Default position
 {
     // Note about avoiding repetition in the code comments
+    hash = compute_hash();
 }
 
 // Check if Pac-Man's death animation has finished
@@ -37,14 +49,28 @@ unsigned short Pacman::get_energizer_timer() {
     return energizer_timer;
 }
 
-// Draw Pac-Man on the SFML render window
-void Pacman::draw(bool i_victory, sf::RenderWindow& i_window) {
-    unsigned char frame = static_cast<unsigned char>(floor(animation_timer / static_cast<float>(PACMAN_ANIMATION_SPEED)));
+// Compute our part of the hash from scratch (while playing, we only update it when something changes)
+unsigned long long Pacman::compute_hash() {
+    return get_zobrist_key(HASH_PACMAN_DEAD, 0, dead) ^
+        get_zobrist_key(HASH_PACMAN_DIRECTION, 0, direction) ^
+        get_zobrist_key(HASH_PACMAN_ENERGIZER_TIMER, 0, energizer_timer) ^
+        get_zobrist_key(HASH_PACMAN_MOVEMENT_PHASE, 0, movement_phase) ^
+        get_zobrist_key(HASH_PACMAN_POSITION, 0, position.x) ^
+        get_zobrist_key(HASH_PACMAN_POSITION, 1, position.y) ^
+        get_zobrist_key(HASH_PACMAN_TURN, 0, turn) ^
+        get_zobrist_key(HASH_PACMAN_TURN_TIMER, 0, turn_timer);
+}
+
+// Get our part of the hash
+unsigned long long Pacman::get_hash() {
+    return hash;
+}
 
-    sf::Sprite sprite;  // Sprite to draw Pac-Man
-    sf::Texture texture; // Texture for Pac-Man's sprites
+// Add Pac-Man to the sprites of this frame
+void Pacman::draw(bool i_victory, EntityRenderer& i_renderer) {
+    TRACE_ZONE("Pacman::draw");
 
-    sprite.setPosition(position.x, position.y);  // Set the sprite's position
+    unsigned char frame = static_cast<unsigned char>(floor(animation_timer / static_cast<float>(PACMAN_ANIMATION_SPEED)));
 
     // If Pac-Man is dead or there's a victory animation to play
     if (dead || i_victory) {
@@ -52,13 +78,7 @@ void Pacman::draw(bool i_victory, sf::RenderWindow& i_window) {
         if (animation_timer < PACMAN_DEATH_FRAMES * PACMAN_ANIMATION_SPEED) {
             animation_timer++;  // Increment the animation timer
 
-            // Load the texture for Pac-Man's death animation
-            texture.loadFromFile("Resources/Images/PacmanDeath" + std::to_string(CELL_SIZE) + ".png");
-
-            sprite.setTexture(texture);  // Set the sprite's texture
-            sprite.setTextureRect(sf::IntRect(CELL_SIZE * frame, 0, CELL_SIZE, CELL_SIZE));  // Set the frame to draw
-
-            i_window.draw(sprite);  // Draw the sprite on the window
+            i_renderer.add_sprite(EntitySheet::PacmanDeathSheet, CELL_SIZE * frame, 0, position.x, position.y, sf::Color(255, 255, 255));
         }
         else {
             // Animation is over
@@ -66,12 +86,7 @@ void Pacman::draw(bool i_victory, sf::RenderWindow& i_window) {
         }
     }
     else {  // Normal animation when Pac-Man is alive
-        texture.loadFromFile("Resources/Images/Pacman" + std::to_string(CELL_SIZE) + ".png");
-
-        sprite.setTexture(texture);  // Set the sprite's texture
-        sprite.setTextureRect(sf::IntRect(CELL_SIZE * frame, CELL_SIZE * direction, CELL_SIZE, CELL_SIZE));  // Set the frame
-
-        i_window.draw(sprite);  // Draw the sprite
+        i_renderer.add_sprite(EntitySheet::PacmanSheet, CELL_SIZE * frame, CELL_SIZE * direction, position.x, position.y, sf::Color(255, 255, 255));
 
         // Loop the animation
         animation_timer = (animation_timer + 1) % (PACMAN_ANIMATION_FRAMES * PACMAN_ANIMATION_SPEED);
@@ -83,8 +98,12 @@ void Pacman::reset() {
     animation_over = 0;  // Reset animation over status
     dead = 0;  // Reset dead status
     direction = 0;  // Default direction
+    movement_phase = 0;  // Start at the first tick of the frame
+    turn_timer = 0;  // Forget the remembered turn
     animation_timer = 0;  // Reset animation timer
     energizer_timer = 0;  // Reset energizer timer
+
+    hash = compute_hash();  // Almost everything changed, so we start the hash again
 }
 
 // Set the animation timer for Pac-Man
@@ -94,6 +113,8 @@ void Pacman::set_animation_timer(unsigned short i_animation_timer) {
 
 // Set the dead status for Pac-Man
 void Pacman::set_dead(bool i_dead) {
+    update_zobrist_hash(HASH_PACMAN_DEAD, 0, dead, i_dead, hash);
+
     dead = i_dead;
 
     if (dead) {  // If Pac-Man is dead, reset the animation timer
@@ -103,60 +124,103 @@ void Pacman::set_dead(bool i_dead) {
 
 // Set Pac-Man's position on the game map
 void Pacman::set_position(short i_x, short i_y) {
+    update_zobrist_hash(HASH_PACMAN_POSITION, 0, position.x, i_x, hash);
+    update_zobrist_hash(HASH_PACMAN_POSITION, 1, position.y, i_y, hash);
+
     position = { i_x, i_y };  // Set the position
 }
 
-// Update Pac-Man's state and movement based on keyboard input and map collisions
+// Update Pac-Man's state and movement based on the input and map collisions
 void Pacman::update(
-    unsigned char i_level,
-    std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH>& i_map
+    const LevelSettings& i_level_settings,
+    unsigned char i_input,
+    Map& i_map,
+    unsigned long long& i_map_hash
 ) {
+    // How we were before this tick, so at the end we only change the keys of the things that changed
+    const Pacman previous = *this;
+
+    // How many pixels we move in this tick
+    unsigned char speed = get_step(i_level_settings.pacman_speed, movement_phase);
+
+    // Even in the ticks we don't move, we look ahead, so we can turn as soon as possible
+    short look_ahead = std::max<short>(1, speed);
+
+    movement_phase = (1 + movement_phase) % TICK_MULTIPLIER;
+
     // Detect collisions with walls in all four directions
     std::array<bool, 4> walls{};
-    walls[0] = map_collision(0, 0, PACMAN_SPEED + position.x, position.y, i_map);  // Right
-    walls[1] = map_collision(0, 0, position.x, position.y - PACMAN_SPEED, i_map);  // Up
-    walls[2] = map_collision(0, 0, position.x - PACMAN_SPEED, position.y, i_map);  // Left
-    walls[3] = map_collision(0, 0, position.x, position.y + PACMAN_SPEED, i_map);  // Down
+    walls[0] = map_collision(0, look_ahead + position.x, position.y, i_map);  // Right
+    walls[1] = map_collision(0, position.x, position.y - look_ahead, i_map);  // Up
+    walls[2] = map_collision(0, position.x - look_ahead, position.y, i_map);  // Left
+    walls[3] = map_collision(0, position.x, position.y + look_ahead, i_map);  // Down
+
+    // Remember the direction the player just pressed
+    if (i_input & INPUT_TURN) {
+        turn = (i_input >> 5) & 3;
+        turn_timer = TURN_BUFFER_DURATION;
+    }
 
-    // Change direction based on keyboard input and walls
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) && !walls[0]) {
+    // Change direction based on the input and walls
+    if ((i_input & 1) && !walls[0]) {
         direction = 0;  // Right
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) && !walls[1]) {
+    if ((i_input & 2) && !walls[1]) {
         direction = 1;  // Up
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) && !walls[2]) {
+    if ((i_input & 4) && !walls[2]) {
         direction = 2;  // Left
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) && !walls[3]) {
+    if ((i_input & 8) && !walls[3]) {
         direction = 3;  // Down
     }
 
+    // The remembered turn wins, because it's the newest thing the player asked for
+    // (So tapping a direction just before a junction still works.)
+    if (turn_timer > 0) {
+        if (!walls[turn]) {
+            direction = turn;
+            turn_timer = 0;
+        }
+        else {
+            turn_timer--;
+        }
+    }
+
     // Move Pac-Man in the chosen direction if there's no wall
     if (!walls[direction]) {
         switch (direction) {
-        case 0: position.x += PACMAN_SPEED; break;  // Right
-        case 1: position.y -= PACMAN_SPEED; break;  // Up
-        case 2: position.x -= PACMAN_SPEED; break;  // Left
-        case 3: position.y += PACMAN_SPEED; break;  // Down
+        case 0: position.x += speed; break;  // Right
+        case 1: position.y -= speed; break;  // Up
+        case 2: position.x -= speed; break;  // Left
+        case 3: position.y += speed; break;  // Down
         }
     }
 
     // Handle wrap-around if Pac-Man goes beyond the map bounds
     if (position.x < -CELL_SIZE) {
-        position.x = CELL_SIZE * MAP_WIDTH - PACMAN_SPEED;
+        position.x += CELL_SIZE * (1 + i_map.get_width());
     }
-    else if (position.x >= CELL_SIZE * MAP_WIDTH) {
-        position.x = PACMAN_SPEED - CELL_SIZE;
+    else if (position.x >= CELL_SIZE * i_map.get_width()) {
+        position.x -= CELL_SIZE * (1 + i_map.get_width()) - speed;
     }
 
     // Check for collisions with pellets or energizers and update the energizer timer
-    if (map_collision(1, 0, position.x, position.y, i_map)) {
-        energizer_timer = static_cast<unsigned short>(ENERGIZER_DURATION / pow(2, i_level));  // Reset energizer timer
+    if (map_collision(1, 0, position.x, position.y, i_map, i_map_hash)) {
+        energizer_timer = i_level_settings.energizer_duration;  // Reset energizer timer
     }
     else {
         energizer_timer = std::max(0, energizer_timer - 1);  // Decrease the energizer timer
     }
+
+    // Update the hash
+    update_zobrist_hash(HASH_PACMAN_DIRECTION, 0, previous.direction, direction, hash);
+    update_zobrist_hash(HASH_PACMAN_ENERGIZER_TIMER, 0, previous.energizer_timer, energizer_timer, hash);
+    update_zobrist_hash(HASH_PACMAN_MOVEMENT_PHASE, 0, previous.movement_phase, movement_phase, hash);
+    update_zobrist_hash(HASH_PACMAN_POSITION, 0, previous.position.x, position.x, hash);
+    update_zobrist_hash(HASH_PACMAN_POSITION, 1, previous.position.y, position.y, hash);
+    update_zobrist_hash(HASH_PACMAN_TURN, 0, previous.turn, turn, hash);
+    update_zobrist_hash(HASH_PACMAN_TURN_TIMER, 0, previous.turn_timer, turn_timer, hash);
 }
 
 // Get Pac-Man's current position
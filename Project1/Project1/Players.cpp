@@ -0,0 +1,110 @@
+#include <algorithm> // For std::max and std::min (in get_map_position)
+#include <array>     // For std::array
+#include <string>    // For std::string
+#include <vector>    // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components (the game's headers need them)
+#include "Headers/Global.hpp"             // Header for global constants and definitions
+#include "Headers/Map.hpp"                // Header for the Map class definition
+#include "Headers/LevelSettings.hpp"      // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp"     // Header for drawing Pacman and the ghosts
+#include "Headers/Pacman.hpp"             // Header for Pac-Man class definition
+#include "Headers/Ghost.hpp"              // Header for Ghost class definition
+#include "Headers/GhostPersonalities.hpp" // Header for get_position_ahead
+#include "Headers/GhostManager.hpp"       // Header for GhostManager class definition
+#include "Headers/MapCollision.hpp"       // Header for map_collision function definition
+#include "Headers/MapRenderer.hpp"        // Header for drawing the game map
+#include "Headers/Game.hpp"               // Header for the Game class definition
+#include "Headers/Random.hpp"             // Header for the deterministic random number generator
+#include "Headers/Players.hpp"            // Header for the players of the tools
+
+RandomPlayer get_random_player(unsigned i_seed) {
+    RandomPlayer output;
+
+    output.random_state = seed_random(i_seed, 4);
+    output.direction = get_random(output.random_state) % 4;
+
+    return output;
+}
+
+unsigned char get_random_input(RandomPlayer& i_player) {
+    unsigned random = get_random(i_player.random_state);
+
+    bool turn = random % 16 == 0;
+
+    i_player.direction = turn ? (random >> 4) % 4 : i_player.direction;
+
+    return static_cast<unsigned char>((1 << i_player.direction) | (turn ? INPUT_TURN | (i_player.direction << 5) : 0));
+}
+
+unsigned char get_pellet_direction(const Position& i_position, const Map& i_map, PelletSearch& i_search) {
+    unsigned short height = i_map.get_height();
+    unsigned short width = i_map.get_width();
+
+    // We don't look for pellets from inside a tunnel
+    if (i_position.x < 0 || i_position.y < 0 || i_position.x >= CELL_SIZE * width || i_position.y >= CELL_SIZE * height) {
+        return 4;
+    }
+
+    std::vector<unsigned>& queue = i_search.queue;
+    std::vector<unsigned char>& directions = i_search.directions;
+
+    directions.assign(width * height, 4);
+    queue.assign(1, i_position.x / CELL_SIZE + width * (i_position.y / CELL_SIZE));
+
+    for (std::size_t a = 0; a < queue.size(); a++) {
+        unsigned index = queue[a];
+
+        unsigned short x = index % width;
+        unsigned short y = static_cast<unsigned short>(index / width);
+
+        Cell cell = i_map.get_cell(x, y);
+
+        if (a != 0 && (cell == Cell::Pellet || cell == Cell::Energizer)) {
+            return directions[index];
+        }
+
+        // Right, up, left, down
+        std::array<unsigned, 4> neighbors = { 1 + index, index - width, index - 1, index + width };
+        std::array<bool, 4> inside = { 1 + x < width, 0 < y, 0 < x, 1 + y < height };
+
+        for (unsigned char b = 0; b < 4; b++) {
+            if (!inside[b] || directions[neighbors[b]] != 4 || neighbors[b] == queue[0]) {
+                continue;
+            }
+
+            Cell neighbor = i_map.get_cell(neighbors[b] % width, static_cast<unsigned short>(neighbors[b] / width));
+
+            if (neighbor != Cell::Wall && neighbor != Cell::Door) {
+                // The cells next to the start remember their direction, and the others get it from them
+                directions[neighbors[b]] = a == 0 ? b : directions[index];
+                queue.push_back(neighbors[b]);
+            }
+        }
+    }
+
+    return 4;
+}
+
+unsigned char get_pellet_input(unsigned char i_input, unsigned& i_random_state, Game& i_game, PelletSearch& i_search) {
+    Position position = i_game.get_pacman().get_position();
+
+    // We only decide in the middle of a cell
+    if (position.x % CELL_SIZE != 0 || position.y % CELL_SIZE != 0) {
+        return i_input;
+    }
+
+    unsigned char direction = get_pellet_direction(position, i_game.get_map(), i_search);
+
+    // No pellet we can reach (or we're in a tunnel), so we keep going, and take a random turn at a wall
+    if (direction == 4) {
+        direction = i_game.get_pacman().get_direction();
+
+        Position next = get_position_ahead(position, direction, 1, i_game.get_map());
+
+        if (map_collision(0, next.x, next.y, i_game.get_map())) {
+            direction = get_random(i_random_state) % 4;
+        }
+    }
+
+    return static_cast<unsigned char>(1 << direction);
+}
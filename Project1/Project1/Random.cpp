@@ -0,0 +1,16 @@
+#include "Headers/Random.hpp" // Header for the random number generator
+
+// Advance the generator and return the next number (xorshift32)
+unsigned get_random(unsigned& i_random_state) {
+    i_random_state ^= i_random_state << 13;
+    i_random_state ^= i_random_state >> 17;
+    i_random_state ^= i_random_state << 5;
+
+    return i_random_state;
+}
+
+// Create the starting state of a generator from a seed, so that every stream (ghost) gets its own numbers
+unsigned seed_random(unsigned i_seed, unsigned char i_stream) {
+    // Xorshift gets stuck at 0, so we make sure the state is odd
+    return (i_seed ^ (2654435769u * (1 + i_stream))) | 1;
+}
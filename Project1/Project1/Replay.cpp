@@ -0,0 +1,194 @@
+#include <algorithm> // For std::min
+#include <array>   // For std::array
+#include <cstdio>  // For reading and writing the files
+#include <string>  // For std::string
+#include <vector>  // For std::vector
+
+#include "Headers/LevelSettings.hpp" // Header for the settings in the setup hash
+#include "Headers/Replay.hpp"        // Header for the replays
+
+// The 64 bit FNV-1a hash
+constexpr unsigned long long FNV_OFFSET = 14695981039346656037ull;
+constexpr unsigned long long FNV_PRIME = 1099511628211ull;
+
+// Write i_size bytes of a number, starting with the lowest one
+static unsigned char* write_number(unsigned long long i_number, unsigned char i_size, unsigned char* i_data) {
+    for (unsigned char a = 0; a < i_size; a++) {
+        *i_data++ = static_cast<unsigned char>(i_number >> (8 * a));
+    }
+
+    return i_data;
+}
+
+static unsigned long long read_number(unsigned char i_size, const unsigned char*& i_data) {
+    unsigned long long output = 0;
+
+    for (unsigned char a = 0; a < i_size; a++) {
+        output |= static_cast<unsigned long long>(*i_data++) << (8 * a);
+    }
+
+    return output;
+}
+
+// Add i_size bytes of a number to an FNV-1a hash, starting with the lowest one
+static unsigned long long add_to_hash(unsigned long long i_number, unsigned char i_size, unsigned long long i_hash) {
+    for (unsigned char a = 0; a < i_size; a++) {
+        i_hash = (i_hash ^ (0xff & (i_number >> (8 * a)))) * FNV_PRIME;
+    }
+
+    return i_hash;
+}
+
+void add_replay_input(unsigned char i_pacman_input, unsigned char i_ghost_input, Replay& i_replay) {
+    if (!i_replay.runs.empty()) {
+        ReplayRun& run = i_replay.runs.back();
+
+        if (run.pacman_input == i_pacman_input && run.ghost_input == i_ghost_input && run.length < 65535) {
+            run.length++;
+
+            return;
+        }
+    }
+
+    i_replay.runs.push_back({ i_ghost_input, i_pacman_input, 1 });
+}
+
+unsigned long long get_replay_ticks(const Replay& i_replay) {
+    unsigned long long output = 0;
+
+    for (const ReplayRun& run : i_replay.runs) {
+        output += run.length;
+    }
+
+    return output;
+}
+
+// The sizes go in too, so moving a cell from the end of a row to the start of the next one changes the hash
+unsigned long long get_replay_setup_hash(const std::vector<std::string>& i_map_sketch) {
+    unsigned long long output = add_to_hash(i_map_sketch.size(), 4, FNV_OFFSET);
+
+    for (const std::string& row : i_map_sketch) {
+        output = add_to_hash(row.size(), 4, output);
+
+        for (char cell : row) {
+            output = add_to_hash(static_cast<unsigned char>(cell), 1, output);
+        }
+    }
+
+    // Every level the game can reach (the ones after the end of the table use its last level)
+    for (unsigned short a = 0; a < 256; a++) {
+        const LevelSettings& level_settings = get_level_settings(static_cast<unsigned char>(a));
+
+        output = add_to_hash(level_settings.ghost_1_chase, 1, output);
+        output = add_to_hash(level_settings.ghost_2_chase, 1, output);
+        output = add_to_hash(level_settings.ghost_3_chase, 1, output);
+        output = add_to_hash(level_settings.ghost_escape_speed, 1, output);
+        output = add_to_hash(level_settings.ghost_frightened_speed, 1, output);
+        output = add_to_hash(level_settings.ghost_speed, 1, output);
+        output = add_to_hash(level_settings.pacman_speed, 1, output);
+        output = add_to_hash(level_settings.chase_duration, 2, output);
+        output = add_to_hash(level_settings.energizer_duration, 2, output);
+        output = add_to_hash(level_settings.ghost_flash_start, 2, output);
+        output = add_to_hash(level_settings.long_scatter_duration, 2, output);
+        output = add_to_hash(level_settings.short_scatter_duration, 2, output);
+    }
+
+    return output;
+}
+
+ReplayStatus read_replay(std::FILE* i_file, Replay& i_replay) {
+    std::array<unsigned char, REPLAY_HEADER_SIZE> header;
+
+    if (std::fread(header.data(), 1, header.size(), i_file) != header.size()) {
+        return BrokenReplay;
+    }
+
+    const unsigned char* data = header.data();
+
+    if (read_number(4, data) != REPLAY_MAGIC) {
+        return BrokenReplay;
+    }
+
+    i_replay.id = static_cast<unsigned>(read_number(4, data));
+    i_replay.seed = static_cast<unsigned>(read_number(4, data));
+
+    unsigned run_count = static_cast<unsigned>(read_number(4, data));
+
+    i_replay.ghost_simulation_radius = static_cast<unsigned short>(read_number(2, data));
+    i_replay.versus = read_number(1, data) != 0;
+    i_replay.level = static_cast<unsigned char>(read_number(1, data));
+    i_replay.hash = read_number(8, data);
+    i_replay.setup_hash = read_number(8, data);
+
+    // Every run has at least one tick, so a replay with more runs than MAX_REPLAY_TICKS is too long
+    // We don't keep its runs, but we still read them, to find where the next replay starts
+    bool refused = run_count > MAX_REPLAY_TICKS;
+
+    unsigned long long ticks = 0;
+
+    i_replay.runs.resize(refused ? 0 : run_count);
+
+    // The runs are read in blocks, so a long replay doesn't need a second buffer as big as itself
+    std::array<unsigned char, 1024 * REPLAY_RUN_SIZE> block;
+
+    for (unsigned a = 0; a < run_count; a += 1024) {
+        unsigned block_runs = std::min(1024u, run_count - a);
+
+        if (std::fread(block.data(), REPLAY_RUN_SIZE, block_runs, i_file) != block_runs) {
+            return BrokenReplay;
+        }
+
+        if (refused && i_replay.runs.empty()) {
+            continue;
+        }
+
+        data = block.data();
+
+        for (unsigned b = a; b < a + block_runs; b++) {
+            i_replay.runs[b].pacman_input = static_cast<unsigned char>(read_number(1, data));
+            i_replay.runs[b].ghost_input = static_cast<unsigned char>(read_number(1, data));
+            i_replay.runs[b].length = static_cast<unsigned short>(read_number(2, data));
+
+            // A run of 0 ticks isn't something a game writes
+            refused |= i_replay.runs[b].length == 0;
+            ticks += i_replay.runs[b].length;
+        }
+    }
+
+    return refused || MAX_REPLAY_TICKS < ticks ? RefusedReplay : ValidReplay;
+}
+
+bool write_replay(std::FILE* i_file, const Replay& i_replay) {
+    std::array<unsigned char, REPLAY_HEADER_SIZE> header;
+
+    unsigned char* data = header.data();
+
+    data = write_number(REPLAY_MAGIC, 4, data);
+    data = write_number(i_replay.id, 4, data);
+    data = write_number(i_replay.seed, 4, data);
+    data = write_number(i_replay.runs.size(), 4, data);
+    data = write_number(i_replay.ghost_simulation_radius, 2, data);
+    data = write_number(i_replay.versus, 1, data);
+    data = write_number(i_replay.level, 1, data);
+    data = write_number(i_replay.hash, 8, data);
+    write_number(i_replay.setup_hash, 8, data);
+
+    if (std::fwrite(header.data(), 1, header.size(), i_file) != header.size()) {
+        return 0;
+    }
+
+    for (const ReplayRun& run : i_replay.runs) {
+        std::array<unsigned char, REPLAY_RUN_SIZE> run_data;
+
+        data = run_data.data();
+        data = write_number(run.pacman_input, 1, data);
+        data = write_number(run.ghost_input, 1, data);
+        write_number(run.length, 2, data);
+
+        if (std::fwrite(run_data.data(), 1, run_data.size(), i_file) != run_data.size()) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
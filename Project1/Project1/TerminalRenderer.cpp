@@ -0,0 +1,424 @@
+#include <algorithm> // For std::max, std::min and std::sort
+#include <array>   // For std::array
+#include <cstdio>  // For std::snprintf
+#include <cstring> // For std::strcmp and std::strcpy
+#include <string>  // For std::string
+#include <vector>  // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components (the game's headers need them, we don't draw anything with them)
+
+#include "Headers/Global.hpp"           // Header for global constants and definitions
+#include "Headers/Map.hpp"              // Header for the Map class definition
+#include "Headers/LevelSettings.hpp"    // Header for when the ghosts start flashing
+#include "Headers/EntityRenderer.hpp"   // Header for drawing Pacman and the ghosts
+#include "Headers/Pacman.hpp"           // Header for Pac-Man class definition
+#include "Headers/Ghost.hpp"            // Header for Ghost class definition
+#include "Headers/GhostManager.hpp"     // Header for GhostManager class definition
+#include "Headers/MapRenderer.hpp"      // Header for drawing the game map
+#include "Headers/Game.hpp"             // Header for the Game class definition
+#include "Headers/Trace.hpp"            // Header for the trace zones
+#include "Headers/TerminalRenderer.hpp" // Header for the TerminalRenderer class definition
+
+// The glyphs, TERMINAL_CELL_COLUMNS columns each, in UTF-8
+// The first ones are in the order of the Cell enum, so a map cell is its own glyph
+enum TerminalGlyph : unsigned char
+{
+    GLYPH_DOOR,
+    GLYPH_EMPTY,
+    GLYPH_ENERGIZER,
+    GLYPH_PELLET,
+    GLYPH_WALL,
+    GLYPH_EYES,
+    GLYPH_GHOST,
+    GLYPH_PACMAN
+};
+
+const std::array<const char*, 8> GLYPHS = {
+    "──",
+    "  ",
+    "● ",
+    "· ",
+    "██",
+    "°°",
+    "◢◣",
+    "◖◗"
+};
+
+// The colors of the 256 color palette we use (0 means we don't know, because the terminal was just reset)
+constexpr unsigned char COLOR_DEAD = 244;
+constexpr unsigned char COLOR_DOOR = 218;
+constexpr unsigned char COLOR_FRIGHTENED = 27;
+constexpr unsigned char COLOR_PACMAN = 226;
+constexpr unsigned char COLOR_PELLET = 223;
+constexpr unsigned char COLOR_TEXT = 231;
+constexpr unsigned char COLOR_WALL = 20;
+
+// The ghosts in the order of GhostPersonalities (red, pink, blue and orange)
+const std::array<unsigned char, 4> GHOST_COLORS = { 196, 218, 51, 215 };
+
+// The frightened ghosts flash this many ticks white, then this many blue, when the energizer is running out
+constexpr unsigned char FLASH_TICKS = 16 * TICK_MULTIPLIER;
+
+// The cursor isn't at the start of any cell (after the status line, and when we don't know where it is)
+constexpr unsigned short NO_CURSOR = 65535;
+
+constexpr TerminalCell BLANK_CELL = { 0, GLYPH_EMPTY };
+
+// What a map cell looks like (the empty cells have no color, so moving over them doesn't change the color)
+static TerminalCell get_map_cell(Cell i_cell) {
+    TerminalCell output;
+    output.glyph = i_cell;
+
+    switch (i_cell) {
+    case Cell::Door:
+        output.color = COLOR_DOOR;
+
+        break;
+    case Cell::Empty:
+        output.color = 0;
+
+        break;
+    case Cell::Wall:
+        output.color = COLOR_WALL;
+
+        break;
+    default:
+        output.color = COLOR_PELLET;
+    }
+
+    return output;
+}
+
+// The map cell something at this pixel position is in, on one axis (it's in the one it covers the most, and it can be outside the map in a tunnel)
+static int get_cell_coordinate(short i_position) {
+    return get_floor_cell(CELL_SIZE / 2 + i_position);
+}
+
+// Where the camera goes on one axis to put i_cell in the middle of the view, without showing anything outside the map
+static unsigned short get_camera_start(int i_cell, unsigned short i_map_size, unsigned short i_view_size) {
+    return static_cast<unsigned short>(std::max(0, std::min<int>(i_cell - i_view_size / 2, i_map_size - i_view_size)));
+}
+
+// Constructor for the TerminalRenderer class (we don't know the size of the terminal yet)
+TerminalRenderer::TerminalRenderer() :
+    redraw(1),
+    color(0),
+    columns(80),
+    rows(24),
+    camera_x(0),
+    camera_y(0),
+    cursor_x(NO_CURSOR),
+    cursor_y(NO_CURSOR),
+    map_height(0),
+    map_width(0),
+    view_height(0),
+    view_width(0),
+    changed_cells(0)
+{
+    entity_cells.fill(0);
+    shown_status.fill(0);
+}
+
+// Get how many cells the last frame wrote
+unsigned TerminalRenderer::get_changed_cells() {
+    return changed_cells;
+}
+
+// Compare a cell of the view in this frame
+void TerminalRenderer::mark_cell(unsigned i_cell) {
+    if (i_cell < dirty_marks.size() && !dirty_marks[i_cell]) {
+        dirty_marks[i_cell] = 1;
+        dirty_cells.push_back(i_cell);
+    }
+}
+
+// Move the cursor to the start of a cell of the view (the terminal counts from 1), unless it's already there
+void TerminalRenderer::move_cursor(unsigned short i_x, unsigned short i_y) {
+    if (cursor_x == i_x && cursor_y == i_y) {
+        return;
+    }
+
+    char sequence[16];
+
+    output.append(sequence, std::snprintf(sequence, sizeof(sequence), "\x1b[%u;%uH", 1 + i_y, 1 + TERMINAL_CELL_COLUMNS * i_x));
+
+    cursor_x = i_x;
+    cursor_y = i_y;
+}
+
+// Write with this color from now on, unless we already do
+void TerminalRenderer::set_color(unsigned char i_color) {
+    if (color == i_color) {
+        return;
+    }
+
+    char sequence[16];
+
+    output.append(sequence, std::snprintf(sequence, sizeof(sequence), "\x1b[38;5;%um", i_color));
+
+    color = i_color;
+}
+
+// The camera only moves when Pacman gets close to the edge of the view, and then it puts him in the middle
+// (Following him every cell would rewrite the whole view every few frames, which is most of the bytes we'd send.)
+void TerminalRenderer::update_camera(Position i_pacman_position) {
+    int pacman_x = std::max(0, std::min<int>(map_width - 1, get_cell_coordinate(i_pacman_position.x)));
+    int pacman_y = std::max(0, std::min<int>(map_height - 1, get_cell_coordinate(i_pacman_position.y)));
+
+    unsigned short next_x = camera_x;
+    unsigned short next_y = camera_y;
+
+    if (pacman_x < camera_x + view_width / 4 || pacman_x >= camera_x + view_width - view_width / 4) {
+        next_x = get_camera_start(pacman_x, map_width, view_width);
+    }
+
+    if (pacman_y < camera_y + view_height / 4 || pacman_y >= camera_y + view_height - view_height / 4) {
+        next_y = get_camera_start(pacman_y, map_height, view_height);
+    }
+
+    if (next_x != camera_x || next_y != camera_y) {
+        camera_x = next_x;
+        camera_y = next_y;
+
+        // Every cell of the view shows another map cell now, so update_map must look at every chunk in it again
+        std::fill(chunk_versions.begin(), chunk_versions.end(), 0);
+    }
+}
+
+// Copy the cells of the chunks in the view that changed since the last frame, and mark the ones that look different
+void TerminalRenderer::update_map(const Map& i_map) {
+    if (view_width == 0 || view_height == 0) {
+        return;
+    }
+
+    for (unsigned short a = camera_y / CHUNK_SIZE; a <= (camera_y + view_height - 1) / CHUNK_SIZE; a++) {
+        for (unsigned short b = camera_x / CHUNK_SIZE; b <= (camera_x + view_width - 1) / CHUNK_SIZE; b++) {
+            unsigned long long version = i_map.get_chunk_version(b, a);
+
+            unsigned long long& chunk_version = chunk_versions[b + i_map.get_chunk_columns() * a];
+
+            if (chunk_version == version) {
+                continue;
+            }
+
+            chunk_version = version;
+
+            // The cells of the chunk that are in the view
+            unsigned short first_x = std::max<unsigned short>(camera_x, CHUNK_SIZE * b);
+            unsigned short first_y = std::max<unsigned short>(camera_y, CHUNK_SIZE * a);
+            unsigned short last_x = std::min<unsigned short>(camera_x + view_width, CHUNK_SIZE * (1 + b));
+            unsigned short last_y = std::min<unsigned short>(camera_y + view_height, CHUNK_SIZE * (1 + a));
+
+            for (unsigned short c = first_y; c < last_y; c++) {
+                for (unsigned short d = first_x; d < last_x; d++) {
+                    unsigned cell = d - camera_x + view_width * (c - camera_y);
+
+                    TerminalCell map_cell = get_map_cell(i_map.get_cell(d, c));
+
+                    if (!(map_cells[cell] == map_cell)) {
+                        map_cells[cell] = map_cell;
+
+                        mark_cell(cell);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Write the status line under the map, if it changed
+void TerminalRenderer::write_status(const char* i_status) {
+    if (std::strcmp(i_status, shown_status.data()) == 0) {
+        return;
+    }
+
+    std::strcpy(shown_status.data(), i_status);
+
+    move_cursor(0, view_height);
+    set_color(COLOR_TEXT);
+
+    // Then clear the rest of the line (the last status could have been longer)
+    output.append(i_status);
+    output.append("\x1b[K");
+
+    cursor_x = NO_CURSOR;
+    cursor_y = NO_CURSOR;
+}
+
+// The next frame writes everything again
+void TerminalRenderer::resize(unsigned short i_columns, unsigned short i_rows) {
+    columns = i_columns;
+    rows = i_rows;
+
+    redraw = 1;
+}
+
+// Turn what the terminal shows into the game
+const std::string& TerminalRenderer::draw(Game& i_game, const char* i_note) {
+    TRACE_ZONE("TerminalRenderer::draw");
+
+    Map& map = i_game.get_map();
+
+    Pacman& pacman = i_game.get_pacman();
+
+    output.clear();
+
+    bool new_map = map.get_width() != map_width || map.get_height() != map_height;
+
+    if (redraw || new_map) {
+        redraw = 0;
+
+        map_height = map.get_height();
+        map_width = map.get_width();
+
+        // The last row of the terminal is for the status line
+        view_height = static_cast<unsigned short>(std::min<int>(map_height, std::max(1, static_cast<int>(rows)) - 1));
+        view_width = static_cast<unsigned short>(std::min<int>(map_width, columns / TERMINAL_CELL_COLUMNS));
+
+        // A new map starts with Pacman in the middle. After a resize, the camera stays where it was (if the view still fits there).
+        if (new_map) {
+            camera_x = get_camera_start(get_cell_coordinate(pacman.get_position().x), map_width, view_width);
+            camera_y = get_camera_start(get_cell_coordinate(pacman.get_position().y), map_height, view_height);
+        }
+        else {
+            camera_x = std::min<unsigned short>(camera_x, map_width - view_width);
+            camera_y = std::min<unsigned short>(camera_y, map_height - view_height);
+        }
+
+        // A cleared terminal shows empty cells (these only allocate when the size changes)
+        chunk_versions.assign(map.get_chunk_columns() * map.get_chunk_rows(), 0);
+        dirty_marks.assign(view_width * view_height, 0);
+        map_cells.assign(view_width * view_height, BLANK_CELL);
+        shown_cells.assign(view_width * view_height, BLANK_CELL);
+
+        dirty_cells.clear();
+        dirty_cells.reserve(view_width * view_height);
+
+        entity_cells.fill(view_width * view_height);
+        shown_status.fill(0);
+
+        color = 0;
+        cursor_x = NO_CURSOR;
+        cursor_y = NO_CURSOR;
+
+        // The normal color, clear the terminal and hide the cursor
+        output.append("\x1b[0m\x1b[2J\x1b[?25l");
+    }
+
+    update_camera(pacman.get_position());
+    update_map(map);
+
+    // Pacman and the ghosts: where they are in the view (if they are), and what they look like
+    // Like Game::draw, we only show the ghosts while the level is being played
+    bool playing = !i_game.get_game_won() && !pacman.get_dead();
+
+    std::array<unsigned, 5> next_cells;
+
+    std::array<TerminalCell, 5> entities;
+
+    for (unsigned char a = 0; a < 5; a++) {
+        Position position = a < 4 ? i_game.get_ghost_manager().get_ghosts()[a].get_position() : pacman.get_position();
+
+        int x = get_cell_coordinate(position.x) - camera_x;
+        int y = get_cell_coordinate(position.y) - camera_y;
+
+        bool visible = (a == 4 || playing) && 0 <= x && x < view_width && 0 <= y && y < view_height;
+
+        next_cells[a] = visible ? static_cast<unsigned>(x + view_width * y) : view_width * view_height;
+    }
+
+    for (unsigned char a = 0; a < 4; a++) {
+        Ghost& ghost = i_game.get_ghost_manager().get_ghosts()[a];
+
+        unsigned short energizer_timer = pacman.get_energizer_timer();
+
+        bool flash = get_level_settings(i_game.get_level()).ghost_flash_start >= energizer_timer && energizer_timer / FLASH_TICKS % 2 == 0;
+
+        if (ghost.get_frightened_mode() == 0) {
+            entities[a] = { GHOST_COLORS[a], GLYPH_GHOST };
+        }
+        else if (ghost.get_frightened_mode() == 1) {
+            entities[a] = { flash ? COLOR_TEXT : COLOR_FRIGHTENED, GLYPH_GHOST };
+        }
+        else {
+            entities[a] = { COLOR_TEXT, GLYPH_EYES };
+        }
+    }
+
+    entities[4] = { pacman.get_dead() ? COLOR_DEAD : COLOR_PACMAN, GLYPH_PACMAN };
+
+    // The cells they left, and the ones they're in now (they're always compared, because a ghost can change without moving)
+    for (unsigned char a = 0; a < 5; a++) {
+        mark_cell(entity_cells[a]);
+        mark_cell(next_cells[a]);
+    }
+
+    entity_cells = next_cells;
+
+    // Row by row, so the cells next to each other don't need to move the cursor
+    std::sort(dirty_cells.begin(), dirty_cells.end());
+
+    changed_cells = 0;
+
+    for (unsigned cell : dirty_cells) {
+        dirty_marks[cell] = 0;
+
+        TerminalCell next_cell = map_cells[cell];
+
+        // Pacman is drawn over the ghosts, like in the game
+        for (unsigned char a = 0; a < 5; a++) {
+            if (entity_cells[a] == cell) {
+                next_cell = entities[a];
+            }
+        }
+
+        if (shown_cells[cell] == next_cell) {
+            continue;
+        }
+
+        shown_cells[cell] = next_cell;
+
+        move_cursor(static_cast<unsigned short>(cell % view_width), static_cast<unsigned short>(cell / view_width));
+
+        if (next_cell.glyph != GLYPH_EMPTY) {
+            set_color(next_cell.color);
+        }
+
+        output.append(GLYPHS[next_cell.glyph]);
+
+        // The terminal moved the cursor to the next cell
+        cursor_x++;
+
+        changed_cells++;
+    }
+
+    dirty_cells.clear();
+
+    char status[TERMINAL_STATUS_SIZE];
+
+    std::snprintf(status, sizeof(status), "Level %u  Pellets %u%s  %s", 1u + i_game.get_level(), map.get_pellet_count(), i_game.get_game_won() ? "  Next level!" : (pacman.get_dead() ? "  Game over" : ""), i_note);
+
+    // It mustn't wrap to the next line (that would scroll the terminal when the status is on the last one)
+    status[std::min<unsigned>(sizeof(status) - 1, std::max(1, static_cast<int>(columns)) - 1)] = 0;
+
+    write_status(status);
+
+    return output;
+}
+
+// Leave the terminal like we found it
+const std::string& TerminalRenderer::finish() {
+    output.clear();
+
+    move_cursor(0, view_height);
+
+    output.append("\x1b[0m\x1b[?25h\r\n");
+
+    color = 0;
+    cursor_x = NO_CURSOR;
+    cursor_y = NO_CURSOR;
+
+    // If the game is drawn again, it starts from a cleared terminal
+    redraw = 1;
+
+    return output;
+}
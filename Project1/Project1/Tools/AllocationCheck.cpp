@@ -0,0 +1,59 @@
+// Plays thousands of frames (with random inputs, through many levels and restarts) and fails if any of them allocates memory after the warm-up.
+// It doesn't open a window, so it only checks the ticks. "Project1 --check-allocations" checks the whole frame, drawing included.
+// Usage: AllocationCheck [--frames <frames>]
+
+#include <array>  // For std::array
+#include <cstdio> // For printing the results
+#include <string> // For std::string
+#include <vector> // For std::vector
+#include <SFML/Graphics.hpp> // SFML graphics library (the game can draw itself, but we never ask it to)
+
+#include "../Headers/Global.hpp"            // Header for global constants and definitions
+#include "../Headers/Map.hpp"               // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"     // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp"    // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"            // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"             // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"      // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"       // Header for drawing the game map
+#include "../Headers/Game.hpp"              // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"         // Header for the default map sketch
+#include "../Headers/Random.hpp"            // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"           // Header for the random player
+#include "../Headers/AllocationCounter.hpp" // Header for counting the heap allocations
+
+// The frames before this one may allocate memory
+constexpr unsigned short WARM_UP_FRAMES = 60;
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned allocating_frames = 0;
+    unsigned frames = 100000;
+
+    RandomPlayer player = get_random_player(1);
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        if (std::string(i_arguments[a]) == "--frames") {
+            frames = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    Game game(0, 1, get_map_sketch());
+
+    for (unsigned a = 0; a < frames; a++) {
+        unsigned long long allocation_count = get_allocation_count();
+
+        // Random directions, and restart as soon as the game ends
+        game.update(get_random_input(player) | INPUT_RESTART, 0);
+        game.get_hash();
+
+        if (WARM_UP_FRAMES <= a && allocation_count != get_allocation_count()) {
+            std::printf("Frame %u allocated memory %llu times.\n", a, get_allocation_count() - allocation_count);
+
+            allocating_frames++;
+        }
+    }
+
+    std::printf("%u of %u frames allocated memory after the warm-up (level %u at the end).\n", allocating_frames, frames, 1 + game.get_level());
+
+    return allocating_frames == 0 ? 0 : 1;
+}
@@ -0,0 +1,737 @@
+// Plays a big batch job on a fleet of worker processes (Linux only, it uses epoll and fork).
+// The coordinator splits the job (seeds x levels x policies) into units of --unit-games games and hands them to the workers that connect over TCP, on this computer or others.
+// Every worker pulls its next unit when it sends the result of the last one, so the fast workers take more units. When there are no units left to hand out,
+// an idle worker steals a copy of the unit that has been running the longest (the first result wins), so one slow or stuck worker doesn't hold up the end.
+// If a worker disconnects (or crashes), its unit goes back to the front of the queue. The results are merged as they come in, and they don't depend on
+// which worker played what: every game only depends on its seed, level and policy (the sum of the final hashes checks that).
+// It prints the results of every level and policy, the throughput of the whole fleet and of every worker.
+// Usage: BatchFleet [--port <port>] [--seeds <count>] [--level-count <count>] [--unit-games <count>] [--max-ticks <ticks>] [--spawn <workers>] [--crash-after <units>]
+//        BatchFleet --worker <IPv4 address> [--port <port>] [--crash-after <units>]
+// --spawn starts that many workers on this computer. --crash-after makes a worker (the first spawned one, in the coordinator) crash when it gets one more unit, to test the retries.
+
+#include <algorithm> // For std::find, std::max and std::min
+#include <array>     // For std::array
+#include <chrono>    // For measuring the throughput
+#include <cstdio>    // For printing the results
+#include <cstdlib>   // For std::abort
+#include <deque>     // For the units waiting for a worker
+#include <string>    // For std::string
+#include <thread>    // For waiting before connecting again
+#include <unordered_map> // For the workers
+#include <vector>    // For std::vector
+#include <arpa/inet.h>   // For inet_pton
+#include <errno.h>       // For errno
+#include <fcntl.h>       // For non-blocking sockets
+#include <netinet/in.h>  // For sockaddr_in
+#include <netinet/tcp.h> // For TCP_NODELAY
+#include <sys/epoll.h>   // For the coordinator's event loop
+#include <sys/socket.h>  // For the sockets
+#include <sys/wait.h>    // For waiting for the spawned workers
+#include <unistd.h>      // For fork, read, write and close
+#include <SFML/Graphics.hpp> // For SFML graphics components (the game's headers need them)
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"      // Header for the default map sketch
+#include "../Headers/BatchProtocol.hpp"  // Header for the messages between the coordinator and the workers
+#include "../Headers/Random.hpp"         // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"        // Header for the random and pellet players
+
+// A unit runs on at most this many workers at once (the first one, and one that stole it)
+constexpr unsigned char MAX_UNIT_COPIES = 2;
+
+// How long a worker tries to reach the coordinator
+constexpr unsigned char CONNECT_SECONDS = 10;
+
+// What a unit (or a level and policy, or the whole job) played
+struct FleetResults
+{
+    unsigned long long deaths;
+    unsigned long long games;
+    //The sum of the final hashes of the games, so we can check that two runs played the same games.
+    unsigned long long hash_sum;
+    unsigned long long pellets;
+    unsigned long long ticks;
+    unsigned long long timeouts;
+    unsigned long long wins;
+};
+
+// A part of the job
+struct WorkUnit
+{
+    bool done;
+
+    //How many workers are playing it right now.
+    unsigned char copies;
+    unsigned char level;
+    unsigned char policy;
+
+    unsigned first_seed;
+    unsigned game_count;
+    //How many times it went back to the queue because its worker left.
+    unsigned retries;
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time;
+};
+
+// What we know about a worker
+struct FleetWorker
+{
+    //Did it say hello?
+    bool ready;
+
+    //The unit it's playing (-1 if none).
+    int unit;
+
+    unsigned pid;
+    unsigned units;
+
+    //How long its units took, in microseconds (only the playing, not the waiting).
+    unsigned long long microseconds;
+
+    FleetResults results;
+
+    //The part of a message we didn't read yet.
+    std::vector<unsigned char> input;
+};
+
+// Everything the coordinator keeps track of
+struct Coordinator
+{
+    unsigned done_units;
+    //The results that came in for a unit that was already done (the worker it was stolen from finished it too).
+    unsigned duplicate_results;
+    unsigned max_ticks;
+    unsigned retried_units;
+    unsigned stolen_units;
+
+    //The units waiting for a worker (the retried ones go first).
+    std::deque<unsigned> queue;
+
+    std::unordered_map<int, FleetWorker> workers;
+
+    //The workers that left (or crashed), for the report.
+    std::vector<FleetWorker> departed_workers;
+
+    std::vector<WorkUnit> units;
+
+    //The results of every level and policy (level * POLICY_COUNT + policy).
+    std::vector<FleetResults> results;
+};
+
+// Write a little-endian number
+static void put_number(unsigned char*& i_data, unsigned long long i_value, unsigned char i_size) {
+    for (unsigned char a = 0; a < i_size; a++) {
+        *i_data++ = static_cast<unsigned char>(i_value >> (8 * a));
+    }
+}
+
+// Read a little-endian number
+static unsigned long long get_number(const unsigned char*& i_data, unsigned char i_size) {
+    unsigned long long output = 0;
+
+    for (unsigned char a = 0; a < i_size; a++) {
+        output |= static_cast<unsigned long long>(*i_data++) << (8 * a);
+    }
+
+    return output;
+}
+
+// Add a result to another one
+static void add_results(const FleetResults& i_results, FleetResults& i_total) {
+    i_total.deaths += i_results.deaths;
+    i_total.games += i_results.games;
+    i_total.hash_sum += i_results.hash_sum;
+    i_total.pellets += i_results.pellets;
+    i_total.ticks += i_results.ticks;
+    i_total.timeouts += i_results.timeouts;
+    i_total.wins += i_results.wins;
+}
+
+// Send a whole message (the messages are tiny, so the socket always takes them)
+static bool send_message(int i_socket, const unsigned char* i_data, std::size_t i_size) {
+    return send(i_socket, i_data, i_size, MSG_NOSIGNAL) == static_cast<ssize_t>(i_size);
+}
+
+// Read a whole message from a blocking socket
+static bool receive_message(int i_socket, unsigned char* i_data, std::size_t i_size) {
+    while (i_size > 0) {
+        ssize_t received = recv(i_socket, i_data, i_size, 0);
+
+        if (received <= 0) {
+            return 0;
+        }
+
+        i_data += received;
+        i_size -= received;
+    }
+
+    return 1;
+}
+
+// Play the games of a unit and put their results in a message
+static void play_unit(const unsigned char* i_unit, PelletSearch& i_search, std::array<unsigned char, BATCH_RESULT_MESSAGE_SIZE>& i_result) {
+    const unsigned char* data = 1 + i_unit;
+
+    unsigned index = static_cast<unsigned>(get_number(data, 4));
+    unsigned char level = static_cast<unsigned char>(get_number(data, 1));
+    unsigned char policy = static_cast<unsigned char>(get_number(data, 1));
+    unsigned first_seed = static_cast<unsigned>(get_number(data, 4));
+    unsigned game_count = static_cast<unsigned>(get_number(data, 4));
+    unsigned max_ticks = static_cast<unsigned>(get_number(data, 4));
+
+    FleetResults results = {};
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    for (unsigned a = 0; a < game_count; a++) {
+        unsigned char input = 0;
+
+        // The pellet policy uses the random player's numbers for its turns
+        RandomPlayer player = get_random_player(a + first_seed);
+
+        Game game(0, a + first_seed, get_map_sketch());
+
+        if (level != 0) {
+            game.reset(level, get_level_settings(level));
+        }
+
+        unsigned pellet_count = game.get_map().get_pellet_count();
+        unsigned ticks = 0;
+
+        while (ticks < max_ticks && !game.get_game_won() && !game.get_pacman().get_dead()) {
+            input = policy == POLICY_RANDOM ? get_random_input(player) : get_pellet_input(input, player.random_state, game, i_search);
+
+            game.update(input, 0);
+
+            ticks++;
+        }
+
+        results.deaths += game.get_pacman().get_dead();
+        results.games++;
+        results.hash_sum += game.get_hash();
+        results.pellets += pellet_count - game.get_map().get_pellet_count();
+        results.ticks += ticks;
+        results.timeouts += !game.get_game_won() && !game.get_pacman().get_dead();
+        results.wins += game.get_game_won();
+    }
+
+    unsigned long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+
+    unsigned char* output = i_result.data();
+
+    put_number(output, BATCH_MESSAGE_RESULT, 1);
+    put_number(output, index, 4);
+    put_number(output, results.games, 4);
+    put_number(output, results.wins, 4);
+    put_number(output, results.deaths, 4);
+    put_number(output, results.timeouts, 4);
+    put_number(output, results.ticks, 8);
+    put_number(output, results.pellets, 8);
+    put_number(output, results.hash_sum, 8);
+    put_number(output, microseconds, 8);
+}
+
+// A worker: connect to the coordinator, then play the units it sends until it says we're done
+static int run_worker(const std::string& i_address, unsigned short i_port, int i_crash_after) {
+    int server = -1;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(i_port);
+
+    if (inet_pton(AF_INET, i_address.c_str(), &address.sin_addr) != 1) {
+        std::printf("%s isn't an IPv4 address.\n", i_address.c_str());
+
+        return 1;
+    }
+
+    // The coordinator may not be listening yet
+    for (unsigned a = 0; a < 10 * CONNECT_SECONDS && server == -1; a++) {
+        server = socket(AF_INET, SOCK_STREAM, 0);
+
+        if (connect(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close(server);
+
+            server = -1;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+
+    if (server == -1) {
+        std::printf("Can't connect to %s:%u.\n", i_address.c_str(), i_port);
+
+        return 1;
+    }
+
+    int enable = 1;
+
+    setsockopt(server, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    std::array<unsigned char, BATCH_HELLO_MESSAGE_SIZE> hello;
+    std::array<unsigned char, BATCH_RESULT_MESSAGE_SIZE> result;
+    std::array<unsigned char, BATCH_UNIT_MESSAGE_SIZE> unit;
+
+    // For the pellet policy's searches
+    PelletSearch search;
+
+    unsigned char* data = hello.data();
+
+    put_number(data, BATCH_MESSAGE_HELLO, 1);
+    put_number(data, static_cast<unsigned>(getpid()), 4);
+
+    if (!send_message(server, hello.data(), hello.size())) {
+        close(server);
+
+        return 1;
+    }
+
+    while (receive_message(server, unit.data(), 1) && unit[0] == BATCH_MESSAGE_UNIT) {
+        if (!receive_message(server, 1 + unit.data(), unit.size() - 1)) {
+            break;
+        }
+
+        // To test the retries, we leave with the unit (like a crash would)
+        if (i_crash_after == 0) {
+            std::abort();
+        }
+
+        i_crash_after--;
+
+        play_unit(unit.data(), search, result);
+
+        if (!send_message(server, result.data(), result.size())) {
+            break;
+        }
+    }
+
+    close(server);
+
+    return 0;
+}
+
+// Give every idle worker a unit: the next one in the queue, or a copy of the one that has been running the longest
+static void assign_units(Coordinator& i_coordinator) {
+    for (std::pair<const int, FleetWorker>& worker : i_coordinator.workers) {
+        if (!worker.second.ready || worker.second.unit != -1) {
+            continue;
+        }
+
+        int unit = -1;
+
+        while (!i_coordinator.queue.empty() && unit == -1) {
+            unit = static_cast<int>(i_coordinator.queue.front());
+
+            i_coordinator.queue.pop_front();
+
+            // It was retried, but the worker that had it finished it after all
+            unit = i_coordinator.units[unit].done ? -1 : unit;
+        }
+
+        bool stolen = unit == -1;
+
+        for (unsigned a = 0; a < i_coordinator.units.size() && stolen; a++) {
+            const WorkUnit& candidate = i_coordinator.units[a];
+
+            if (!candidate.done && 0 < candidate.copies && candidate.copies < MAX_UNIT_COPIES && (unit == -1 || candidate.start_time < i_coordinator.units[unit].start_time)) {
+                unit = a;
+            }
+        }
+
+        if (unit == -1) {
+            return;
+        }
+
+        WorkUnit& work_unit = i_coordinator.units[unit];
+
+        std::array<unsigned char, BATCH_UNIT_MESSAGE_SIZE> message;
+
+        unsigned char* data = message.data();
+
+        put_number(data, BATCH_MESSAGE_UNIT, 1);
+        put_number(data, unit, 4);
+        put_number(data, work_unit.level, 1);
+        put_number(data, work_unit.policy, 1);
+        put_number(data, work_unit.first_seed, 4);
+        put_number(data, work_unit.game_count, 4);
+        put_number(data, i_coordinator.max_ticks, 4);
+
+        // If it doesn't go through, the worker is gone, and we'll see that when we read from it
+        if (!send_message(worker.first, message.data(), message.size())) {
+            if (!stolen) {
+                i_coordinator.queue.push_front(unit);
+            }
+
+            continue;
+        }
+
+        // A stolen unit keeps its start time, so the next idle worker steals another one
+        work_unit.start_time = stolen ? work_unit.start_time : std::chrono::steady_clock::now();
+        work_unit.copies++;
+
+        worker.second.unit = unit;
+
+        i_coordinator.stolen_units += stolen;
+    }
+}
+
+// A worker left (or crashed): its unit goes back to the front of the queue, unless another worker is playing it too
+static void drop_worker(Coordinator& i_coordinator, int i_socket) {
+    FleetWorker& worker = i_coordinator.workers[i_socket];
+
+    if (worker.unit != -1) {
+        WorkUnit& unit = i_coordinator.units[worker.unit];
+
+        unit.copies--;
+
+        if (!unit.done && unit.copies == 0) {
+            unit.retries++;
+
+            i_coordinator.queue.push_front(worker.unit);
+            i_coordinator.retried_units++;
+        }
+    }
+
+    if (worker.ready) {
+        i_coordinator.departed_workers.push_back(worker);
+    }
+
+    close(i_socket);
+
+    i_coordinator.workers.erase(i_socket);
+}
+
+// Read what a worker sent, and handle the whole messages (false if it left)
+static bool read_worker(Coordinator& i_coordinator, int i_socket) {
+    FleetWorker& worker = i_coordinator.workers[i_socket];
+
+    std::array<unsigned char, 4096> buffer;
+
+    while (1) {
+        ssize_t received = recv(i_socket, buffer.data(), buffer.size(), 0);
+
+        if (received == 0 || (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            return 0;
+        }
+
+        if (received < 0) {
+            break;
+        }
+
+        worker.input.insert(worker.input.end(), buffer.begin(), buffer.begin() + received);
+    }
+
+    std::size_t offset = 0;
+
+    while (offset < worker.input.size()) {
+        const unsigned char* data = worker.input.data() + offset;
+
+        unsigned char type = *data++;
+
+        std::size_t size = type == BATCH_MESSAGE_HELLO ? BATCH_HELLO_MESSAGE_SIZE : (type == BATCH_MESSAGE_RESULT ? BATCH_RESULT_MESSAGE_SIZE : 0);
+
+        // We don't know that message
+        if (size == 0 || (type == BATCH_MESSAGE_HELLO) == worker.ready) {
+            return 0;
+        }
+
+        if (worker.input.size() < offset + size) {
+            break;
+        }
+
+        offset += size;
+
+        if (type == BATCH_MESSAGE_HELLO) {
+            worker.pid = static_cast<unsigned>(get_number(data, 4));
+            worker.ready = 1;
+
+            continue;
+        }
+
+        unsigned index = static_cast<unsigned>(get_number(data, 4));
+
+        FleetResults results = {};
+
+        results.games = get_number(data, 4);
+        results.wins = get_number(data, 4);
+        results.deaths = get_number(data, 4);
+        results.timeouts = get_number(data, 4);
+        results.ticks = get_number(data, 8);
+        results.pellets = get_number(data, 8);
+        results.hash_sum = get_number(data, 8);
+
+        // It must be the unit we gave it
+        if (static_cast<int>(index) != worker.unit) {
+            return 0;
+        }
+
+        WorkUnit& unit = i_coordinator.units[index];
+
+        worker.microseconds += get_number(data, 8);
+        worker.unit = -1;
+        worker.units++;
+
+        add_results(results, worker.results);
+
+        unit.copies--;
+
+        if (unit.done) {
+            i_coordinator.duplicate_results++;
+
+            continue;
+        }
+
+        unit.done = 1;
+
+        i_coordinator.done_units++;
+
+        add_results(results, i_coordinator.results[unit.level * POLICY_COUNT + unit.policy]);
+    }
+
+    worker.input.erase(worker.input.begin(), worker.input.begin() + offset);
+
+    return 1;
+}
+
+// Print a worker's line of the report
+static void print_worker(const FleetWorker& i_worker, const char* i_state) {
+    double seconds = i_worker.microseconds / 1e6;
+
+    std::printf("%8u  %6u  %8llu  %12llu  %11.0f  %s\n", i_worker.pid, i_worker.units, i_worker.results.games, i_worker.results.ticks, 0 < seconds ? i_worker.results.ticks / seconds : 0.0, i_state);
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    int crash_after = -1;
+
+    unsigned short port = BATCH_PORT;
+
+    unsigned char level_count = 3;
+
+    unsigned seed_count = 4096;
+    unsigned spawn_count = 0;
+    unsigned unit_games = 64;
+
+    std::string worker_address;
+
+    std::vector<pid_t> children;
+
+    Coordinator coordinator = {};
+    coordinator.max_ticks = 20000;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--crash-after") {
+            crash_after = std::stoi(i_arguments[1 + a]);
+        }
+        else if (argument == "--level-count") {
+            level_count = static_cast<unsigned char>(std::max(1, std::min(255, std::stoi(i_arguments[1 + a]))));
+        }
+        else if (argument == "--max-ticks") {
+            coordinator.max_ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--port") {
+            port = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--seeds") {
+            seed_count = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--spawn") {
+            spawn_count = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--unit-games") {
+            unit_games = std::max(1u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+        else if (argument == "--worker") {
+            worker_address = i_arguments[1 + a];
+        }
+    }
+
+    if (!worker_address.empty()) {
+        return run_worker(worker_address, port, crash_after);
+    }
+
+    // Every level and policy plays the same seeds
+    for (unsigned char a = 0; a < level_count; a++) {
+        for (unsigned char b = 0; b < POLICY_COUNT; b++) {
+            for (unsigned c = 0; c < seed_count; c += unit_games) {
+                WorkUnit unit = {};
+                unit.level = a;
+                unit.policy = b;
+                unit.first_seed = 1 + c;
+                unit.game_count = std::min(unit_games, seed_count - c);
+
+                coordinator.queue.push_back(static_cast<unsigned>(coordinator.units.size()));
+                coordinator.units.push_back(unit);
+            }
+        }
+    }
+
+    coordinator.results.resize(level_count * POLICY_COUNT, FleetResults());
+
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int enable = 1;
+
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        std::printf("Can't listen on port %u.\n", port);
+
+        return 1;
+    }
+
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+
+    // The workers on this computer
+    for (unsigned a = 0; a < spawn_count; a++) {
+        std::fflush(stdout);
+
+        pid_t child = fork();
+
+        if (child == 0) {
+            close(listener);
+
+            _exit(run_worker("127.0.0.1", port, a == 0 ? crash_after : -1));
+        }
+
+        if (child > 0) {
+            children.push_back(child);
+        }
+    }
+
+    std::printf("%zu units of up to %u games (%u seeds, %u levels, %u policies), waiting for workers on port %u.\n", coordinator.units.size(), unit_games, seed_count, level_count, POLICY_COUNT, port);
+
+    int epoll = epoll_create1(0);
+
+    epoll_event listener_event = {};
+    listener_event.events = EPOLLIN;
+    listener_event.data.fd = listener;
+
+    epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &listener_event);
+
+    std::array<epoll_event, 256> events;
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+    std::chrono::time_point<std::chrono::steady_clock> report_time = start_time;
+
+    unsigned long long reported_ticks = 0;
+
+    while (coordinator.done_units < coordinator.units.size()) {
+        int event_count = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), 100);
+
+        for (int a = 0; a < event_count; a++) {
+            int socket = events[a].data.fd;
+
+            if (socket == listener) {
+                int client;
+
+                while ((client = accept(listener, nullptr, nullptr)) >= 0) {
+                    epoll_event event = {};
+                    event.events = EPOLLIN;
+                    event.data.fd = client;
+
+                    fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+                    FleetWorker& worker = coordinator.workers[client];
+                    worker = FleetWorker();
+                    worker.unit = -1;
+
+                    epoll_ctl(epoll, EPOLL_CTL_ADD, client, &event);
+                }
+            }
+            else if (!read_worker(coordinator, socket)) {
+                drop_worker(coordinator, socket);
+            }
+        }
+
+        assign_units(coordinator);
+
+        // The spawned workers we lost (if they're all gone and nobody else is here, nobody will finish the job)
+        pid_t child;
+
+        while ((child = waitpid(-1, nullptr, WNOHANG)) > 0) {
+            children.erase(std::find(children.begin(), children.end(), child));
+        }
+
+        if (0 < spawn_count && children.empty() && coordinator.workers.empty()) {
+            std::printf("FAILED: every worker is gone, and %zu units aren't done.\n", coordinator.units.size() - coordinator.done_units);
+
+            return 1;
+        }
+
+        // Once per second, how far we are
+        std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+        if (std::chrono::seconds(1) <= now - report_time) {
+            unsigned long long ticks = 0;
+
+            for (const FleetResults& results : coordinator.results) {
+                ticks += results.ticks;
+            }
+
+            std::printf("%u/%zu units done, %zu workers, %.0f ticks per second\n", coordinator.done_units, coordinator.units.size(), coordinator.workers.size(), (ticks - reported_ticks) / std::chrono::duration<double>(now - report_time).count());
+
+            report_time = now;
+            reported_ticks = ticks;
+        }
+    }
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // Tell the workers to stop
+    unsigned char done = BATCH_MESSAGE_DONE;
+
+    for (std::pair<const int, FleetWorker>& worker : coordinator.workers) {
+        send_message(worker.first, &done, BATCH_DONE_MESSAGE_SIZE);
+        close(worker.first);
+    }
+
+    for (pid_t child : children) {
+        waitpid(child, nullptr, 0);
+    }
+
+    close(epoll);
+    close(listener);
+
+    FleetResults totals = {};
+
+    std::printf("Level  Policy    Games   Wins  Deaths  Timeouts  Pellets/game  Ticks/game  Hash sum\n");
+
+    for (unsigned char a = 0; a < level_count; a++) {
+        for (unsigned char b = 0; b < POLICY_COUNT; b++) {
+            const FleetResults& results = coordinator.results[a * POLICY_COUNT + b];
+
+            std::printf("%5u  %-7s  %6llu  %5llu  %6llu  %8llu  %12.1f  %10.1f  %016llx\n", a, b == POLICY_RANDOM ? "random" : "pellets",
+                results.games, results.wins, results.deaths, results.timeouts, results.pellets / static_cast<double>(results.games), results.ticks / static_cast<double>(results.games), results.hash_sum);
+
+            add_results(results, totals);
+        }
+    }
+
+    std::printf("     PID   Units     Games         Ticks      Ticks/s\n");
+
+    for (const FleetWorker& worker : coordinator.departed_workers) {
+        print_worker(worker, "(left early)");
+    }
+
+    for (const std::pair<const int, FleetWorker>& worker : coordinator.workers) {
+        print_worker(worker.second, "");
+    }
+
+    std::printf("%llu games and %llu ticks in %.2f s: %.0f games and %.0f ticks per second on %zu workers.\n", totals.games, totals.ticks, duration, totals.games / duration, totals.ticks / duration, coordinator.workers.size() + coordinator.departed_workers.size());
+    std::printf("%u units were retried, %u stolen, %u results came in twice. Hash sum of every game: %016llx\n", coordinator.retried_units, coordinator.stolen_units, coordinator.duplicate_results, totals.hash_sum);
+}
@@ -0,0 +1,480 @@
+// Plays lots of random games with GameBatch on every physical core (Linux only, it reads the topology in /sys and pins the threads).
+// Big simulation hosts have more than one socket, and a thread that reads the memory of another socket is a lot slower. So we find the NUMA node of every core,
+// run one worker per physical core (not per hyperthread) pinned to it, and every worker allocates its batch and its statistics after it's pinned, so the kernel
+// puts them on its own node (a page goes to the node of the thread that touches it first). With --huge-pages, that memory comes from huge pages if there are any.
+// The maze and the level settings the workers start from are copied once per node, by the first worker that gets there.
+// It prints the games and ticks per second of every node, so we can check that every socket adds the same throughput (--workers plays on fewer cores).
+// Usage: BatchRunner [--games <count>] [--maze <file>] [--seed <seed>] [--max-ticks <ticks>] [--workers <count>] [--huge-pages 1] [--pin 0]
+
+#include <algorithm> // For std::find, std::max and std::stable_sort
+#include <array>     // For std::array
+#include <atomic>    // For handing out the games to the workers
+#include <chrono>    // For measuring the throughput
+#include <cstdio>    // For printing the results and reading /sys
+#include <cstring>   // For std::memset
+#include <memory>    // For std::unique_ptr
+#include <mutex>     // For std::call_once
+#include <new>       // For placement new
+#include <string>    // For std::string
+#include <thread>    // For std::thread
+#include <vector>    // For std::vector
+#include <dirent.h>   // For finding the node of a CPU
+#include <pthread.h>  // For pinning the workers
+#include <sched.h>    // For the CPUs we're allowed to use
+#include <sys/mman.h> // For mmap and the huge pages
+#include <SFML/Graphics.hpp> // For SFML graphics components (the game's headers need them)
+
+#include "../Headers/Global.hpp"        // Header for global constants and definitions
+#include "../Headers/Map.hpp"           // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"        // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"         // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"  // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"   // Header for drawing the game map
+#include "../Headers/Game.hpp"          // Header for the Game class definition (the players need it)
+#include "../Headers/GameBatch.hpp"     // Header for the GameBatch class definition
+#include "../Headers/MapSketch.hpp"     // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp" // Header for loading maze files
+#include "../Headers/Random.hpp"        // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"       // Header for the random player
+
+// The size of a huge page (the usual one on x86-64)
+constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// A physical core we can run a worker on
+struct PhysicalCore
+{
+    //The first of its hyperthreads (-1 if we couldn't read the topology, then we don't pin).
+    int cpu;
+
+    unsigned short node;
+};
+
+// What a worker counted
+struct BatchRunnerResults
+{
+    unsigned long long deaths;
+    unsigned long long games;
+    unsigned long long ticks;
+    //The games that reached --max-ticks.
+    unsigned long long timeouts;
+    unsigned long long wins;
+
+    //Did its memory come from the reserved huge pages?
+    bool huge_pages;
+};
+
+// What the workers of a node start from (the first worker of the node copies it, so it's in the node's memory)
+struct NodeReplica
+{
+    std::once_flag copied;
+
+    LevelSettings level_settings;
+
+    std::vector<std::string> maze;
+};
+
+// Everything a worker changes while playing. It's allocated by the worker, after it's pinned, so it's in the memory of its node
+struct WorkerState
+{
+    GameBatch batch;
+
+    BatchRunnerResults results;
+
+    std::array<unsigned char, BATCH_LANES> inputs;
+
+    std::array<RandomPlayer, BATCH_LANES> players;
+    std::array<unsigned, BATCH_LANES> lane_ticks;
+};
+
+// The next game a worker should play
+static std::atomic<unsigned long long> next_game(0);
+
+// Read a number from a file in /sys (-1 if it's not there)
+static int read_sys_number(const std::string& i_path) {
+    int output = -1;
+
+    std::FILE* file = std::fopen(i_path.c_str(), "r");
+
+    if (file != nullptr) {
+        if (std::fscanf(file, "%d", &output) != 1) {
+            output = -1;
+        }
+
+        std::fclose(file);
+    }
+
+    return output;
+}
+
+// The NUMA node of a CPU (its directory in /sys has a link called node<number>)
+static unsigned short get_cpu_node(int i_cpu) {
+    unsigned short output = 0;
+
+    DIR* directory = opendir(("/sys/devices/system/cpu/cpu" + std::to_string(i_cpu)).c_str());
+
+    if (directory == nullptr) {
+        return 0;
+    }
+
+    while (dirent* entry = readdir(directory)) {
+        std::string name = entry->d_name;
+
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 && name.find_first_not_of("0123456789", 4) == std::string::npos) {
+            output = static_cast<unsigned short>(std::stoi(name.substr(4)));
+
+            break;
+        }
+    }
+
+    closedir(directory);
+
+    return output;
+}
+
+// One core per physical core we're allowed to run on, spread over the nodes (the first cores of every node, then the second ones, and so on)
+// So --workers 2 on a computer with 2 sockets plays on both of them
+static std::vector<PhysicalCore> get_physical_cores() {
+    cpu_set_t allowed;
+
+    std::vector<PhysicalCore> cores;
+    // The (package, core) of the cores we already have, so we skip their other hyperthreads
+    std::vector<std::pair<int, int>> core_ids;
+
+    CPU_ZERO(&allowed);
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int a = 0; a < CPU_SETSIZE; a++) {
+            if (!CPU_ISSET(a, &allowed)) {
+                continue;
+            }
+
+            std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(a) + "/topology/";
+            std::pair<int, int> core_id(read_sys_number(topology + "physical_package_id"), read_sys_number(topology + "core_id"));
+
+            // Without the topology, every CPU is a core
+            if (core_id.first != -1 && core_id.second != -1) {
+                if (std::find(core_ids.begin(), core_ids.end(), core_id) != core_ids.end()) {
+                    continue;
+                }
+
+                core_ids.push_back(core_id);
+            }
+
+            cores.push_back({ a, get_cpu_node(a) });
+        }
+    }
+
+    // Not Linux enough, so we just use the threads we have, without pinning
+    if (cores.empty()) {
+        for (unsigned a = std::max(1u, std::thread::hardware_concurrency()); a > 0; a--) {
+            cores.push_back({ -1, 0 });
+        }
+    }
+
+    // Spread over the nodes
+    std::vector<unsigned> node_indices(cores.size());
+    std::vector<unsigned> node_sizes;
+
+    for (unsigned a = 0; a < cores.size(); a++) {
+        node_sizes.resize(std::max<std::size_t>(node_sizes.size(), 1 + cores[a].node), 0);
+        node_indices[a] = node_sizes[cores[a].node]++;
+    }
+
+    std::vector<unsigned> order(cores.size());
+
+    for (unsigned a = 0; a < order.size(); a++) {
+        order[a] = a;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](unsigned i_a, unsigned i_b) {
+        return node_indices[i_a] < node_indices[i_b];
+    });
+
+    std::vector<PhysicalCore> output;
+
+    for (unsigned a : order) {
+        output.push_back(cores[a]);
+    }
+
+    return output;
+}
+
+// Memory for a worker, from the reserved huge pages if we can (and want to), zeroed by the calling thread so its pages are on the caller's node
+static void* allocate_local(std::size_t i_size, bool i_huge_pages, bool& i_got_huge_pages) {
+    std::size_t size = (i_size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+    void* output = MAP_FAILED;
+
+    i_got_huge_pages = 0;
+
+    if (i_huge_pages) {
+        output = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        i_got_huge_pages = output != MAP_FAILED;
+    }
+
+    if (output == MAP_FAILED) {
+        output = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        // Without reserved huge pages, we can still ask for transparent ones (the kernel may or may not give them to us)
+        if (output != MAP_FAILED && i_huge_pages) {
+            madvise(output, size, MADV_HUGEPAGE);
+        }
+    }
+
+    if (output == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::memset(output, 0, size);
+
+    return output;
+}
+
+// Take the next game for a lane (false if there are no more)
+static bool start_lane_game(unsigned char i_lane, unsigned long long i_game_count, unsigned i_seed, WorkerState& i_state, unsigned& i_lane_seed) {
+    unsigned long long game = next_game++;
+
+    i_lane_seed = static_cast<unsigned>(game + i_seed);
+
+    i_state.players[i_lane] = get_random_player(i_lane_seed);
+    i_state.lane_ticks[i_lane] = 0;
+
+    return game < i_game_count;
+}
+
+static void run_worker(
+    unsigned long long i_game_count,
+    unsigned i_seed,
+    unsigned i_max_ticks,
+    bool i_huge_pages,
+    const PhysicalCore& i_core,
+    const std::vector<std::string>& i_maze,
+    NodeReplica& i_replica,
+    BatchRunnerResults& i_results
+) {
+    if (i_core.cpu != -1) {
+        cpu_set_t cpus;
+
+        CPU_ZERO(&cpus);
+        CPU_SET(i_core.cpu, &cpus);
+
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+
+    // We're on our node now, so the first of us to get here copies what we start from into the node's memory
+    std::call_once(i_replica.copied, [&] {
+        i_replica.level_settings = get_level_settings(0);
+        i_replica.maze = i_maze;
+    });
+
+    bool huge_pages = 0;
+
+    void* memory = allocate_local(sizeof(WorkerState), i_huge_pages, huge_pages);
+
+    if (memory == nullptr) {
+        std::printf("Can't allocate the memory of the worker on CPU %d.\n", i_core.cpu);
+
+        return;
+    }
+
+    WorkerState* state = new (memory) WorkerState();
+
+    // The lanes with a game (at the end, there aren't enough games for every lane)
+    unsigned active = 0;
+
+    std::array<unsigned, BATCH_LANES> seeds;
+
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        active |= static_cast<unsigned>(start_lane_game(a, i_game_count, i_seed, *state, seeds[a])) << a;
+    }
+
+    state->batch.reset(i_replica.maze, 0, i_replica.level_settings, seeds);
+
+    while (active != 0) {
+        for (unsigned char a = 0; a < BATCH_LANES; a++) {
+            state->inputs[a] = 1 & (active >> a) ? get_random_input(state->players[a]) : 0;
+        }
+
+        state->batch.update(state->inputs);
+
+        for (unsigned char a = 0; a < BATCH_LANES; a++) {
+            if ((1 & (active >> a)) == 0) {
+                continue;
+            }
+
+            state->results.ticks++;
+            state->lane_ticks[a]++;
+
+            bool timeout = i_max_ticks <= state->lane_ticks[a];
+
+            if (1 & (state->batch.get_playing() >> a) && !timeout) {
+                continue;
+            }
+
+            state->results.deaths += state->batch.get_pacman_dead(a);
+            state->results.games++;
+            state->results.wins += state->batch.get_game_won(a);
+            state->results.timeouts += 1 & (state->batch.get_playing() >> a);
+
+            unsigned seed;
+
+            if (start_lane_game(a, i_game_count, i_seed, *state, seed)) {
+                state->batch.reset_lane(a, seed);
+            }
+            else {
+                active &= ~(1u << a);
+            }
+        }
+    }
+
+    i_results = state->results;
+    i_results.huge_pages = huge_pages;
+
+    state->~WorkerState();
+
+    munmap(memory, (sizeof(WorkerState) + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    bool huge_pages = 0;
+    bool pin = 1;
+
+    unsigned long long game_count = 100000;
+
+    unsigned max_ticks = 20000;
+    unsigned seed = 1;
+    unsigned worker_count = 0;
+
+    // The mazes from "--maze" (we play the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--games") {
+            game_count = std::stoull(i_arguments[1 + a]);
+        }
+        else if (argument == "--huge-pages") {
+            huge_pages = std::stoi(i_arguments[1 + a]) != 0;
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+        }
+        else if (argument == "--max-ticks") {
+            max_ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--pin") {
+            pin = std::stoi(i_arguments[1 + a]) != 0;
+        }
+        else if (argument == "--seed") {
+            seed = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--workers") {
+            worker_count = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    const std::vector<std::string>& maze = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    if (const char* error = validate_maze(maze)) {
+        std::printf("The maze is wrong: %s\n", error);
+
+        return 1;
+    }
+
+    std::vector<PhysicalCore> cores = get_physical_cores();
+
+    if (0 < worker_count && worker_count < cores.size()) {
+        cores.resize(worker_count);
+    }
+
+    unsigned short node_count = 0;
+
+    for (PhysicalCore& core : cores) {
+        node_count = std::max<unsigned short>(node_count, 1 + core.node);
+
+        core.cpu = pin ? core.cpu : -1;
+    }
+
+    // A once_flag can't be moved, so the replicas stay where they are
+    std::vector<std::unique_ptr<NodeReplica>> replicas;
+
+    for (unsigned short a = 0; a < node_count; a++) {
+        replicas.push_back(std::unique_ptr<NodeReplica>(new NodeReplica()));
+    }
+
+    std::vector<BatchRunnerResults> results(cores.size(), BatchRunnerResults());
+    std::vector<std::thread> threads;
+
+    std::printf("Playing %llu games on %zu workers (%u games per batch) on %u nodes%s.\n", game_count, cores.size(), BATCH_LANES, node_count, pin ? "" : ", not pinned");
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    for (unsigned a = 0; a < cores.size(); a++) {
+        threads.push_back(std::thread(run_worker, game_count, seed, max_ticks, huge_pages, std::cref(cores[a]), std::cref(maze), std::ref(*replicas[cores[a].node]), std::ref(results[a])));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // Add up the workers of every node
+    std::vector<BatchRunnerResults> node_results(node_count, BatchRunnerResults());
+    std::vector<unsigned> node_workers(node_count, 0);
+
+    BatchRunnerResults totals = {};
+
+    unsigned huge_page_workers = 0;
+
+    for (unsigned a = 0; a < cores.size(); a++) {
+        BatchRunnerResults& node = node_results[cores[a].node];
+
+        node.deaths += results[a].deaths;
+        node.games += results[a].games;
+        node.ticks += results[a].ticks;
+        node.timeouts += results[a].timeouts;
+        node.wins += results[a].wins;
+
+        node_workers[cores[a].node]++;
+
+        huge_page_workers += results[a].huge_pages;
+    }
+
+    std::printf("Node  Workers      Games/s      Ticks/s  Ticks/s per worker\n");
+
+    for (unsigned short a = 0; a < node_count; a++) {
+        if (node_workers[a] == 0) {
+            continue;
+        }
+
+        std::printf("%4u  %7u  %11.0f  %11.0f  %18.0f\n", a, node_workers[a], node_results[a].games / duration, node_results[a].ticks / duration, node_results[a].ticks / duration / node_workers[a]);
+
+        totals.deaths += node_results[a].deaths;
+        totals.games += node_results[a].games;
+        totals.ticks += node_results[a].ticks;
+        totals.timeouts += node_results[a].timeouts;
+        totals.wins += node_results[a].wins;
+    }
+
+    std::printf("All   %7zu  %11.0f  %11.0f  %18.0f\n", cores.size(), totals.games / duration, totals.ticks / duration, totals.ticks / duration / cores.size());
+    std::printf("%llu games in %.2f s: %llu won, %llu lost, %llu reached %u ticks.\n", totals.games, duration, totals.wins, totals.deaths, totals.timeouts, max_ticks);
+
+    if (huge_pages) {
+        std::printf("%u of %zu workers got reserved huge pages (the others asked for transparent ones).\n", huge_page_workers, cores.size());
+    }
+
+    if (totals.games != game_count) {
+        std::printf("FAILED: only %llu of the games were played.\n", totals.games);
+
+        return 1;
+    }
+}
@@ -0,0 +1,199 @@
+// A tiny bot for BotHost, to show how the bridge is used (Linux only, see Headers/BotBridge.hpp).
+// It reads every observation in place and answers right away: at every crossing it picks a way with a pellet next to it, or a random way if there's none. It restarts when the game ends.
+// It only needs the bridge (and the random numbers), not the simulation, so a bot in another language (a Python trainer with mmap, for example) can do the same thing.
+// Usage: BotClient [--name <shared memory name>] [--ticks <ticks>]
+// With --ticks, it closes the bridge after answering that many observations. It prints how many it answered per second.
+
+#include <array>      // For std::array
+#include <atomic>     // For the shared counters
+#include <chrono>     // For the ticks per second
+#include <cstdio>     // For printing the results
+#include <ctime>      // For clock_gettime
+#include <string>     // For the command line arguments
+#include <thread>     // For waiting for the host and for std::thread::hardware_concurrency
+#include <fcntl.h>    // For O_RDWR
+#include <linux/futex.h> // For FUTEX_WAIT and FUTEX_WAKE
+#include <sys/mman.h> // For shm_open and mmap
+#include <sys/stat.h> // For fstat
+#include <sys/syscall.h> // For SYS_futex
+#include <unistd.h>   // For close and syscall
+
+#include "../Headers/Global.hpp"    // Header for global constants and definitions
+#include "../Headers/Random.hpp"    // Header for the deterministic random number generator
+#include "../Headers/BotBridge.hpp" // Header for the shared memory layout
+
+// How long we sleep before checking if the host closed the bridge (in milliseconds)
+constexpr unsigned short CLOSED_POLL = 100;
+
+// The cell next to (i_x, i_y) in i_direction
+// Left and right of the map are the tunnels. (The game doesn't stop Pacman from leaving a tunnel up or down, but he gets stuck there, so we call that a wall.)
+static Cell get_neighbor(unsigned char i_direction, int i_x, int i_y, const BotBridge& i_bridge, const Cell* i_plane) {
+    int x = i_x + (i_direction == 0) - (i_direction == 2);
+    int y = i_y + (i_direction == 3) - (i_direction == 1);
+
+    if (y < 0 || y >= i_bridge.map_height || ((x < 0 || x >= i_bridge.map_width) && i_direction % 2 == 1)) {
+        return Cell::Wall;
+    }
+
+    if (x < 0 || x >= i_bridge.map_width) {
+        return Cell::Empty;
+    }
+
+    return i_plane[x + i_bridge.map_width * y];
+}
+
+// Pick the input for an observation
+static unsigned char get_input(const BotObservation& i_observation, const BotBridge& i_bridge, const Cell* i_plane, unsigned& i_random_state) {
+    if (i_observation.game_won || i_observation.pacman_dead) {
+        return INPUT_RESTART;
+    }
+
+    // Between two cells Pacman can only go on (or back)
+    if (i_observation.pacman_position.x % CELL_SIZE != 0 || i_observation.pacman_position.y % CELL_SIZE != 0) {
+        return static_cast<unsigned char>(1 << i_observation.pacman_direction);
+    }
+
+    int x = i_observation.pacman_position.x / CELL_SIZE;
+    int y = i_observation.pacman_position.y / CELL_SIZE;
+
+    // The ways we can go (without turning back), and the ones with a pellet
+    unsigned char open = 0;
+    unsigned char food = 0;
+
+    for (unsigned char a = 0; a < 4; a++) {
+        Cell cell = get_neighbor(a, x, y, i_bridge, i_plane);
+
+        if (a == (2 + i_observation.pacman_direction) % 4 || Cell::Wall == cell || Cell::Door == cell) {
+            continue;
+        }
+
+        open |= 1 << a;
+
+        if (Cell::Pellet == cell || Cell::Energizer == cell) {
+            food |= 1 << a;
+        }
+    }
+
+    unsigned char choices = food == 0 ? open : food;
+
+    // A dead end
+    if (choices == 0) {
+        return static_cast<unsigned char>(1 << (2 + i_observation.pacman_direction) % 4);
+    }
+
+    // A random one of the choices
+    while (1) {
+        unsigned char direction = static_cast<unsigned char>(get_random(i_random_state) % 4);
+
+        if (choices & (1 << direction)) {
+            return static_cast<unsigned char>(1 << direction);
+        }
+    }
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    // 0 means until the host closes the bridge
+    unsigned ticks = 0;
+    unsigned answered = 0;
+    unsigned random_state = seed_random(1, 0);
+    unsigned spin_count = 1 < std::thread::hardware_concurrency() ? BOT_SPIN_COUNT : 0;
+
+    std::string name = BOT_BRIDGE_NAME;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--name") {
+            name = i_arguments[1 + a];
+        }
+        else if (argument == "--ticks") {
+            ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    // The host may not be there yet
+    int file = shm_open(name.c_str(), O_RDWR, 0);
+
+    while (file == -1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(CLOSED_POLL));
+
+        file = shm_open(name.c_str(), O_RDWR, 0);
+    }
+
+    struct stat file_status;
+
+    // The host sets the size right after creating it
+    do {
+        fstat(file, &file_status);
+    } while (static_cast<unsigned long>(file_status.st_size) < sizeof(BotBridge));
+
+    void* memory = mmap(nullptr, file_status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+    close(file);
+
+    if (memory == MAP_FAILED) {
+        std::printf("Can't map the shared memory %s.\n", name.c_str());
+
+        return 1;
+    }
+
+    BotBridge& bridge = *static_cast<BotBridge*>(memory);
+
+    // The host writes the magic number last
+    while (bridge.magic.load(std::memory_order_acquire) != BOT_BRIDGE_MAGIC) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (bridge.version != BOT_BRIDGE_VERSION || static_cast<unsigned long>(file_status.st_size) != get_bot_bridge_size(bridge.map_width, bridge.map_height)) {
+        std::printf("The bridge %s was made by another version of BotHost.\n", name.c_str());
+
+        munmap(memory, file_status.st_size);
+
+        return 1;
+    }
+
+    const Cell* plane = get_bot_map(bridge);
+
+    std::printf("Playing on %s (%ux%u map).\n", name.c_str(), bridge.map_width, bridge.map_height);
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    while (!bridge.closed && (ticks == 0 || answered < ticks)) {
+        timespec deadline;
+
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        deadline.tv_sec += CLOSED_POLL / 1000;
+        deadline.tv_nsec += 1000000l * (CLOSED_POLL % 1000);
+        deadline.tv_sec += deadline.tv_nsec / 1000000000;
+        deadline.tv_nsec %= 1000000000;
+
+        const BotObservation* observation = wait_for_message(bridge.observations, spin_count, &deadline);
+
+        if (observation == nullptr) {
+            continue;
+        }
+
+        BotAction* action = get_free_slot(bridge.actions);
+
+        // The host always reads our answers before the next observation, so this only happens if it's gone
+        if (action != nullptr) {
+            action->frame = observation->frame;
+            action->input = get_input(*observation, bridge, plane, random_state);
+
+            push_message(bridge.actions);
+        }
+
+        pop_message(bridge.observations);
+
+        answered++;
+    }
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    bridge.closed = 1;
+
+    munmap(memory, file_status.st_size);
+
+    std::printf("Answered %u observations in %.2f s (%.0f per second).\n", answered, duration, answered / duration);
+}
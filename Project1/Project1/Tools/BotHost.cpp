@@ -0,0 +1,303 @@
+// Runs the game without a window for a bot in another process (Linux only, it uses shared memory and futexes, see Headers/BotBridge.hpp).
+// After every tick it writes an observation into the shared memory and waits for the bot's action until the deadline. If the action is late, Pacman keeps doing what the last one said.
+// The game doesn't wait for a clock, so it runs as fast as the bot answers. The first observation waits for the bot as long as it takes.
+// Usage: BotHost [--name <shared memory name>] [--maze <file>] [--ticks <ticks>] [--deadline <microseconds>] [--ghost-radius <cells>]
+// Without --ticks, it plays until the bot closes the bridge (or Ctrl+C).
+
+#include <algorithm>  // For std::max and std::min
+#include <array>      // For std::array
+#include <atomic>     // For stopping and for the shared counters
+#include <chrono>     // For timing the ticks
+#include <csignal>    // For stopping with Ctrl+C
+#include <cstdio>     // For printing the statistics
+#include <ctime>      // For clock_gettime
+#include <new>        // For placement new
+#include <string>     // For the command line arguments
+#include <thread>     // For std::thread::hardware_concurrency
+#include <vector>     // For std::vector
+#include <fcntl.h>    // For O_CREAT
+#include <linux/futex.h> // For FUTEX_WAIT and FUTEX_WAKE
+#include <sys/mman.h> // For shm_open and mmap
+#include <sys/syscall.h> // For SYS_futex
+#include <unistd.h>   // For ftruncate, close and syscall
+#include <SFML/Graphics.hpp> // SFML graphics library (the game can draw itself, but we never ask it to)
+
+#include "../Headers/Global.hpp"        // Header for global constants and definitions
+#include "../Headers/Map.hpp"           // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"        // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"         // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"  // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"   // Header for drawing the game map
+#include "../Headers/Game.hpp"          // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"     // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp" // Header for loading maze files
+#include "../Headers/BotBridge.hpp"     // Header for the shared memory layout
+
+// While we wait for the first action, we check for Ctrl+C this often (in milliseconds)
+constexpr unsigned short FIRST_ACTION_POLL = 100;
+
+// Ctrl+C sets this to 0
+static std::atomic<bool> running(1);
+
+static void stop(int) {
+    running = 0;
+}
+
+// The point in time i_microseconds from now
+static timespec get_deadline(unsigned i_microseconds) {
+    timespec deadline;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    deadline.tv_nsec += 1000l * (i_microseconds % 1000000);
+    deadline.tv_sec += i_microseconds / 1000000 + deadline.tv_nsec / 1000000000;
+    deadline.tv_nsec %= 1000000000;
+
+    return deadline;
+}
+
+// Copy the chunks that changed since the last time into the map plane
+// Only Pacman changes the map while playing, so most ticks only look at the chunks around him. A new level can change all of them.
+static void update_map_plane(bool i_everything, const Position& i_pacman_position, Map& i_map, std::vector<unsigned long long>& i_chunk_versions, Cell* i_plane) {
+    int first_x = 0;
+    int first_y = 0;
+    int last_x = i_map.get_chunk_columns() - 1;
+    int last_y = i_map.get_chunk_rows() - 1;
+
+    if (!i_everything) {
+        // Pacman can be a bit outside the map in the tunnels
+        int chunk_x = std::max(0, std::min(last_x, i_pacman_position.x / (CELL_SIZE * CHUNK_SIZE)));
+        int chunk_y = std::max(0, std::min(last_y, i_pacman_position.y / (CELL_SIZE * CHUNK_SIZE)));
+
+        first_x = std::max(0, chunk_x - 1);
+        first_y = std::max(0, chunk_y - 1);
+        last_x = std::min(last_x, 1 + chunk_x);
+        last_y = std::min(last_y, 1 + chunk_y);
+    }
+
+    for (int a = first_y; a <= last_y; a++) {
+        for (int b = first_x; b <= last_x; b++) {
+            unsigned long long version = i_map.get_chunk_version(static_cast<unsigned short>(b), static_cast<unsigned short>(a));
+
+            if (i_chunk_versions[b + i_map.get_chunk_columns() * a] == version) {
+                continue;
+            }
+
+            i_chunk_versions[b + i_map.get_chunk_columns() * a] = version;
+
+            // The last chunks of a row or a column can stick out of the map
+            int end_x = std::min<int>(i_map.get_width(), CHUNK_SIZE * (1 + b));
+            int end_y = std::min<int>(i_map.get_height(), CHUNK_SIZE * (1 + a));
+
+            for (int c = CHUNK_SIZE * a; c < end_y; c++) {
+                for (int d = CHUNK_SIZE * b; d < end_x; d++) {
+                    i_plane[d + i_map.get_width() * c] = i_map.get_cell(static_cast<unsigned short>(d), static_cast<unsigned short>(c));
+                }
+            }
+        }
+    }
+}
+
+// Write what the game looks like into an observation
+static void write_observation(unsigned i_frame, Game& i_game, BotObservation& i_observation) {
+    std::array<Ghost, 4>& ghosts = i_game.get_ghost_manager().get_ghosts();
+
+    i_observation.game_won = i_game.get_game_won();
+    i_observation.pacman_dead = i_game.get_pacman().get_dead();
+    i_observation.level = i_game.get_level();
+    i_observation.pacman_direction = i_game.get_pacman().get_direction();
+    i_observation.energizer_timer = i_game.get_pacman().get_energizer_timer();
+    i_observation.frame = i_frame;
+    i_observation.pellet_count = i_game.get_map().get_pellet_count();
+    i_observation.hash = i_game.get_hash();
+    i_observation.pacman_position = i_game.get_pacman().get_position();
+
+    for (unsigned char a = 0; a < 4; a++) {
+        i_observation.ghost_movement_modes[a] = ghosts[a].get_movement_mode();
+        i_observation.ghost_directions[a] = ghosts[a].get_direction();
+        i_observation.ghost_frightened_modes[a] = ghosts[a].get_frightened_mode();
+        i_observation.ghost_positions[a] = ghosts[a].get_position();
+    }
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned char input = 0;
+
+    unsigned short ghost_radius = 0;
+
+    // 0 means until the bot closes the bridge
+    unsigned ticks = 0;
+    unsigned deadline_duration = 1000;
+    // How many actions came after their deadline, and how many observations didn't fit in the ring
+    unsigned late_actions = 0;
+    unsigned lost_observations = 0;
+    // Spinning on a single core only keeps the bot from running
+    unsigned spin_count = 1 < std::thread::hardware_concurrency() ? BOT_SPIN_COUNT : 0;
+
+    std::string name = BOT_BRIDGE_NAME;
+
+    // The mazes from "--maze" (we play the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--deadline") {
+            deadline_duration = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--ghost-radius") {
+            ghost_radius = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+
+            const char* error = validate_maze(mazes[0]);
+
+            if (error != nullptr) {
+                std::printf("Can't play the maze in %s: %s\n", i_arguments[1 + a], error);
+
+                return 1;
+            }
+        }
+        else if (argument == "--name") {
+            name = i_arguments[1 + a];
+        }
+        else if (argument == "--ticks") {
+            ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    Game game(0, 1, mazes.empty() ? get_map_sketch() : mazes[0]);
+
+    game.set_ghost_simulation_radius(ghost_radius);
+
+    Map& map = game.get_map();
+
+    unsigned long size = get_bot_bridge_size(map.get_width(), map.get_height());
+
+    // A bridge left behind by a host that crashed would confuse the bot
+    shm_unlink(name.c_str());
+
+    int file = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if (file == -1 || ftruncate(file, size) == -1) {
+        std::printf("Can't create the shared memory %s.\n", name.c_str());
+
+        return 1;
+    }
+
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+    close(file);
+
+    if (memory == MAP_FAILED) {
+        std::printf("Can't map the shared memory %s.\n", name.c_str());
+
+        shm_unlink(name.c_str());
+
+        return 1;
+    }
+
+    // The counters and the slots start at 0
+    BotBridge& bridge = *new (memory) BotBridge();
+
+    Cell* plane = get_bot_map(bridge);
+
+    // The chunk versions we copied into the plane
+    std::vector<unsigned long long> chunk_versions(map.get_chunk_columns() * map.get_chunk_rows(), 0);
+
+    bridge.map_height = map.get_height();
+    bridge.map_width = map.get_width();
+    bridge.version = BOT_BRIDGE_VERSION;
+
+    update_map_plane(1, game.get_pacman().get_position(), map, chunk_versions, plane);
+
+    // The bot waits for this, so everything else must be ready
+    bridge.magic.store(BOT_BRIDGE_MAGIC, std::memory_order_release);
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+
+    std::printf("Waiting for a bot on %s (%ux%u map).\n", name.c_str(), map.get_width(), map.get_height());
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time;
+
+    unsigned frame = 0;
+
+    for (; running && !bridge.closed && (ticks == 0 || frame < ticks); frame++) {
+        BotObservation* observation = get_free_slot(bridge.observations);
+
+        // The bot is too far behind to read it, so it only gets the newer ones
+        if (observation == nullptr) {
+            lost_observations++;
+        }
+        else {
+            write_observation(frame, game, *observation);
+            push_message(bridge.observations);
+        }
+
+        bool answered = 0;
+
+        timespec deadline = get_deadline(frame == 0 ? FIRST_ACTION_POLL * 1000u : deadline_duration);
+
+        // Old answers still change the input, so the newest one wins
+        while (!answered) {
+            const BotAction* action = wait_for_message(bridge.actions, spin_count, &deadline);
+
+            if (action == nullptr) {
+                // The first observation waits as long as it takes
+                if (frame == 0 && running && !bridge.closed) {
+                    deadline = get_deadline(FIRST_ACTION_POLL * 1000u);
+
+                    continue;
+                }
+
+                break;
+            }
+
+            answered = action->frame == frame;
+            input = action->input;
+
+            pop_message(bridge.actions);
+        }
+
+        if (frame == 0) {
+            // Ctrl+C before the bot came
+            if (!answered) {
+                break;
+            }
+
+            std::printf("The bot is here.\n");
+
+            start_time = std::chrono::steady_clock::now();
+        }
+        else if (!answered) {
+            late_actions++;
+        }
+
+        // Starting the next level rewrites the whole map
+        bool level_start = game.get_game_won() || game.get_pacman().get_dead();
+
+        game.update(input, 0);
+
+        update_map_plane(level_start, game.get_pacman().get_position(), map, chunk_versions, plane);
+    }
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    bridge.closed = 1;
+
+    munmap(memory, size);
+    shm_unlink(name.c_str());
+
+    if (0 < frame) {
+        std::printf("%u ticks in %.2f s (%.0f ticks per second), level %u at the end.\n", frame, duration, frame / std::max(duration, 1e-9), 1 + game.get_level());
+        std::printf("Late actions: %u | Observations the bot didn't have room for: %u\n", late_actions, lost_observations);
+    }
+}
@@ -0,0 +1,194 @@
+// Prints a flight recording (see Headers/FlightRecorder.hpp): flight.bin after a crash, or a flight_slow_<tick>.bin copy.
+// One line per tick, from the oldest to the newest: the durations, the input, what happened, then Pacman and every ghost (position, direction, state and target).
+// With --stuck, it only prints the ghosts that didn't move for that many ticks while the game was running (where they were, where they wanted to go, and if they could use the door).
+// Usage: FlightDump <file> [--last <ticks>] [--stuck <ticks>]
+
+#include <algorithm> // For std::min
+#include <array>  // For std::array
+#include <cstdio> // For reading the file and printing the records
+#include <string> // For the command line arguments
+#include <vector> // For std::vector
+#include <SFML/Graphics.hpp> // SFML graphics library (the game can draw itself, but we never ask it to)
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/FlightRecorder.hpp" // Header for the flight recording format
+
+constexpr std::array<const char*, 6> EVENT_NAMES = { "energizer", "ghost-eaten", "level-start", "level-won", "pacman-died", "slow-tick" };
+
+constexpr std::array<const char*, 3> FRIGHTENED_MODE_NAMES = { "normal", "frightened", "eaten" };
+
+// The letters of the directions (right, up, left, down), and of the inputs in the same order
+constexpr std::array<char, 4> DIRECTION_LETTERS = { 'R', 'U', 'L', 'D' };
+
+static std::string get_input_name(unsigned char i_input) {
+    std::string output;
+
+    for (unsigned char a = 0; a < 4; a++) {
+        if (i_input & (1 << a)) {
+            output += DIRECTION_LETTERS[a];
+        }
+    }
+
+    if (i_input & INPUT_RESTART) {
+        output += "+restart";
+    }
+
+    return output.empty() ? "-" : output;
+}
+
+static std::string get_state_name(unsigned char i_state) {
+    std::string output = FRIGHTENED_MODE_NAMES[std::min(2, i_state & 3)];
+
+    if (i_state & FLIGHT_GHOST_CHASE) {
+        output += ",chase";
+    }
+
+    if (i_state & FLIGHT_GHOST_USE_DOOR) {
+        output += ",door";
+    }
+
+    return output;
+}
+
+static void print_record(const FlightRecord& i_record) {
+    std::printf("%8u | tick %5u us, frame %5u us | level %2u, wave %u (%5u) | input %-4s ghost %-4s | Pacman %4d,%4d %c",
+        i_record.frame, i_record.tick_duration, i_record.frame_duration, 1 + i_record.level, i_record.wave, i_record.wave_timer,
+        get_input_name(i_record.input).c_str(), get_input_name(i_record.ghost_input).c_str(),
+        i_record.pacman_position.x, i_record.pacman_position.y, DIRECTION_LETTERS[i_record.pacman_direction % 4]);
+
+    if (i_record.energizer_timer != 0) {
+        std::printf(" (energized %u)", i_record.energizer_timer);
+    }
+
+    for (unsigned char a = 0; a < 4; a++) {
+        std::printf(" | %u: %4d,%4d %c %s -> %d,%d", a, i_record.ghost_positions[a].x, i_record.ghost_positions[a].y,
+            DIRECTION_LETTERS[i_record.ghost_directions[a] % 4], get_state_name(i_record.ghost_states[a]).c_str(),
+            i_record.ghost_targets[a].x, i_record.ghost_targets[a].y);
+    }
+
+    for (unsigned char a = 0; a < EVENT_NAMES.size(); a++) {
+        if (i_record.events & (1 << a)) {
+            std::printf(" [%s]", EVENT_NAMES[a]);
+        }
+    }
+
+    std::printf("\n");
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned last = 0;
+    unsigned stuck = 0;
+
+    if (i_argument_count < 2) {
+        std::printf("Usage: FlightDump <file> [--last <ticks>] [--stuck <ticks>]\n");
+
+        return 1;
+    }
+
+    for (int a = 2; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--last") {
+            last = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--stuck") {
+            stuck = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    std::FILE* file = std::fopen(i_arguments[1], "rb");
+
+    if (file == nullptr) {
+        std::printf("Can't open %s.\n", i_arguments[1]);
+
+        return 1;
+    }
+
+    FlightHeader header;
+
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != FLIGHT_MAGIC) {
+        std::printf("%s isn't a flight recording.\n", i_arguments[1]);
+
+        std::fclose(file);
+
+        return 1;
+    }
+
+    if (header.version != FLIGHT_VERSION || header.record_size != sizeof(FlightRecord)) {
+        std::printf("%s was recorded by another version of the game.\n", i_arguments[1]);
+
+        std::fclose(file);
+
+        return 1;
+    }
+
+    std::vector<FlightRecord> ring(header.capacity);
+
+    // The file has its full size from the start, so a short one was cut by something else
+    bool complete = std::fread(ring.data(), sizeof(FlightRecord), ring.size(), file) == ring.size();
+
+    std::fclose(file);
+
+    if (!complete) {
+        std::printf("%s is shorter than its header says.\n", i_arguments[1]);
+
+        return 1;
+    }
+
+    unsigned long long count = std::min<unsigned long long>(header.record_count, ring.size());
+
+    if (last != 0) {
+        count = std::min<unsigned long long>(count, last);
+    }
+
+    std::printf("%llu ticks recorded, the last %llu of them are in the file.\n", header.record_count, std::min<unsigned long long>(header.record_count, ring.size()));
+
+    if (header.slow_frame != 0) {
+        std::printf("The last slow tick was tick %u.\n", header.slow_frame);
+    }
+
+    if (header.crash_signal != 0) {
+        std::printf("The game crashed with signal %d after the last tick.\n", header.crash_signal);
+    }
+
+    // How many ticks every ghost has been standing still
+    std::array<unsigned, 4> still_ticks{};
+
+    for (unsigned long long a = header.record_count - count; a < header.record_count; a++) {
+        const FlightRecord& record = ring[a % header.capacity];
+
+        if (stuck == 0) {
+            print_record(record);
+
+            continue;
+        }
+
+        const FlightRecord& previous_record = ring[(a - 1) % header.capacity];
+
+        for (unsigned char b = 0; b < 4; b++) {
+            // Nobody moves between levels
+            if (a == header.record_count - count || record.flags != 0 || record.ghost_positions[b].x != previous_record.ghost_positions[b].x || record.ghost_positions[b].y != previous_record.ghost_positions[b].y) {
+                still_ticks[b] = 0;
+
+                continue;
+            }
+
+            still_ticks[b]++;
+
+            // Once per stop
+            if (still_ticks[b] == stuck) {
+                std::printf("Ghost %u stood still at %d,%d for %u ticks up to tick %u (%s, target %d,%d).\n", b,
+                    record.ghost_positions[b].x, record.ghost_positions[b].y, stuck, record.frame,
+                    get_state_name(record.ghost_states[b]).c_str(), record.ghost_targets[b].x, record.ghost_targets[b].y);
+            }
+        }
+    }
+}
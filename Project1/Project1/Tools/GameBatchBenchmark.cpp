@@ -0,0 +1,282 @@
+// Compares GameBatch, that plays BATCH_LANES games in lockstep, with playing them one Game at a time.
+// Every game gets its own seed and random inputs, and a lane starts the next game as soon as its game is over (games end at very different times).
+// First we play every lane next to a Game and check that they agree after every tick (with the plain kernels, and with the AVX2 ones when they're compiled in).
+// Then we time both ways, and fail if the batch is slower.
+// Usage: GameBatchBenchmark [--games <count>] [--maze <file>] [--seed <seed>] [--max-ticks <ticks>]
+
+#include <algorithm> // For std::min
+#include <array>     // For std::array
+#include <chrono>    // For timing the games
+#include <cstdio>    // For printing the results
+#include <string>    // For std::string
+#include <vector>    // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components (the game's headers need them)
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/GameBatch.hpp"      // Header for the GameBatch class definition
+#include "../Headers/MapSketch.hpp"      // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp"  // Header for loading maze files
+#include "../Headers/Random.hpp"         // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"        // Header for the random player
+
+// We measure this many times and keep the fastest, so the other programs on the computer don't decide the result
+constexpr unsigned char MEASUREMENTS = 3;
+
+// Check that a lane of the batch is the same game as i_game (we print the first difference)
+static bool check_lane(GameBatch& i_batch, unsigned char i_lane, Game& i_game) {
+    Pacman& pacman = i_game.get_pacman();
+    GhostManager& ghost_manager = i_game.get_ghost_manager();
+
+    if (i_batch.get_game_won(i_lane) != i_game.get_game_won() || i_batch.get_pacman_dead(i_lane) != pacman.get_dead()) {
+        std::printf("The game didn't end the same way.\n");
+
+        return 0;
+    }
+
+    if (!(i_batch.get_pacman_position(i_lane) == pacman.get_position()) || i_batch.get_pacman_direction(i_lane) != pacman.get_direction() || i_batch.get_energizer_timer(i_lane) != pacman.get_energizer_timer()) {
+        std::printf("Pacman is different.\n");
+
+        return 0;
+    }
+
+    if (i_batch.get_pellet_count(i_lane) != i_game.get_map().get_pellet_count()) {
+        std::printf("Pacman ate different pellets.\n");
+
+        return 0;
+    }
+
+    if (i_batch.get_current_wave(i_lane) != ghost_manager.get_current_wave() || i_batch.get_wave_timer(i_lane) != ghost_manager.get_wave_timer()) {
+        std::printf("The waves are different.\n");
+
+        return 0;
+    }
+
+    for (unsigned char a = 0; a < 4; a++) {
+        Ghost& ghost = ghost_manager.get_ghosts()[a];
+
+        const BatchGhosts& ghosts = i_batch.get_ghosts(a);
+
+        bool same = ghosts.x[i_lane] == ghost.get_position().x && ghosts.y[i_lane] == ghost.get_position().y &&
+            ghosts.direction[i_lane] == ghost.get_direction() &&
+            ghosts.frightened_mode[i_lane] == ghost.get_frightened_mode() &&
+            ghosts.use_door[i_lane] == ghost.get_use_door() &&
+            i_batch.get_movement_mode(i_lane) == ghost.get_movement_mode();
+
+        // Outside the house, the target is picked again in every tick, so only the one in the house is part of the game
+        same &= !ghost.get_use_door() || (ghosts.target_x[i_lane] == ghost.get_target().x && ghosts.target_y[i_lane] == ghost.get_target().y);
+
+        if (!same) {
+            std::printf("Ghost %u is different.\n", a);
+
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// Play every game one at a time, and count the ticks
+static unsigned long long play_games(unsigned i_game_count, unsigned i_seed, unsigned i_max_ticks, const std::vector<std::string>& i_maze) {
+    unsigned long long output = 0;
+
+    for (unsigned a = 0; a < i_game_count; a++) {
+        Game game(0, a + i_seed, i_maze);
+
+        RandomPlayer player = get_random_player(a + i_seed);
+
+        for (unsigned b = 0; b < i_max_ticks && !game.get_game_won() && !game.get_pacman().get_dead(); b++) {
+            game.update(get_random_input(player), 0);
+
+            output++;
+        }
+    }
+
+    return output;
+}
+
+// Play the same games in batches, starting the next game in a lane as soon as it's free, and count the ticks of the games (not the ticks of the batch)
+// With i_check, we also play every game in a Game next to its lane, and check them after every tick (then we return 0 if they don't agree)
+static unsigned long long play_batches(bool i_simd, bool i_check, unsigned i_game_count, unsigned i_seed, unsigned i_max_ticks, const std::vector<std::string>& i_maze) {
+    // The lanes with a game we still care about (a game that reached i_max_ticks is still playing in the batch, but we're done with it)
+    unsigned active = 0;
+    unsigned next_game = 0;
+
+    unsigned long long output = 0;
+
+    std::array<unsigned, BATCH_LANES> lane_ticks = {};
+    std::array<unsigned, BATCH_LANES> seeds;
+
+    std::array<unsigned char, BATCH_LANES> inputs = {};
+
+    std::array<RandomPlayer, BATCH_LANES> players;
+
+    std::vector<Game> games;
+
+    GameBatch batch;
+
+    for (unsigned char a = 0; a < BATCH_LANES; a++) {
+        seeds[a] = std::min<unsigned>(a, i_game_count) + i_seed;
+        players[a] = get_random_player(seeds[a]);
+
+        if (i_check) {
+            games.push_back(Game(0, seeds[a], i_maze));
+        }
+
+        active |= static_cast<unsigned>(a < i_game_count) << a;
+    }
+
+    next_game = std::min<unsigned>(BATCH_LANES, i_game_count);
+
+    batch.set_simd(i_simd);
+    batch.reset(i_maze, 0, get_level_settings(0), seeds);
+
+    while (active != 0) {
+        for (unsigned char a = 0; a < BATCH_LANES; a++) {
+            inputs[a] = 1 & (active >> a) ? get_random_input(players[a]) : 0;
+        }
+
+        batch.update(inputs);
+
+        for (unsigned char a = 0; a < BATCH_LANES; a++) {
+            if ((1 & (active >> a)) == 0) {
+                continue;
+            }
+
+            output++;
+            lane_ticks[a]++;
+
+            if (i_check) {
+                games[a].update(inputs[a], 0);
+
+                if (!check_lane(batch, a, games[a])) {
+                    std::printf("(Seed %u, tick %u.)\n", seeds[a], lane_ticks[a]);
+
+                    return 0;
+                }
+            }
+
+            if (1 & (batch.get_playing() >> a) && lane_ticks[a] < i_max_ticks) {
+                continue;
+            }
+
+            // The game is over, so the next one takes the lane
+            if (next_game == i_game_count) {
+                active &= ~(1u << a);
+
+                continue;
+            }
+
+            seeds[a] = next_game + i_seed;
+            players[a] = get_random_player(seeds[a]);
+            lane_ticks[a] = 0;
+
+            next_game++;
+
+            batch.reset_lane(a, seeds[a]);
+
+            if (i_check) {
+                games[a] = Game(0, seeds[a], i_maze);
+            }
+        }
+    }
+
+    return output;
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned game_count = 1024;
+    unsigned max_ticks = 20000;
+    unsigned seed = 1;
+
+    // The mazes from "--maze" (we play the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--games") {
+            game_count = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+        }
+        else if (argument == "--max-ticks") {
+            max_ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--seed") {
+            seed = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    const std::vector<std::string>& maze = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    if (const char* error = validate_maze(maze)) {
+        std::printf("The maze is wrong: %s\n", error);
+
+        return 1;
+    }
+
+    // The plain kernels, then the AVX2 ones (if they're there)
+    std::vector<bool> kernels = { 0 };
+
+    if (GameBatch::get_simd_available()) {
+        kernels.push_back(1);
+    }
+
+    unsigned long long game_ticks = play_games(game_count, seed, max_ticks, maze);
+
+    for (bool simd : kernels) {
+        if (play_batches(simd, 1, game_count, seed, max_ticks, maze) != game_ticks) {
+            std::printf("FAILED: the %s kernels didn't play like Game.\n", simd ? "AVX2" : "plain");
+
+            return 1;
+        }
+
+        std::printf("The %s kernels played %u games like Game (%llu ticks).\n", simd ? "AVX2" : "plain", game_count, game_ticks);
+    }
+
+    // The games, then every kernel
+    std::vector<double> fastest(1 + kernels.size(), 1e9);
+
+    for (unsigned char a = 0; a < MEASUREMENTS; a++) {
+        for (unsigned char b = 0; b < fastest.size(); b++) {
+            std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+            unsigned long long ticks = b == 0 ? play_games(game_count, seed, max_ticks, maze) : play_batches(kernels[b - 1], 0, game_count, seed, max_ticks, maze);
+
+            fastest[b] = std::min(fastest[b], std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+
+            if (ticks != game_ticks) {
+                std::printf("FAILED: %llu ticks instead of %llu.\n", ticks, game_ticks);
+
+                return 1;
+            }
+        }
+    }
+
+    std::printf("Game:              %.0f ticks per second\n", game_ticks / fastest[0]);
+
+    for (unsigned char a = 0; a < kernels.size(); a++) {
+        std::printf("GameBatch (%s): %.0f ticks per second (%.2fx)\n", kernels[a] ? "AVX2 " : "plain", game_ticks / fastest[1 + a], fastest[0] / fastest[1 + a]);
+    }
+
+    if (fastest[0] < *std::min_element(fastest.begin() + 1, fastest.end())) {
+        std::printf("FAILED: the batch is slower than playing one game at a time.\n");
+
+        return 1;
+    }
+
+    std::printf("OK: the batch plays like Game, and faster.\n");
+}
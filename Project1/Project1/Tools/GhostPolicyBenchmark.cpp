@@ -0,0 +1,221 @@
+// Compares the ghost personalities (picked when we compile) with the old switch on the ghost id, that ran for every ghost in every tick.
+// Both pick the targets of the 4 ghosts in the same random situations. We check that they agree, and fail if the personalities are slower.
+// Usage: GhostPolicyBenchmark [--situations <situations>] [--rounds <rounds>]
+
+#include <algorithm> // For std::max and std::min
+#include <array>     // For std::array
+#include <chrono>    // For timing the targets
+#include <cstdio>    // For printing the results
+#include <string>    // For std::string
+#include <tuple>     // For the list of ghost personalities
+#include <vector>    // For std::vector
+#include <SFML/Graphics.hpp> // For the colors of the personalities
+
+#include "../Headers/Global.hpp"             // Header for global constants and definitions
+#include "../Headers/Map.hpp"                // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"      // Header for the per-level settings
+#include "../Headers/GhostPersonalities.hpp" // Header for the ghost personalities
+#include "../Headers/Random.hpp"             // Header for the deterministic random number generator
+
+// We measure this many times and keep the fastest, so the other programs on the computer don't decide the result
+constexpr unsigned char MEASUREMENTS = 7;
+
+// The personalities may be this much slower before we call it a failure (the timer isn't perfect)
+constexpr float TOLERANCE = 1.05f;
+
+// Everything a ghost needs to pick its target
+struct Situation
+{
+    bool movement_mode;
+
+    unsigned char pacman_direction;
+
+    Position pacman_position;
+
+    std::array<Position, 4> ghost_positions;
+};
+
+// The chase targets are clamped to the pixels of the map (the default map here)
+static Position clamp_target(int i_x, int i_y) {
+    return { static_cast<short>(std::max(0, std::min(CELL_SIZE * (MAP_WIDTH - 1), i_x))), static_cast<short>(std::max(0, std::min(CELL_SIZE * (MAP_HEIGHT - 1), i_y))) };
+}
+
+// The old way: Ghost::update_target switched on the id of the ghost
+static Position get_switch_target(unsigned char i_id, bool i_movement_mode, const Position& i_position, unsigned char i_pacman_direction, const Position& i_ghost_0_position, const Position& i_pacman_position) {
+    Position target = i_pacman_position;
+
+    if (i_movement_mode == 0) {
+        switch (i_id) {
+        case 0: target = { CELL_SIZE * (MAP_WIDTH - 1), 0 }; break;
+        case 1: target = { 0, 0 }; break;
+        case 2: target = { CELL_SIZE * (MAP_WIDTH - 1), CELL_SIZE * (MAP_HEIGHT - 1) }; break;
+        case 3: target = { 0, CELL_SIZE * (MAP_HEIGHT - 1) }; break;
+        }
+    }
+    else {
+        switch (i_id) {
+        case 0:
+            target = i_pacman_position;
+            break;
+
+        case 1:
+            target = i_pacman_position;
+            switch (i_pacman_direction) {
+            case 0: target.x += CELL_SIZE * GHOST_1_CHASE; break;
+            case 1: target.y -= CELL_SIZE * GHOST_1_CHASE; break;
+            case 2: target.x -= CELL_SIZE * GHOST_1_CHASE; break;
+            case 3: target.y += CELL_SIZE * GHOST_1_CHASE; break;
+            }
+            target = clamp_target(target.x, target.y);
+            break;
+
+        case 2:
+            target = i_pacman_position;
+            switch (i_pacman_direction) {
+            case 0: target.x += CELL_SIZE * GHOST_2_CHASE; break;
+            case 1: target.y -= CELL_SIZE * GHOST_2_CHASE; break;
+            case 2: target.x -= CELL_SIZE * GHOST_2_CHASE; break;
+            case 3: target.y += CELL_SIZE * GHOST_2_CHASE; break;
+            }
+            target = clamp_target(target.x, target.y);
+            target = clamp_target(2 * target.x - i_ghost_0_position.x, 2 * target.y - i_ghost_0_position.y);
+            break;
+
+        case 3:
+            int distance = (i_position.x - i_pacman_position.x) * (i_position.x - i_pacman_position.x) + (i_position.y - i_pacman_position.y) * (i_position.y - i_pacman_position.y);
+            if (distance > CELL_SIZE * GHOST_3_CHASE * CELL_SIZE * GHOST_3_CHASE) {
+                target = i_pacman_position;
+            }
+            else {
+                target = { 0, CELL_SIZE * (MAP_HEIGHT - 1) };
+            }
+            break;
+        }
+    }
+
+    return target;
+}
+
+// The new way: the same thing Ghost::update_target does with its personality
+template <typename Personality>
+static Position get_personality_target(const Situation& i_situation, unsigned char i_index, const Map& i_map, const LevelSettings& i_level_settings) {
+    if (i_situation.movement_mode == 0) {
+        return Personality::get_scatter_target(i_map);
+    }
+
+    return Personality::get_chase_target(i_situation.ghost_positions[i_index], i_situation.pacman_direction, i_situation.ghost_positions[0], i_situation.pacman_position, i_map, i_level_settings);
+}
+
+// Mix a target into the checksum, so the compiler can't skip the work
+static unsigned mix(unsigned i_checksum, const Position& i_target) {
+    return 31 * i_checksum + static_cast<unsigned short>(i_target.x) + 65536u * static_cast<unsigned short>(i_target.y);
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned random_state = seed_random(1, 0);
+    unsigned rounds = 200;
+    unsigned situation_count = 65536;
+
+    // The ids are read from memory, like Ghost::id was, so the compiler can't remove the switch
+    volatile unsigned char id_memory[4] = { 0, 1, 2, 3 };
+
+    std::array<unsigned char, 4> ids = { id_memory[0], id_memory[1], id_memory[2], id_memory[3] };
+
+    std::array<double, 2> fastest = { 1e9, 1e9 };
+
+    // The old switch only knew the default map, so the personalities get a map of the same size
+    Map map;
+
+    map.reset(MAP_WIDTH, MAP_HEIGHT);
+
+    // The old switch only knew the chase distances in Global.hpp, and so does the first level
+    const LevelSettings& level_settings = get_level_settings(0);
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--rounds") {
+            rounds = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--situations") {
+            situation_count = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    // Random positions anywhere on the map
+    std::vector<Situation> situations(situation_count);
+
+    for (Situation& situation : situations) {
+        situation.movement_mode = get_random(random_state) % 2;
+        situation.pacman_direction = get_random(random_state) % 4;
+        situation.pacman_position = { static_cast<short>(get_random(random_state) % (CELL_SIZE * MAP_WIDTH)), static_cast<short>(get_random(random_state) % (CELL_SIZE * MAP_HEIGHT)) };
+
+        for (Position& position : situation.ghost_positions) {
+            position = { static_cast<short>(get_random(random_state) % (CELL_SIZE * MAP_WIDTH)), static_cast<short>(get_random(random_state) % (CELL_SIZE * MAP_HEIGHT)) };
+        }
+    }
+
+    // Both ways must pick the same targets (the default personalities are the old ghosts)
+    for (const Situation& situation : situations) {
+        std::array<Position, 4> targets = {
+            get_personality_target<RedGhost>(situation, 0, map, level_settings),
+            get_personality_target<PinkGhost>(situation, 1, map, level_settings),
+            get_personality_target<BlueGhost>(situation, 2, map, level_settings),
+            get_personality_target<OrangeGhost>(situation, 3, map, level_settings)
+        };
+
+        for (unsigned char a = 0; a < 4; a++) {
+            Position target = get_switch_target(ids[a], situation.movement_mode, situation.ghost_positions[a], situation.pacman_direction, situation.ghost_positions[0], situation.pacman_position);
+
+            if (!(target == targets[a])) {
+                std::printf("Ghost %u picked a different target.\n", a);
+
+                return 1;
+            }
+        }
+    }
+
+    std::array<unsigned, 2> checksums = { 0, 0 };
+
+    for (unsigned char a = 0; a < MEASUREMENTS; a++) {
+        std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+        for (unsigned b = 0; b < rounds; b++) {
+            for (const Situation& situation : situations) {
+                for (unsigned char c = 0; c < 4; c++) {
+                    checksums[0] = mix(checksums[0], get_switch_target(ids[c], situation.movement_mode, situation.ghost_positions[c], situation.pacman_direction, situation.ghost_positions[0], situation.pacman_position));
+                }
+            }
+        }
+
+        std::chrono::time_point<std::chrono::steady_clock> middle_time = std::chrono::steady_clock::now();
+
+        for (unsigned b = 0; b < rounds; b++) {
+            for (const Situation& situation : situations) {
+                checksums[1] = mix(checksums[1], get_personality_target<GhostPersonality<0>>(situation, 0, map, level_settings));
+                checksums[1] = mix(checksums[1], get_personality_target<GhostPersonality<1>>(situation, 1, map, level_settings));
+                checksums[1] = mix(checksums[1], get_personality_target<GhostPersonality<2>>(situation, 2, map, level_settings));
+                checksums[1] = mix(checksums[1], get_personality_target<GhostPersonality<3>>(situation, 3, map, level_settings));
+            }
+        }
+
+        std::chrono::time_point<std::chrono::steady_clock> end_time = std::chrono::steady_clock::now();
+
+        fastest[0] = std::min(fastest[0], std::chrono::duration<double, std::nano>(middle_time - start_time).count());
+        fastest[1] = std::min(fastest[1], std::chrono::duration<double, std::nano>(end_time - middle_time).count());
+    }
+
+    double targets = 4.0 * rounds * situation_count;
+
+    std::printf("Switch on the id: %.2f ns per target\n", fastest[0] / targets);
+    std::printf("Personalities:    %.2f ns per target\n", fastest[1] / targets);
+    std::printf("(Checksums %08x %08x)\n", checksums[0], checksums[1]);
+
+    if (fastest[0] * TOLERANCE < fastest[1]) {
+        std::printf("FAILED: the personalities are slower than the switch.\n");
+
+        return 1;
+    }
+
+    std::printf("OK: the personalities are not slower than the switch.\n");
+}
\ No newline at end of file
@@ -0,0 +1,507 @@
+// Evolves the ghost settings of every level (the chase distances, the chase and scatter durations and the frightened speed) until a fixed set of bots clears the level as often as we want.
+// Every candidate plays the same games (the same bots with the same random numbers) on all cores, and the best half of every generation makes the other half again with small mutations.
+// Every generation plays new games, so a candidate can't survive by being lucky once.
+// It prints the table in the format of --levels (see LevelSettings.cpp), with the win rate of every level in a comment, and how many games and candidates it played per second.
+// Usage: GhostTuner [--generations <count>] [--population <count>] [--games <count>] [--threads <count>] [--levels <file>] [--level-count <count>] [--target <win rate>] [--last-target <win rate>] [--maze <file>] [--max-ticks <ticks>] [--seed <seed>] [--output <file>]
+// The target of every level is between --target (the first level) and --last-target (the last one).
+
+#include <algorithm>  // For std::max, std::min and std::stable_sort
+#include <array>      // For std::array
+#include <atomic>     // For handing out the games to the threads
+#include <chrono>     // For measuring the throughput
+#include <cmath>      // For fabs
+#include <condition_variable> // For waking the threads up for every generation
+#include <cstdio>     // For printing the table
+#include <cstdlib>    // For std::abs
+#include <functional> // For std::ref
+#include <mutex>      // For std::mutex
+#include <string>     // For std::string
+#include <thread>     // For std::thread
+#include <vector>     // For std::vector
+#include <SFML/Graphics.hpp> // SFML graphics library (the game can draw itself, but we never ask it to)
+
+#include "../Headers/Global.hpp"             // Header for global constants and definitions
+#include "../Headers/Map.hpp"                // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"      // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp"     // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"             // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"              // Header for Ghost class definition
+#include "../Headers/GhostPersonalities.hpp" // Header for the ghost personalities (and get_position_ahead)
+#include "../Headers/GhostManager.hpp"       // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"        // Header for drawing the game map
+#include "../Headers/Game.hpp"               // Header for the Game class definition
+#include "../Headers/MapCollision.hpp"       // Header for checking the walls
+#include "../Headers/MapSketch.hpp"          // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp"      // Header for loading maze files
+#include "../Headers/Random.hpp"             // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"            // Header for the random and pellet players
+
+// The bots: one walks randomly, one goes to the closest pellet, and one does too but runs from the ghosts
+constexpr unsigned char BOT_COUNT = 3;
+// How close a ghost must be (in cells) for the coward to run
+constexpr unsigned char COWARD_DISTANCE = 6;
+
+// The limits of the mutations
+constexpr unsigned char MAX_CHASE_DISTANCE = 16;
+constexpr unsigned short MAX_DURATION = 4096 * TICK_MULTIPLIER;
+
+// What every thread plays in a generation
+struct TunerGeneration
+{
+    unsigned char level;
+
+    unsigned games;
+    unsigned max_ticks;
+    unsigned seed;
+
+    std::vector<LevelSettings> candidates;
+};
+
+// The threads are started once, and wait here for every generation
+struct TunerPool
+{
+    bool stopping;
+
+    // Which generation the threads should play (it only grows), and how many of them are done with it
+    unsigned generation_number;
+    unsigned finished_threads;
+
+    std::condition_variable finished;
+    std::condition_variable started;
+
+    std::mutex mutex;
+};
+
+// The next game (of any candidate) a thread should play
+static std::atomic<unsigned> next_game(0);
+
+// Pick the input of a bot for this tick
+static unsigned char get_bot_input(unsigned char i_bot, unsigned char i_input, RandomPlayer& i_player, Game& i_game, PelletSearch& i_search) {
+    Position position = i_game.get_pacman().get_position();
+
+    if (i_bot == 0) {
+        return get_random_input(i_player);
+    }
+    else if (i_bot == 1) {
+        return get_pellet_input(i_input, i_player.random_state, i_game, i_search);
+    }
+
+    // The coward only decides in the middle of a cell
+    if (position.x % CELL_SIZE != 0 || position.y % CELL_SIZE != 0) {
+        return i_input;
+    }
+
+    const Map& map = i_game.get_map();
+
+    unsigned char direction = i_game.get_pacman().get_direction();
+    unsigned char output = direction;
+    unsigned char pellet_direction = get_pellet_direction(position, map, i_search);
+
+    // Did we find a direction without a wall?
+    bool found = 0;
+
+    int best_score = 0;
+
+    // The coward runs from the closest ghost that can catch him
+    bool threatened = 0;
+
+    int threat_distance = CELL_SIZE * COWARD_DISTANCE;
+
+    Position threat = position;
+
+    for (Ghost& ghost : i_game.get_ghost_manager().get_ghosts()) {
+        int distance = std::abs(ghost.get_position().x - position.x) + std::abs(ghost.get_position().y - position.y);
+
+        if (ghost.get_frightened_mode() == 0 && distance < threat_distance) {
+            threatened = 1;
+            threat_distance = distance;
+            threat = ghost.get_position();
+        }
+    }
+
+    for (unsigned char a = 0; a < 4; a++) {
+        Position next = get_position_ahead(position, a, 1, map);
+
+        if (map_collision(0, next.x, next.y, map)) {
+            continue;
+        }
+
+        // Random ties, and turning back only when it's worth it
+        int score = 1 + get_random(i_player.random_state) % 4 + 16 * (a == pellet_direction) - 8 * (a == (2 + direction) % 4);
+
+        if (threatened && threat_distance < std::abs(threat.x - next.x) + std::abs(threat.y - next.y)) {
+            score += 256;
+        }
+
+        if (!found || best_score < score) {
+            found = 1;
+            best_score = score;
+            output = a;
+        }
+    }
+
+    return static_cast<unsigned char>(1 << output);
+}
+
+// Play games of the generation until there are none left, and count the wins of every candidate
+static void run_worker(const TunerGeneration& i_generation, const Game& i_start, std::vector<unsigned>& i_wins, unsigned long long& i_ticks) {
+    Game game = i_start;
+
+    unsigned long long ticks = 0;
+
+    std::vector<unsigned> wins(i_generation.candidates.size(), 0);
+
+    // For the bots' searches
+    PelletSearch search;
+
+    for (unsigned a = next_game++; a < i_generation.games * i_generation.candidates.size(); a = next_game++) {
+        // Every candidate plays game (a % games) against the same bot with the same random numbers
+        unsigned candidate = a / i_generation.games;
+        unsigned game_index = a % i_generation.games;
+
+        unsigned char bot = game_index % BOT_COUNT;
+        unsigned char input = 0;
+
+        // Every level has its own seeds
+        RandomPlayer player = get_random_player(i_generation.seed + game_index);
+
+        game = i_start;
+        game.reset(i_generation.level, i_generation.candidates[candidate]);
+
+        for (unsigned b = 0; b < i_generation.max_ticks; b++) {
+            input = get_bot_input(bot, input, player, game, search);
+
+            game.update(input, 0);
+
+            ticks++;
+
+            if (game.get_pacman().get_dead()) {
+                break;
+            }
+
+            if (game.get_game_won()) {
+                wins[candidate]++;
+
+                break;
+            }
+        }
+    }
+
+    i_ticks = ticks;
+    i_wins = wins;
+}
+
+// Play every generation the main thread hands out, until it stops us
+static void run_thread(TunerPool& i_pool, const TunerGeneration& i_generation, const Game& i_start, std::vector<unsigned>& i_wins, unsigned long long& i_ticks) {
+    unsigned generation_number = 0;
+
+    while (1) {
+        {
+            std::unique_lock<std::mutex> lock(i_pool.mutex);
+
+            i_pool.started.wait(lock, [&] { return i_pool.stopping || generation_number != i_pool.generation_number; });
+
+            if (i_pool.stopping) {
+                return;
+            }
+
+            generation_number = i_pool.generation_number;
+        }
+
+        run_worker(i_generation, i_start, i_wins, i_ticks);
+
+        std::lock_guard<std::mutex> lock(i_pool.mutex);
+
+        i_pool.finished_threads++;
+        i_pool.finished.notify_one();
+    }
+}
+
+// Change a number by up to i_step, and keep it between i_min and i_max
+static unsigned get_mutation(unsigned i_value, unsigned i_step, unsigned i_min, unsigned i_max, unsigned& i_random_state) {
+    unsigned step = 1 + get_random(i_random_state) % std::max(1u, i_step);
+
+    if (get_random(i_random_state) % 2 == 0) {
+        return std::min(i_max, i_value + step);
+    }
+
+    return std::max(i_min, i_value - std::min(i_value, step));
+}
+
+// Change one or more of the settings we tune (the durations stay whole 60 Hz frames, so the table can be written in the level file)
+static void mutate(LevelSettings& i_settings, unsigned& i_random_state) {
+    do {
+        switch (get_random(i_random_state) % 7) {
+        case 0: i_settings.ghost_1_chase = static_cast<unsigned char>(get_mutation(i_settings.ghost_1_chase, 1, 0, MAX_CHASE_DISTANCE, i_random_state)); break;
+        case 1: i_settings.ghost_2_chase = static_cast<unsigned char>(get_mutation(i_settings.ghost_2_chase, 1, 0, MAX_CHASE_DISTANCE, i_random_state)); break;
+        case 2: i_settings.ghost_3_chase = static_cast<unsigned char>(get_mutation(i_settings.ghost_3_chase, 1, 0, MAX_CHASE_DISTANCE, i_random_state)); break;
+        case 3:
+        {
+            i_settings.chase_duration = static_cast<unsigned short>(TICK_MULTIPLIER * get_mutation(i_settings.chase_duration / TICK_MULTIPLIER, i_settings.chase_duration / TICK_MULTIPLIER / 4, 16, MAX_DURATION / TICK_MULTIPLIER, i_random_state));
+
+            break;
+        }
+        case 4:
+        {
+            i_settings.long_scatter_duration = static_cast<unsigned short>(TICK_MULTIPLIER * get_mutation(i_settings.long_scatter_duration / TICK_MULTIPLIER, i_settings.long_scatter_duration / TICK_MULTIPLIER / 4, 1, MAX_DURATION / TICK_MULTIPLIER, i_random_state));
+
+            break;
+        }
+        case 5:
+        {
+            i_settings.short_scatter_duration = static_cast<unsigned short>(TICK_MULTIPLIER * get_mutation(i_settings.short_scatter_duration / TICK_MULTIPLIER, i_settings.short_scatter_duration / TICK_MULTIPLIER / 4, 1, MAX_DURATION / TICK_MULTIPLIER, i_random_state));
+
+            break;
+        }
+        case 6:
+        {
+            // The frightened ghost moves once every (1 + ghost_frightened_speed) ticks, and the file counts it in frames
+            unsigned frames = get_mutation((1 + i_settings.ghost_frightened_speed) / TICK_MULTIPLIER, 1, 1, 255 / TICK_MULTIPLIER, i_random_state);
+
+            i_settings.ghost_frightened_speed = static_cast<unsigned char>(frames * TICK_MULTIPLIER - 1);
+        }
+        }
+    }
+    while (get_random(i_random_state) % 2 == 0);
+}
+
+// Write a level as a line of the level file
+static void print_level(std::FILE* i_file, const LevelSettings& i_settings) {
+    std::fprintf(i_file, "%u %u %u %u %u %u %u %u %u %u %u %u\n",
+        i_settings.chase_duration / TICK_MULTIPLIER,
+        i_settings.energizer_duration / TICK_MULTIPLIER,
+        i_settings.ghost_flash_start / TICK_MULTIPLIER,
+        i_settings.long_scatter_duration / TICK_MULTIPLIER,
+        i_settings.short_scatter_duration / TICK_MULTIPLIER,
+        i_settings.pacman_speed,
+        i_settings.ghost_speed,
+        i_settings.ghost_escape_speed,
+        (1 + i_settings.ghost_frightened_speed) / TICK_MULTIPLIER - 1,
+        i_settings.ghost_1_chase,
+        i_settings.ghost_2_chase,
+        i_settings.ghost_3_chase);
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned char level_count = 10;
+
+    unsigned games = 1000;
+    unsigned generations = 100;
+    unsigned max_ticks = 3 * 60 * 1000000 / FRAME_DURATION;
+    unsigned population = 16;
+    unsigned seed = 1;
+    unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    double first_target = 0.5;
+    double last_target = 0.1;
+
+    std::string output_file_name;
+
+    // The mazes from "--maze" (we play the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--games") {
+            games = std::max(1u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+        else if (argument == "--generations") {
+            generations = std::max(1u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+        else if (argument == "--last-target") {
+            last_target = std::stod(i_arguments[1 + a]);
+        }
+        else if (argument == "--level-count") {
+            level_count = static_cast<unsigned char>(std::max(1, std::min(255, std::stoi(i_arguments[1 + a]))));
+        }
+        else if (argument == "--levels" && !load_level_settings(i_arguments[1 + a])) {
+            std::printf("Can't read the level settings in %s.\n", i_arguments[1 + a]);
+
+            return 1;
+        }
+        else if (argument == "--max-ticks") {
+            max_ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+
+            const char* error = validate_maze(mazes[0]);
+
+            if (error != nullptr) {
+                std::printf("Can't play the maze in %s: %s\n", i_arguments[1 + a], error);
+
+                return 1;
+            }
+        }
+        else if (argument == "--output") {
+            output_file_name = i_arguments[1 + a];
+        }
+        else if (argument == "--population") {
+            population = std::max(2u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+        else if (argument == "--seed") {
+            seed = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--target") {
+            first_target = std::stod(i_arguments[1 + a]);
+        }
+        else if (argument == "--threads") {
+            thread_count = std::max(1u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+    }
+
+    const std::vector<std::string>& maze = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    Game start(0, seed, maze);
+
+    // The best candidate of every level, and how often it won in its last generation
+    std::vector<LevelSettings> table;
+    std::vector<double> win_rates;
+
+    unsigned mutation_random_state = seed_random(seed, 0);
+
+    unsigned long long ticks = 0;
+
+    std::printf("Tuning %u levels: %u generations of %u candidates, %u games each, on %u threads.\n", level_count, generations, population, games, thread_count);
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    // What the threads play, and what they found (the main thread only touches them while the threads wait)
+    TunerGeneration generation;
+
+    std::vector<std::vector<unsigned>> wins(thread_count);
+    std::vector<unsigned long long> thread_ticks(thread_count, 0);
+
+    TunerPool pool;
+    pool.stopping = 0;
+    pool.generation_number = 0;
+    pool.finished_threads = 0;
+
+    std::vector<std::thread> threads;
+
+    for (unsigned a = 0; a < thread_count; a++) {
+        threads.push_back(std::thread(run_thread, std::ref(pool), std::cref(generation), std::cref(start), std::ref(wins[a]), std::ref(thread_ticks[a])));
+    }
+
+    for (unsigned char a = 0; a < level_count; a++) {
+        double target = first_target + (last_target - first_target) * a / std::max(1, level_count - 1);
+
+        generation.level = a;
+        generation.games = games;
+        generation.max_ticks = max_ticks;
+
+        // We start from the table, and its mutations
+        generation.candidates.assign(population, get_level_settings(a));
+
+        for (unsigned b = 1; b < population; b++) {
+            mutate(generation.candidates[b], mutation_random_state);
+        }
+
+        // The candidates from the best to the worst (by how far they are from the target), and their wins
+        std::vector<std::pair<double, unsigned>> ranking(population);
+        std::vector<unsigned> candidate_wins(population, 0);
+
+        for (unsigned b = 0; b < generations; b++) {
+            generation.seed = seed + games * (b + generations * a);
+
+            {
+                std::unique_lock<std::mutex> lock(pool.mutex);
+
+                next_game = 0;
+
+                pool.finished_threads = 0;
+                pool.generation_number++;
+                pool.started.notify_all();
+
+                pool.finished.wait(lock, [&] { return pool.finished_threads == thread_count; });
+            }
+
+            for (unsigned c = 0; c < population; c++) {
+                candidate_wins[c] = 0;
+
+                for (unsigned d = 0; d < thread_count; d++) {
+                    candidate_wins[c] += wins[d][c];
+                }
+
+                ranking[c] = { std::fabs(candidate_wins[c] - target * games), c };
+            }
+
+            for (unsigned long long thread_tick_count : thread_ticks) {
+                ticks += thread_tick_count;
+            }
+
+            // The stable sort keeps the older candidates first when they tie
+            std::stable_sort(ranking.begin(), ranking.end());
+
+            if (b + 1 == generations) {
+                break;
+            }
+
+            // The best half stays, and makes the other half
+            std::vector<LevelSettings> candidates(population, LevelSettings());
+
+            for (unsigned c = 0; c < population; c++) {
+                candidates[c] = generation.candidates[ranking[c % ((1 + population) / 2)].second];
+
+                if ((1 + population) / 2 <= c) {
+                    mutate(candidates[c], mutation_random_state);
+                }
+            }
+
+            generation.candidates = candidates;
+        }
+
+        table.push_back(generation.candidates[ranking[0].second]);
+        win_rates.push_back(static_cast<double>(candidate_wins[ranking[0].second]) / games);
+
+        std::printf("Level %u: won %.1f %% of the games (the target is %.1f %%).\n", 1 + a, 100 * win_rates.back(), 100 * target);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+
+        pool.stopping = 1;
+        pool.started.notify_all();
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    double evaluations = static_cast<double>(level_count) * generations * population;
+
+    std::printf("%.0f candidates (%.0f games) in %.2f s: %.1f candidates/s, %.0f games/s, %.2f M ticks/s.\n\n",
+        evaluations, evaluations * games, duration, evaluations / duration, evaluations * games / duration, ticks / duration / 1000000);
+
+    std::FILE* output_file = output_file_name.empty() ? nullptr : std::fopen(output_file_name.c_str(), "w");
+
+    if (!output_file_name.empty() && output_file == nullptr) {
+        std::printf("Can't write %s.\n", output_file_name.c_str());
+
+        return 1;
+    }
+
+    for (std::FILE* file : { stdout, output_file }) {
+        if (file == nullptr) {
+            continue;
+        }
+
+        std::fprintf(file, "# chase energizer ghost_flash_start long_scatter short_scatter pacman_speed ghost_speed ghost_escape_speed ghost_frightened_speed ghost_1_chase ghost_2_chase ghost_3_chase\n");
+
+        for (unsigned char a = 0; a < level_count; a++) {
+            std::fprintf(file, "# Level %u: the bots won %.1f %% of %u games\n", 1 + a, 100 * win_rates[a], games);
+
+            print_level(file, table[a]);
+        }
+    }
+
+    if (output_file != nullptr) {
+        std::fclose(output_file);
+    }
+}
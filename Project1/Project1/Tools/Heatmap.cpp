@@ -0,0 +1,430 @@
+// Plays lots of games with random inputs on all cores and counts what happens on every tile of the map, for level design and difficulty work:
+// where Pacman goes, where he dies (and which ghost caught him), where he eats the ghosts, and in which order the pellets are eaten.
+// Every game only depends on its number, so the results don't depend on the number of threads.
+// Every thread counts into its own tiles and only adds them to the totals when it's done, so the threads never write to the same memory.
+// The results are drawn over the map in <output>_visits.png, <output>_deaths.png, <output>_ghosts_eaten.png and <output>_pellet_order.png, and summed up in a table.
+// Usage: Heatmap [--games <count>] [--threads <count>] [--maze <file>] [--seed <seed>] [--max-ticks <ticks>] [--output <prefix>]
+
+#include <algorithm>  // For std::max and std::min
+#include <array>      // For std::array
+#include <atomic>     // For handing out the games to the threads
+#include <chrono>     // For measuring the throughput
+#include <cmath>      // For log
+#include <cstdio>     // For printing the results
+#include <functional> // For std::ref
+#include <memory>     // For std::align and std::uninitialized_fill_n
+#include <string>     // For std::string
+#include <thread>     // For std::thread
+#include <vector>     // For std::vector
+#include <SFML/Graphics.hpp> // For drawing the heatmaps
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"      // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp"  // Header for loading maze files
+#include "../Headers/Random.hpp"         // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"        // Header for the random player
+
+// How much of the map shows through the heat
+constexpr unsigned char HEAT_ALPHA = 176;
+
+// The size of a cache line, for the tiles of the threads
+constexpr unsigned char CACHE_LINE_SIZE = 64;
+
+// The deadliest tiles we print
+constexpr unsigned char DEADLY_TILE_COUNT = 10;
+
+// What happened on one tile
+struct HeatmapTile
+{
+    unsigned long long deaths;
+    unsigned long long ghosts_eaten;
+    unsigned long long pellets_eaten;
+    //The sum of how many pellets were eaten before this one in its game (divided by pellets_eaten, it's the average place in the order).
+    unsigned long long pellet_order;
+    unsigned long long visits;
+};
+
+// What a thread counted
+struct HeatmapResults
+{
+    //Which ghost caught Pacman (if two did, both count).
+    std::array<unsigned long long, 4> kills;
+
+    unsigned long long deaths;
+    unsigned long long games;
+    unsigned long long ghosts_eaten;
+    unsigned long long pellets_eaten;
+    unsigned long long ticks;
+    unsigned long long wins;
+
+    std::vector<HeatmapTile> tiles;
+};
+
+// The next game a thread should play
+static std::atomic<unsigned long long> next_game(0);
+
+// The tile in the middle of something (the tunnels go outside the map, so we keep it inside)
+static unsigned get_tile(const Position& i_position, const Map& i_map) {
+    int x = std::max(0, std::min<int>(i_map.get_width() - 1, (CELL_SIZE / 2 + i_position.x) / CELL_SIZE));
+    int y = std::max(0, std::min<int>(i_map.get_height() - 1, (CELL_SIZE / 2 + i_position.y) / CELL_SIZE));
+
+    return x + i_map.get_width() * y;
+}
+
+// Play games until there are none left
+static void run_worker(unsigned long long i_game_count, unsigned i_seed, unsigned i_max_ticks, const std::vector<std::string>& i_maze, const Game& i_start, HeatmapResults& i_results) {
+    Game game = i_start;
+
+    const Map& start_map = game.get_map();
+
+    // The cells with a pellet or an energizer at the start, and the ones still there in this game
+    std::vector<unsigned char> start_pellets(start_map.get_width() * start_map.get_height(), 0);
+    std::vector<unsigned char> pellets;
+
+    for (unsigned short a = 0; a < start_map.get_height(); a++) {
+        for (unsigned short b = 0; b < start_map.get_width(); b++) {
+            Cell cell = start_map.get_cell(b, a);
+
+            start_pellets[b + start_map.get_width() * a] = cell == Cell::Pellet || cell == Cell::Energizer;
+        }
+    }
+
+    // Our own tiles, starting on a cache line and with a free line after them, so no other thread's memory shares a line with them
+    std::vector<unsigned char> tile_memory(sizeof(HeatmapTile) * start_pellets.size() + 2 * CACHE_LINE_SIZE);
+
+    void* tile_start = tile_memory.data();
+    std::size_t tile_space = tile_memory.size();
+
+    HeatmapTile* tiles = static_cast<HeatmapTile*>(std::align(CACHE_LINE_SIZE, sizeof(HeatmapTile) * start_pellets.size(), tile_start, tile_space));
+
+    std::uninitialized_fill_n(tiles, start_pellets.size(), HeatmapTile());
+
+    HeatmapResults results = {};
+
+    for (unsigned long long a = next_game++; a < i_game_count; a = next_game++) {
+        RandomPlayer player = get_random_player(static_cast<unsigned>(i_seed + a));
+
+        unsigned pellet_order = 0;
+
+        // Every game has its own seed, so the frightened ghosts don't take the same turns in all of them
+        game = Game(0, static_cast<unsigned>(i_seed + a), i_maze);
+
+        pellets = start_pellets;
+
+        results.games++;
+
+        for (unsigned b = 0; b < i_max_ticks; b++) {
+            std::array<Ghost, 4>& ghosts = game.get_ghost_manager().get_ghosts();
+
+            std::array<unsigned char, 4> frightened_modes = {
+                ghosts[0].get_frightened_mode(),
+                ghosts[1].get_frightened_mode(),
+                ghosts[2].get_frightened_mode(),
+                ghosts[3].get_frightened_mode()
+            };
+
+            game.update(get_random_input(player), 0);
+
+            results.ticks++;
+
+            const Map& map = game.get_map();
+
+            Position pacman_position = game.get_pacman().get_position();
+
+            tiles[get_tile(pacman_position, map)].visits++;
+
+            // Pacman only eats the cells he touches
+            int left = get_floor_cell(pacman_position.x);
+            int top = get_floor_cell(pacman_position.y);
+
+            for (int c = top; c <= get_floor_cell(CELL_SIZE - 1 + pacman_position.y); c++) {
+                for (int d = left; d <= get_floor_cell(CELL_SIZE - 1 + pacman_position.x); d++) {
+                    if (d < 0 || c < 0 || d >= map.get_width() || c >= map.get_height()) {
+                        continue;
+                    }
+
+                    unsigned cell = d + map.get_width() * c;
+
+                    if (pellets[cell] && map.get_cell(d, c) == Cell::Empty) {
+                        pellets[cell] = 0;
+
+                        tiles[cell].pellets_eaten++;
+                        tiles[cell].pellet_order += pellet_order;
+
+                        pellet_order++;
+                    }
+                }
+            }
+
+            for (unsigned char c = 0; c < 4; c++) {
+                if (frightened_modes[c] != 2 && ghosts[c].get_frightened_mode() == 2) {
+                    tiles[get_tile(ghosts[c].get_position(), map)].ghosts_eaten++;
+
+                    results.ghosts_eaten++;
+                }
+            }
+
+            if (game.get_pacman().get_dead()) {
+                tiles[get_tile(pacman_position, map)].deaths++;
+
+                results.deaths++;
+
+                for (unsigned char c = 0; c < 4; c++) {
+                    if (ghosts[c].get_frightened_mode() == 0 && ghosts[c].pacman_collision(pacman_position)) {
+                        results.kills[c]++;
+                    }
+                }
+
+                break;
+            }
+
+            if (game.get_game_won()) {
+                results.wins++;
+
+                break;
+            }
+        }
+
+        results.pellets_eaten += pellet_order;
+    }
+
+    // Only now do we touch the results the main thread reads
+    results.tiles.assign(tiles, tiles + start_pellets.size());
+
+    i_results = results;
+}
+
+// Blue for the coldest, green, then red for the hottest
+static sf::Color get_heat_color(double i_heat) {
+    double heat = std::max(0., std::min(1., i_heat));
+
+    if (heat < 0.5) {
+        return sf::Color(0, static_cast<sf::Uint8>(510 * heat), static_cast<sf::Uint8>(255 - 510 * heat), HEAT_ALPHA);
+    }
+
+    return sf::Color(static_cast<sf::Uint8>(510 * heat - 255), static_cast<sf::Uint8>(510 - 510 * heat), 0, HEAT_ALPHA);
+}
+
+// Draw the map, then the heat of every tile over it (a negative heat is no heat), and save it as a PNG
+static bool save_heatmap(const std::string& i_file_name, Game& i_start, const std::vector<double>& i_heat) {
+    const Map& map = i_start.get_map();
+
+    sf::RenderTexture texture;
+
+    if (!texture.create(CELL_SIZE * map.get_width(), CELL_SIZE * map.get_height())) {
+        return 0;
+    }
+
+    texture.setView(sf::View(sf::FloatRect(0, 0, static_cast<float>(CELL_SIZE * map.get_width()), static_cast<float>(CELL_SIZE * map.get_height()))));
+    texture.clear();
+
+    MapRenderer map_renderer;
+
+    map_renderer.draw(map, texture);
+
+    sf::VertexArray quads(sf::Quads);
+
+    for (unsigned short a = 0; a < map.get_height(); a++) {
+        for (unsigned short b = 0; b < map.get_width(); b++) {
+            double heat = i_heat[b + map.get_width() * a];
+
+            if (heat < 0) {
+                continue;
+            }
+
+            sf::Color color = get_heat_color(heat);
+
+            float x = static_cast<float>(CELL_SIZE * b);
+            float y = static_cast<float>(CELL_SIZE * a);
+
+            quads.append(sf::Vertex(sf::Vector2f(x, y), color, sf::Vector2f()));
+            quads.append(sf::Vertex(sf::Vector2f(CELL_SIZE + x, y), color, sf::Vector2f()));
+            quads.append(sf::Vertex(sf::Vector2f(CELL_SIZE + x, CELL_SIZE + y), color, sf::Vector2f()));
+            quads.append(sf::Vertex(sf::Vector2f(x, CELL_SIZE + y), color, sf::Vector2f()));
+        }
+    }
+
+    texture.draw(quads);
+    texture.display();
+
+    return texture.getTexture().copyToImage().saveToFile(i_file_name);
+}
+
+// The heat of a count, on a log scale (a few tiles get most of the visits)
+static std::vector<double> get_log_heat(const std::vector<HeatmapTile>& i_tiles, unsigned long long HeatmapTile::* i_count) {
+    unsigned long long max_count = 0;
+
+    for (const HeatmapTile& tile : i_tiles) {
+        max_count = std::max(max_count, tile.*i_count);
+    }
+
+    std::vector<double> output(i_tiles.size(), -1);
+
+    for (std::size_t a = 0; a < i_tiles.size(); a++) {
+        if (i_tiles[a].*i_count != 0) {
+            output[a] = log(1. + i_tiles[a].*i_count) / log(1. + max_count);
+        }
+    }
+
+    return output;
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned max_ticks = 5 * 60 * 1000000 / FRAME_DURATION;
+    unsigned seed = 1;
+    unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    unsigned long long game_count = 100000;
+
+    std::string output = "heatmap";
+
+    // The mazes from "--maze" (we play the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--games") {
+            game_count = std::stoull(i_arguments[1 + a]);
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+        }
+        else if (argument == "--max-ticks") {
+            max_ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--output") {
+            output = i_arguments[1 + a];
+        }
+        else if (argument == "--seed") {
+            seed = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--threads") {
+            thread_count = std::max(1u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+    }
+
+    const std::vector<std::string>& maze = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    Game start(0, seed, maze);
+
+    const Map& map = start.get_map();
+
+    std::vector<HeatmapResults> results(thread_count);
+    std::vector<std::thread> threads;
+
+    std::printf("Playing %llu games on %u threads.\n", game_count, thread_count);
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    for (unsigned a = 0; a < thread_count; a++) {
+        threads.push_back(std::thread(run_worker, game_count, seed, max_ticks, std::cref(maze), std::cref(start), std::ref(results[a])));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // Add up the threads
+    HeatmapResults totals = {};
+    totals.tiles.resize(map.get_width() * map.get_height(), HeatmapTile());
+
+    for (HeatmapResults& result : results) {
+        totals.deaths += result.deaths;
+        totals.games += result.games;
+        totals.ghosts_eaten += result.ghosts_eaten;
+        totals.pellets_eaten += result.pellets_eaten;
+        totals.ticks += result.ticks;
+        totals.wins += result.wins;
+
+        for (unsigned char a = 0; a < 4; a++) {
+            totals.kills[a] += result.kills[a];
+        }
+
+        for (std::size_t a = 0; a < totals.tiles.size(); a++) {
+            totals.tiles[a].deaths += result.tiles[a].deaths;
+            totals.tiles[a].ghosts_eaten += result.tiles[a].ghosts_eaten;
+            totals.tiles[a].pellets_eaten += result.tiles[a].pellets_eaten;
+            totals.tiles[a].pellet_order += result.tiles[a].pellet_order;
+            totals.tiles[a].visits += result.tiles[a].visits;
+        }
+    }
+
+    unsigned pellet_count = 0;
+
+    for (unsigned short a = 0; a < map.get_height(); a++) {
+        for (unsigned short b = 0; b < map.get_width(); b++) {
+            pellet_count += map.get_cell(b, a) == Cell::Pellet || map.get_cell(b, a) == Cell::Energizer;
+        }
+    }
+
+    double games = static_cast<double>(std::max<unsigned long long>(1, totals.games));
+
+    std::printf("%llu games in %.2f s: %.0f games/s, %.2f M ticks/s.\n\n", totals.games, duration, totals.games / duration, totals.ticks / duration / 1000000);
+
+    std::printf("Games                 | %12llu\n", totals.games);
+    std::printf("Cleared the level     | %12llu | %6.2f %%\n", totals.wins, 100 * totals.wins / games);
+    std::printf("Died                  | %12llu | %6.2f %%\n", totals.deaths, 100 * totals.deaths / games);
+    std::printf("Ran out of ticks      | %12llu | %6.2f %%\n", totals.games - totals.wins - totals.deaths, 100 * (totals.games - totals.wins - totals.deaths) / games);
+    std::printf("Ticks per game        | %12.1f\n", totals.ticks / games);
+    std::printf("Pellets eaten per game| %12.1f | %6.2f %%\n", totals.pellets_eaten / games, 100 * totals.pellets_eaten / games / std::max(1u, pellet_count));
+    std::printf("Ghosts eaten per game | %12.3f\n", totals.ghosts_eaten / games);
+
+    for (unsigned char a = 0; a < 4; a++) {
+        std::printf("Caught by ghost %u     | %12llu | %6.2f %% of the deaths\n", a, totals.kills[a], 100. * totals.kills[a] / std::max<unsigned long long>(1, totals.deaths));
+    }
+
+    // The deadliest tiles
+    std::vector<unsigned> deadly_tiles(totals.tiles.size());
+
+    for (unsigned a = 0; a < deadly_tiles.size(); a++) {
+        deadly_tiles[a] = a;
+    }
+
+    std::partial_sort(deadly_tiles.begin(), deadly_tiles.begin() + std::min<std::size_t>(DEADLY_TILE_COUNT, deadly_tiles.size()), deadly_tiles.end(), [&](unsigned i_a, unsigned i_b) {
+        return totals.tiles[i_a].deaths > totals.tiles[i_b].deaths;
+    });
+
+    std::printf("\nDeadliest tiles:\n");
+
+    for (std::size_t a = 0; a < std::min<std::size_t>(DEADLY_TILE_COUNT, deadly_tiles.size()) && totals.tiles[deadly_tiles[a]].deaths != 0; a++) {
+        std::printf("%3u,%3u | %12llu | %6.2f %% of the deaths\n", deadly_tiles[a] % map.get_width(), deadly_tiles[a] / map.get_width(),
+            totals.tiles[deadly_tiles[a]].deaths, 100. * totals.tiles[deadly_tiles[a]].deaths / std::max<unsigned long long>(1, totals.deaths));
+    }
+
+    // The pellets are blue when they're eaten early, and red when they're eaten late
+    std::vector<double> pellet_order(totals.tiles.size(), -1);
+
+    for (std::size_t a = 0; a < totals.tiles.size(); a++) {
+        if (totals.tiles[a].pellets_eaten != 0) {
+            pellet_order[a] = static_cast<double>(totals.tiles[a].pellet_order) / totals.tiles[a].pellets_eaten / std::max(1u, pellet_count - 1);
+        }
+    }
+
+    bool saved = save_heatmap(output + "_visits.png", start, get_log_heat(totals.tiles, &HeatmapTile::visits));
+    saved = save_heatmap(output + "_deaths.png", start, get_log_heat(totals.tiles, &HeatmapTile::deaths)) && saved;
+    saved = save_heatmap(output + "_ghosts_eaten.png", start, get_log_heat(totals.tiles, &HeatmapTile::ghosts_eaten)) && saved;
+    saved = save_heatmap(output + "_pellet_order.png", start, pellet_order) && saved;
+
+    if (!saved) {
+        std::printf("\nCan't save the heatmaps.\n");
+
+        return 1;
+    }
+
+    std::printf("\nThe heatmaps are in %s_*.png.\n", output.c_str());
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+// Plays the same game on bigger and bigger mazes, and checks that a frame (a tick and drawing the map around Pacman) costs about the same on all of them.
+// The map is drawn into a texture the size of the camera, like Game::draw does on the screen.
+// It also shows the costs that do grow with the maze: starting a level, and copying the game (the versus mode does that in every frame).
+// Usage: MapScaleBenchmark [--ticks <ticks>] [--ghost-radius <cells>] [--max-size <cells>]
+
+#include <algorithm> // For std::max
+#include <array>     // For std::array
+#include <chrono>    // For timing the frames
+#include <cstdio>    // For printing the results
+#include <string>    // For std::string
+#include <vector>    // For std::vector
+#include <SFML/Graphics.hpp> // For the texture we draw into
+
+#include "../Headers/Global.hpp"        // Header for global constants and definitions
+#include "../Headers/Map.hpp"           // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"        // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"         // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"  // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"   // Header for drawing the game map
+#include "../Headers/Game.hpp"          // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"     // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp" // Header for the maze generator
+#include "../Headers/Random.hpp"        // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"       // Header for the random player
+
+// The frames on the biggest maze may cost this much more than on the default map before we call it a failure
+// (The timer isn't perfect, and the big maps don't fit in the cache, but the cost mustn't grow with the maze.)
+constexpr float TOLERANCE = 2;
+
+// The sizes we try (the first one is the default map)
+constexpr std::array<unsigned short, 5> MAZE_SIZES = { MAP_WIDTH, 101, 251, 501, 1001 };
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned short ghost_radius = 16;
+    unsigned short max_size = 1001;
+
+    unsigned ticks = 20000;
+
+    // The frame cost on the default map and on the biggest maze
+    double first_frame_duration = 0;
+    double last_frame_duration = 0;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--ghost-radius") {
+            ghost_radius = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--max-size") {
+            max_size = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--ticks") {
+            ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    // What the camera sees
+    sf::RenderTexture target;
+
+    target.create(CELL_SIZE * VIEW_WIDTH, CELL_SIZE * VIEW_HEIGHT);
+
+    std::printf("Ghost radius: %u cells\n", ghost_radius);
+
+    for (unsigned short size : MAZE_SIZES) {
+        if (max_size < size) {
+            break;
+        }
+
+        RandomPlayer player = get_random_player(1);
+
+        unsigned timed_ticks = 0;
+        unsigned long long drawn_chunks = 0;
+
+        double frame_duration = 0;
+
+        // Roughly as many energizers for every pellet as the default map has
+        MazeSettings settings = { 1, 70, static_cast<unsigned char>(std::min(255, size * size / 100)), 1, size, size };
+
+        std::vector<std::string> maze = size == MAP_WIDTH ? get_map_sketch() : generate_maze(settings, 1);
+
+        if (validate_maze(maze) != nullptr) {
+            std::printf("%ux%u: the maze can't be played (%s).\n", size, size, validate_maze(maze));
+
+            return 1;
+        }
+
+        Game game(0, 1, maze);
+        // The versus mode copies the game into snapshots that already have the memory
+        Game copy = game;
+
+        game.set_ghost_simulation_radius(ghost_radius);
+
+        MapRenderer map_renderer;
+
+        // Starting a level converts the whole sketch, so this grows with the maze
+        std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+        game.reset();
+
+        double reset_duration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_time).count();
+
+        // So does copying the game
+        start_time = std::chrono::steady_clock::now();
+
+        copy = game;
+
+        double copy_duration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_time).count();
+
+        for (unsigned a = 0; a < ticks; a++) {
+            unsigned char input = get_random_input(player);
+
+            // Starting the next level isn't a normal frame, so we don't time it
+            if (game.get_game_won() || game.get_pacman().get_dead()) {
+                game.update(INPUT_RESTART, 0);
+
+                continue;
+            }
+
+            start_time = std::chrono::steady_clock::now();
+
+            game.update(input, 0);
+
+            // The camera follows Pacman
+            sf::View camera(sf::FloatRect(0, 0, CELL_SIZE * VIEW_WIDTH, CELL_SIZE * VIEW_HEIGHT));
+
+            camera.setCenter(game.get_pacman().get_position().x + 0.5f * CELL_SIZE, game.get_pacman().get_position().y + 0.5f * CELL_SIZE);
+
+            target.setView(camera);
+            target.clear();
+
+            map_renderer.draw(game.get_map(), target);
+
+            frame_duration += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_time).count();
+
+            drawn_chunks += map_renderer.get_drawn_chunks();
+            timed_ticks++;
+        }
+
+        frame_duration /= std::max(1u, timed_ticks);
+
+        if (size == MAP_WIDTH) {
+            first_frame_duration = frame_duration;
+        }
+
+        last_frame_duration = frame_duration;
+
+        std::printf("%4ux%-4u | Frame: %7.2f us | Chunks drawn: %4.1f | Starting a level: %9.1f us | Copying the game: %8.1f us\n",
+            size, size, frame_duration, drawn_chunks / static_cast<double>(std::max(1u, timed_ticks)), reset_duration, copy_duration);
+    }
+
+    if (first_frame_duration * TOLERANCE < last_frame_duration) {
+        std::printf("FAILED: a frame on the biggest maze costs %.1f times as much as on the default map.\n", last_frame_duration / first_frame_duration);
+
+        return 1;
+    }
+
+    std::printf("OK: the frame cost doesn't grow with the maze.\n");
+}
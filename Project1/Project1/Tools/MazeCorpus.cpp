@@ -0,0 +1,145 @@
+// Generates lots of random mazes (in the same format as get_map_sketch) and checks that every one of them can be played.
+// The valid mazes are saved in a file, for the soak tests and the benchmarks. With "--check <file>", it only checks the mazes in a file.
+// Usage: MazeCorpus [--count <mazes>] [--width <cells>] [--height <cells>] [--density <percent>] [--energizers <count>] [--tunnels <count>]
+//                   [--asymmetric] [--seed <seed>] [--threads <threads>] [--output <file>]
+//        MazeCorpus --check <file> [--threads <threads>]
+
+#include <algorithm>  // For std::max
+#include <atomic>     // For handing out the mazes to the threads
+#include <chrono>     // For measuring the throughput
+#include <cstdio>     // For printing the results
+#include <functional> // For std::ref
+#include <string>     // For std::string
+#include <thread>     // For std::thread
+#include <vector>     // For std::vector
+
+#include "../Headers/Global.hpp"        // Header for global constants and definitions
+#include "../Headers/MazeGenerator.hpp" // Header for the maze generator
+
+// The next maze a thread should work on
+static std::atomic<unsigned> next_maze(0);
+
+// Generate (unless we're checking a file) and validate mazes until there are none left
+// Every maze only depends on its seed, so the results don't depend on the number of threads
+static void run_worker(bool i_generate, const MazeSettings& i_settings, unsigned i_seed, std::vector<std::vector<std::string>>& i_mazes, std::vector<const char*>& i_problems) {
+    for (unsigned a = next_maze++; a < i_mazes.size(); a = next_maze++) {
+        if (i_generate) {
+            i_mazes[a] = generate_maze(i_settings, i_seed + a);
+        }
+
+        i_problems[a] = validate_maze(i_mazes[a]);
+    }
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned seed = 1;
+    unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    // Same size and (roughly) the same look as the original map
+    MazeSettings settings = { 1, 70, 4, 1, MAP_HEIGHT, MAP_WIDTH };
+
+    std::string check_file_name;
+    std::string output_file_name = "mazes.txt";
+
+    std::vector<const char*> problems;
+
+    std::vector<std::vector<std::string>> mazes(1000);
+
+    // Read the command line arguments
+    for (int a = 1; a < i_argument_count; a++) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--asymmetric") {
+            settings.symmetric = 0;
+        }
+        else if (a + 1 < i_argument_count) {
+            if (argument == "--check") {
+                check_file_name = i_arguments[++a];
+            }
+            else if (argument == "--count") {
+                mazes.resize(std::stoul(i_arguments[++a]));
+            }
+            else if (argument == "--density") {
+                settings.density = static_cast<unsigned char>(std::stoi(i_arguments[++a]));
+            }
+            else if (argument == "--energizers") {
+                settings.energizers = static_cast<unsigned char>(std::stoi(i_arguments[++a]));
+            }
+            else if (argument == "--height") {
+                settings.height = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+            }
+            else if (argument == "--output") {
+                output_file_name = i_arguments[++a];
+            }
+            else if (argument == "--seed") {
+                seed = static_cast<unsigned>(std::stoul(i_arguments[++a]));
+            }
+            else if (argument == "--threads") {
+                thread_count = std::max(1, std::stoi(i_arguments[++a]));
+            }
+            else if (argument == "--tunnels") {
+                settings.tunnels = static_cast<unsigned char>(std::stoi(i_arguments[++a]));
+            }
+            else if (argument == "--width") {
+                settings.width = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+            }
+        }
+    }
+
+    if (!check_file_name.empty()) {
+        mazes.clear();
+
+        if (!load_mazes(check_file_name, mazes)) {
+            std::printf("Can't read %s.\n", check_file_name.c_str());
+
+            return 1;
+        }
+    }
+
+    problems.resize(mazes.size());
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+
+    for (unsigned a = 0; a < thread_count; a++) {
+        threads.push_back(std::thread(run_worker, check_file_name.empty(), std::ref(settings), seed, std::ref(mazes), std::ref(problems)));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // Print the bad mazes, and keep the good ones
+    std::vector<std::vector<std::string>> valid_mazes;
+
+    for (unsigned a = 0; a < mazes.size(); a++) {
+        if (problems[a] == nullptr) {
+            valid_mazes.push_back(mazes[a]);
+        }
+        else if (check_file_name.empty()) {
+            std::printf("Seed %u: %s\n", seed + a, problems[a]);
+        }
+        else {
+            std::printf("Maze %u: %s\n", a, problems[a]);
+        }
+    }
+
+    std::printf("%s %u mazes in %.3f s (%.0f mazes/s, %u threads): %u valid, %u invalid.\n",
+        check_file_name.empty() ? "Generated and validated" : "Validated", static_cast<unsigned>(mazes.size()), seconds,
+        mazes.size() / std::max(seconds, 1e-9), thread_count, static_cast<unsigned>(valid_mazes.size()), static_cast<unsigned>(mazes.size() - valid_mazes.size()));
+
+    if (check_file_name.empty()) {
+        if (!save_mazes(output_file_name, valid_mazes)) {
+            std::printf("Can't write %s.\n", output_file_name.c_str());
+
+            return 1;
+        }
+
+        std::printf("Saved the valid mazes in %s.\n", output_file_name.c_str());
+    }
+
+    return valid_mazes.size() == mazes.size() ? 0 : 1;
+}
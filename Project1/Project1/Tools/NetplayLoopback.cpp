@@ -0,0 +1,173 @@
+// Plays a versus game against itself over 127.0.0.1 (two players, two threads), with fake latency and packet loss.
+// While playing, the hashes of the games must stay the same, and at the end both games must be exactly the same, otherwise the rollback is broken.
+// Usage: NetplayLoopback [--frames <frames>] [--latency <milliseconds>] [--loss <percent>] [--port <port>]
+
+#include <algorithm> // For std::min
+#include <array>   // For std::array
+#include <atomic>  // For counting the finished players
+#include <chrono>  // For time handling
+#include <climits> // For UINT_MAX
+#include <cstdio>  // For printing the results
+#include <functional> // For std::ref
+#include <string>  // For the command line arguments
+#include <thread>  // For running both players at the same time
+#include <vector>  // For std::vector
+#include <SFML/Graphics.hpp> // SFML graphics library
+#include <SFML/Network.hpp>  // SFML network library
+
+#include "../Headers/Global.hpp"       // Header for global constants and definitions
+#include "../Headers/Map.hpp"          // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp" // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"       // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"        // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp" // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"  // Header for drawing the game map
+#include "../Headers/Game.hpp"         // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"    // Header for the default map sketch
+#include "../Headers/Netplay.hpp"      // Header for the versus mode
+#include "../Headers/Random.hpp"       // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"      // Header for the random player
+
+// What one player ended up with
+struct PeerResult
+{
+    bool finished;
+
+    // Where the hashes were different while playing (UINT_MAX if they never were)
+    unsigned desync_frame;
+
+    unsigned long long hash;
+};
+
+// How many players are done (they keep talking until both are, so nobody waits forever for a lost packet)
+static std::atomic<unsigned char> finished_peers(0);
+
+// Play one side of the game with random inputs
+static void run_peer(bool i_host, unsigned short i_port, unsigned i_frames, unsigned short i_latency, unsigned char i_loss, PeerResult& i_result) {
+    // Random inputs, different for each player
+    RandomPlayer player = get_random_player(i_host ? 1 : 2);
+
+    unsigned seed = 12345;
+
+    Netplay netplay(i_latency, i_loss);
+
+    i_result = { 0, UINT_MAX, 0 };
+
+    if (i_host ? !netplay.host(i_port, seed) : !netplay.join(sf::IpAddress::LocalHost, i_port, seed)) {
+        std::printf("%s: can't connect.\n", i_host ? "Pacman" : "Ghost");
+
+        finished_peers++;
+
+        return;
+    }
+
+    Game game(1, seed, get_map_sketch());
+
+    std::chrono::time_point<std::chrono::steady_clock> next_frame_time = std::chrono::steady_clock::now();
+
+    // If the other player stops talking to us for this long, give up
+    std::chrono::time_point<std::chrono::steady_clock> deadline = next_frame_time + std::chrono::seconds(10);
+
+    while (netplay.get_frame() < i_frames && std::chrono::steady_clock::now() < deadline) {
+        // Change the direction every now and then, and sometimes press Enter
+        unsigned char input = get_random_input(player);
+
+        if (get_random(player.random_state) % 64 == 0) {
+            input |= INPUT_RESTART;
+        }
+
+        if (netplay.update(input, game)) {
+            deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        }
+
+        if (netplay.get_frame() % (1000000 / FRAME_DURATION) == 0) {
+            NetplayStatistics statistics = netplay.get_statistics();
+
+            std::printf("%s: rollback depth %u max, %.1f average | resimulated %u frames/s | stalled %u frames/s | sent %u B/s | received %u B/s\n",
+                i_host ? "Pacman" : "Ghost ", statistics.max_rollback_depth, statistics.average_rollback_depth, statistics.resimulated_frames,
+                statistics.stalled_frames, statistics.sent_bytes, statistics.received_bytes);
+        }
+
+        next_frame_time += std::chrono::microseconds(FRAME_DURATION);
+
+        std::this_thread::sleep_until(next_frame_time);
+    }
+
+    // Wait until we have every input of the other player (the last rollback fixes our game)
+    while (netplay.get_confirmed_frame() < i_frames && std::chrono::steady_clock::now() < deadline) {
+        netplay.poll(game);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    i_result = { netplay.get_confirmed_frame() == i_frames, netplay.get_desync_frame(), game.get_hash() };
+
+    finished_peers++;
+
+    // Keep sending our inputs until the other player is done too
+    while (finished_peers < 2) {
+        netplay.poll(game);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned char loss = 10;
+
+    unsigned short latency = 50;
+    unsigned short port = NETPLAY_PORT;
+
+    unsigned frames = 1200;
+
+    std::array<PeerResult, 2> results;
+
+    // Read the command line arguments
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--frames") {
+            frames = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--latency") {
+            latency = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--loss") {
+            loss = static_cast<unsigned char>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--port") {
+            port = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+    }
+
+    std::printf("%u frames, %u ms latency, %u%% packet loss\n", frames, latency, loss);
+
+    std::thread host(run_peer, 1, port, frames, latency, loss, std::ref(results[0]));
+    std::thread join(run_peer, 0, port, frames, latency, loss, std::ref(results[1]));
+
+    host.join();
+    join.join();
+
+    if (!results[0].finished || !results[1].finished) {
+        std::printf("FAILED: the players didn't finish.\n");
+
+        return 1;
+    }
+
+    if (results[0].desync_frame != UINT_MAX || results[1].desync_frame != UINT_MAX) {
+        std::printf("FAILED: desync at frame %u.\n", std::min(results[0].desync_frame, results[1].desync_frame));
+
+        return 1;
+    }
+
+    if (results[0].hash != results[1].hash) {
+        std::printf("FAILED: desync (%016llx != %016llx).\n", results[0].hash, results[1].hash);
+
+        return 1;
+    }
+
+    std::printf("OK: both games ended with hash %016llx.\n", results[0].hash);
+
+    return 0;
+}
@@ -0,0 +1,307 @@
+// Opens thousands of fake players on pakku-server, so we can see how it scales on one machine (Linux only, it uses epoll).
+// Every player presses random directions 60 times per second and reads the state updates.
+// In versus mode, every room gets two players (Pacman and the red ghost).
+// Usage: PakkuLoadGenerator [--address <IPv4 address>] [--port <port>] [--sessions <sessions>] [--seconds <seconds>] [--versus]
+
+#include <algorithm>     // For std::min
+#include <array>         // For std::array
+#include <chrono>        // For time handling
+#include <cstdio>        // For printing the statistics
+#include <string>        // For the command line arguments
+#include <vector>        // For std::vector
+#include <arpa/inet.h>   // For inet_pton
+#include <errno.h>       // For errno
+#include <fcntl.h>       // For non-blocking sockets
+#include <netinet/in.h>  // For sockaddr_in
+#include <netinet/tcp.h> // For TCP_NODELAY
+#include <sys/epoll.h>   // For the event loop
+#include <sys/resource.h> // For raising the file limit
+#include <sys/socket.h>  // For the sockets
+#include <sys/timerfd.h> // For the tick timer
+#include <unistd.h>      // For read, write and close
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Random.hpp"         // Header for the deterministic random number generator
+#include "../Headers/ServerProtocol.hpp" // Header for the messages between the server and the clients
+
+// How many players we connect per tick, so we don't overflow the server's backlog
+constexpr unsigned short CONNECTIONS_PER_TICK = 256;
+
+// One fake player
+struct Session
+{
+    // Did the connection finish?
+    bool connected;
+
+    unsigned char input;
+    // How much of the current state message we have
+    unsigned char state_size;
+
+    int socket;
+
+    // The last frame the server sent us
+    unsigned frame;
+    // The frame of the state we're reading
+    unsigned next_frame;
+};
+
+int main(int i_argument_count, char** i_arguments) {
+    bool versus = 0;
+
+    unsigned short port = SERVER_PORT;
+
+    unsigned random_state = seed_random(1, 0);
+    unsigned seconds = 30;
+    unsigned session_count = 1000;
+
+    // Statistics of the current second
+    unsigned connected_count = 0;
+    unsigned disconnected_count = 0;
+    unsigned received_bytes = 0;
+    unsigned sent_bytes = 0;
+    unsigned skipped_frames = 0;
+    unsigned states = 0;
+
+    std::array<epoll_event, 256> events;
+
+    std::string address = "127.0.0.1";
+
+    std::vector<Session> sessions;
+
+    // Read the command line arguments
+    for (int a = 1; a < i_argument_count; a++) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--versus") {
+            versus = 1;
+        }
+        else if (a + 1 < i_argument_count) {
+            if (argument == "--address") {
+                address = i_arguments[++a];
+            }
+            else if (argument == "--port") {
+                port = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+            }
+            else if (argument == "--seconds") {
+                seconds = static_cast<unsigned>(std::stoul(i_arguments[++a]));
+            }
+            else if (argument == "--sessions") {
+                session_count = static_cast<unsigned>(std::stoul(i_arguments[++a]));
+            }
+        }
+    }
+
+    // Thousands of players need thousands of sockets
+    rlimit file_limit;
+
+    if (getrlimit(RLIMIT_NOFILE, &file_limit) == 0) {
+        file_limit.rlim_cur = file_limit.rlim_max;
+
+        setrlimit(RLIMIT_NOFILE, &file_limit);
+    }
+
+    sockaddr_in server_address = {};
+    server_address.sin_family = AF_INET;
+    server_address.sin_port = htons(port);
+
+    if (inet_pton(AF_INET, address.c_str(), &server_address.sin_addr) != 1) {
+        std::printf("Bad address: %s\n", address.c_str());
+
+        return 1;
+    }
+
+    int epoll = epoll_create1(0);
+    int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+
+    itimerspec timer_settings = {};
+    timer_settings.it_interval.tv_nsec = 1000l * FRAME_DURATION;
+    timer_settings.it_value.tv_nsec = 1000l * FRAME_DURATION;
+
+    timerfd_settime(timer, 0, &timer_settings, nullptr);
+
+    epoll_event timer_event = {};
+    timer_event.events = EPOLLIN;
+    timer_event.data.u64 = UINT32_MAX;
+
+    epoll_ctl(epoll, EPOLL_CTL_ADD, timer, &timer_event);
+
+    sessions.reserve(session_count);
+
+    std::printf("Opening %u sessions on %s:%u for %u seconds.\n", session_count, address.c_str(), port, seconds);
+
+    std::chrono::time_point<std::chrono::steady_clock> end_time = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    std::chrono::time_point<std::chrono::steady_clock> report_time = std::chrono::steady_clock::now();
+
+    while (std::chrono::steady_clock::now() < end_time) {
+        int event_count = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), 100);
+
+        for (int a = 0; a < event_count; a++) {
+            if (events[a].data.u64 == UINT32_MAX) {
+                unsigned long long expirations;
+
+                if (read(timer, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+                    continue;
+                }
+
+                // Open some more sessions
+                for (unsigned short b = 0; b < CONNECTIONS_PER_TICK && sessions.size() < session_count; b++) {
+                    Session session = { 0, 0, 0, socket(AF_INET, SOCK_STREAM, 0), 0, 0 };
+
+                    int enable = 1;
+
+                    if (session.socket < 0) {
+                        std::printf("Out of sockets after %u sessions.\n", static_cast<unsigned>(sessions.size()));
+
+                        session_count = static_cast<unsigned>(sessions.size());
+
+                        break;
+                    }
+
+                    fcntl(session.socket, F_SETFL, fcntl(session.socket, F_GETFL) | O_NONBLOCK);
+                    setsockopt(session.socket, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+                    connect(session.socket, reinterpret_cast<sockaddr*>(&server_address), sizeof(server_address));
+
+                    epoll_event event = {};
+                    event.events = EPOLLIN | EPOLLOUT;
+                    event.data.u64 = sessions.size();
+
+                    epoll_ctl(epoll, EPOLL_CTL_ADD, session.socket, &event);
+
+                    sessions.push_back(session);
+                }
+
+                // Every connected player sends an input (and sometimes changes it)
+                for (Session& session : sessions) {
+                    if (session.connected) {
+                        if (get_random(random_state) % 16 == 0) {
+                            session.input = static_cast<unsigned char>(1 << (get_random(random_state) % 4)) | INPUT_RESTART;
+                        }
+
+                        unsigned char message[INPUT_MESSAGE_SIZE] = { MESSAGE_INPUT, session.input };
+
+                        if (send(session.socket, message, INPUT_MESSAGE_SIZE, MSG_NOSIGNAL) == INPUT_MESSAGE_SIZE) {
+                            sent_bytes += INPUT_MESSAGE_SIZE;
+                        }
+                    }
+                }
+
+                continue;
+            }
+
+            Session& session = sessions[events[a].data.u64];
+
+            if (session.socket < 0) {
+                continue;
+            }
+
+            if (events[a].events & (EPOLLERR | EPOLLHUP)) {
+                epoll_ctl(epoll, EPOLL_CTL_DEL, session.socket, nullptr);
+                close(session.socket);
+
+                session.connected = 0;
+                session.socket = -1;
+
+                disconnected_count++;
+
+                continue;
+            }
+
+            if (!session.connected && (events[a].events & EPOLLOUT)) {
+                // The connection is ready, so we join our room
+                unsigned index = static_cast<unsigned>(events[a].data.u64);
+                unsigned room = versus ? index / 2 : index;
+
+                unsigned char message[JOIN_MESSAGE_SIZE] = {
+                    MESSAGE_JOIN,
+                    static_cast<unsigned char>(room), static_cast<unsigned char>(room >> 8), static_cast<unsigned char>(room >> 16), static_cast<unsigned char>(room >> 24),
+                    static_cast<unsigned char>(versus ? index % 2 : 0),
+                    versus
+                };
+
+                epoll_event event = {};
+                event.events = EPOLLIN;
+                event.data.u64 = events[a].data.u64;
+
+                epoll_ctl(epoll, EPOLL_CTL_MOD, session.socket, &event);
+
+                if (send(session.socket, message, JOIN_MESSAGE_SIZE, MSG_NOSIGNAL) == JOIN_MESSAGE_SIZE) {
+                    session.connected = 1;
+
+                    connected_count++;
+                    sent_bytes += JOIN_MESSAGE_SIZE;
+                }
+            }
+
+            if (events[a].events & EPOLLIN) {
+                unsigned char buffer[4096];
+
+                ssize_t size;
+
+                while ((size = read(session.socket, buffer, sizeof(buffer))) > 0) {
+                    received_bytes += static_cast<unsigned>(size);
+
+                    // We only look at the frame number, so we know if the server skipped ticks
+                    for (ssize_t b = 0; b < size; b++) {
+                        if (1 <= session.state_size && session.state_size <= 4) {
+                            if (session.state_size == 1) {
+                                session.next_frame = 0;
+                            }
+
+                            session.next_frame |= buffer[b] << (8 * (session.state_size - 1));
+
+                            if (session.state_size == 4) {
+                                // More than 1 frame since the last state means the server was catching up
+                                if (session.frame != 0 && session.next_frame > 1 + session.frame) {
+                                    skipped_frames += session.next_frame - session.frame - 1;
+                                }
+
+                                session.frame = session.next_frame;
+                            }
+                        }
+
+                        session.state_size++;
+
+                        if (session.state_size == STATE_MESSAGE_SIZE) {
+                            session.state_size = 0;
+
+                            states++;
+                        }
+                    }
+                }
+
+                if (size == 0 || (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    epoll_ctl(epoll, EPOLL_CTL_DEL, session.socket, nullptr);
+                    close(session.socket);
+
+                    session.connected = 0;
+                    session.socket = -1;
+
+                    disconnected_count++;
+                }
+            }
+        }
+
+        // Once per second, print how it's going
+        if (std::chrono::seconds(1) <= std::chrono::steady_clock::now() - report_time) {
+            std::printf("Sessions: %u connected, %u lost | States: %u/s | Skipped frames: %u/s | Sent: %u B/s | Received: %u B/s\n",
+                connected_count - disconnected_count, disconnected_count, states, skipped_frames, sent_bytes, received_bytes);
+
+            report_time = std::chrono::steady_clock::now();
+
+            received_bytes = 0;
+            sent_bytes = 0;
+            skipped_frames = 0;
+            states = 0;
+        }
+    }
+
+    for (Session& session : sessions) {
+        if (session.socket >= 0) {
+            close(session.socket);
+        }
+    }
+
+    close(timer);
+    close(epoll);
+}
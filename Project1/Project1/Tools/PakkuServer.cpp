@@ -0,0 +1,726 @@
+// pakku-server: hosts thousands of game rooms without a window (Linux only, it uses epoll).
+// Every room runs the same fixed-tick simulation as the game. The rooms are split between shards (room % shards), and every shard is one thread with its own epoll loop and tick timer.
+// The main thread accepts the connections, reads their join message and hands them to the shard that owns their room (a connection that doesn't send it within JOIN_TIMEOUT seconds is closed).
+// Usage: pakku-server [--port <port>] [--threads <threads>] [--levels <file>] [--trace <file>] [--metrics-port <port>] [--metrics-socket <path>]
+// The metrics (see Headers/Metrics.hpp) are served on http://127.0.0.1:<port> or on a Unix socket. Every shard counts its own, so they cost the shards nothing.
+// With PAKKU_TRACE defined, the trace zones of every shard are saved in the trace file when the server stops.
+
+#include <algorithm>     // For std::min
+#include <array>         // For std::array
+#include <atomic>        // For the statistics and for stopping
+#include <chrono>        // For time handling
+#include <csignal>       // For stopping with Ctrl+C
+#include <cstdio>        // For printing the statistics
+#include <memory>        // For std::unique_ptr
+#include <mutex>         // For handing the connections to the shards
+#include <string>        // For the command line arguments
+#include <thread>        // For the shards
+#include <unordered_map> // For the connections and the rooms
+#include <vector>        // For std::vector
+#include <errno.h>       // For errno
+#include <fcntl.h>       // For non-blocking sockets
+#include <netinet/in.h>  // For sockaddr_in
+#include <netinet/tcp.h> // For TCP_NODELAY
+#include <sys/epoll.h>   // For the event loops
+#include <sys/eventfd.h> // For waking up the shards
+#include <sys/resource.h> // For raising the file limit
+#include <sys/socket.h>  // For the sockets
+#include <sys/timerfd.h> // For the tick timers
+#include <unistd.h>      // For read, write and close
+#include <SFML/Graphics.hpp> // SFML graphics library (the game can draw itself, but we never ask it to)
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"      // Header for the default map sketch
+#include "../Headers/ServerProtocol.hpp" // Header for the messages between the server and the clients
+#include "../Headers/Trace.hpp"          // Header for the trace zones
+#include "../Headers/Metrics.hpp"        // Header for the monitoring counters
+#include "../Headers/MetricsEndpoint.hpp" // Header for serving them
+
+// The tick latency histogram has 20 microseconds per bucket (the last bucket is for everything slower)
+constexpr unsigned short LATENCY_BUCKETS = 1024;
+constexpr unsigned char LATENCY_BUCKET_SIZE = 20;
+// If a shard falls further behind than this, it skips ticks instead of trying to catch up
+constexpr unsigned char MAX_CATCH_UP_TICKS = 4;
+// How many seconds a new connection has to send its join message (so a client that never does can't keep a socket forever)
+constexpr unsigned char JOIN_TIMEOUT = 5;
+
+// A connection that didn't send its whole join message yet
+struct JoiningConnection
+{
+    std::chrono::time_point<std::chrono::steady_clock> start_time;
+
+    std::vector<unsigned char> message;
+};
+
+// A connection that finished joining and waits for its shard
+struct PendingConnection
+{
+    bool player;
+    bool versus;
+
+    int socket;
+
+    unsigned room;
+};
+
+// A client in a room
+struct Connection
+{
+    // Do we have the first byte of an input message?
+    bool has_partial_input;
+    bool player;
+
+    unsigned char partial_input;
+
+    unsigned room;
+
+    // What the socket didn't take yet. While it's not empty, we skip the state updates (the next one replaces them anyway).
+    std::vector<unsigned char> output;
+};
+
+// One game and its players
+struct Room
+{
+    // The newest input of each player
+    std::array<unsigned char, 2> inputs;
+
+    // The socket of each player (-1 if nobody is there)
+    std::array<int, 2> sockets;
+
+    unsigned frame;
+
+    Game game;
+
+    Room(bool i_versus, unsigned i_seed) :
+        inputs({ 0, 0 }),
+        sockets({ -1, -1 }),
+        frame(0),
+        game(i_versus, i_seed, get_map_sketch())
+    {
+    }
+};
+
+// One thread, with its own rooms, epoll loop and tick timer
+struct Shard
+{
+    int epoll;
+    // Tells the shard there are new connections for it
+    int wakeup;
+    int timer;
+
+    std::mutex pending_mutex;
+
+    std::vector<PendingConnection> pending_connections;
+
+    std::unordered_map<int, Connection> connections;
+
+    std::unordered_map<unsigned, std::unique_ptr<Room>> rooms;
+
+    // The statistics. Only the shard writes them, and the main thread reads them once per second.
+    std::atomic<unsigned> overruns;
+    std::atomic<unsigned> room_count;
+    std::atomic<unsigned> ticks;
+
+    std::array<std::atomic<unsigned>, LATENCY_BUCKETS> latency_histogram;
+
+    std::thread thread;
+};
+
+// Ctrl+C sets this to 0
+static std::atomic<bool> running(1);
+
+static void stop(int) {
+    running = 0;
+}
+
+// Make a socket non-blocking
+static void set_non_blocking(int i_socket) {
+    fcntl(i_socket, F_SETFL, fcntl(i_socket, F_GETFL) | O_NONBLOCK);
+}
+
+// Write as much as the socket takes. The rest waits in the output buffer until the socket is writable again.
+static void write_message(Shard& i_shard, int i_socket, Connection& i_connection, const unsigned char* i_data, std::size_t i_size) {
+    ssize_t written = send(i_socket, i_data, i_size, MSG_NOSIGNAL);
+
+    if (written < 0) {
+        written = 0;
+    }
+
+    if (static_cast<std::size_t>(written) < i_size) {
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLOUT;
+        event.data.fd = i_socket;
+
+        i_connection.output.assign(i_data + written, i_data + i_size);
+
+        epoll_ctl(i_shard.epoll, EPOLL_CTL_MOD, i_socket, &event);
+    }
+}
+
+// Remove a player from their room, and the room if it's empty
+static void close_connection(Shard& i_shard, int i_socket) {
+    std::unordered_map<int, Connection>::iterator connection = i_shard.connections.find(i_socket);
+
+    if (connection != i_shard.connections.end()) {
+        std::unordered_map<unsigned, std::unique_ptr<Room>>::iterator room = i_shard.rooms.find(connection->second.room);
+
+        if (room != i_shard.rooms.end() && room->second->sockets[connection->second.player] == i_socket) {
+            room->second->sockets[connection->second.player] = -1;
+            room->second->inputs[connection->second.player] = 0;
+
+            if (room->second->sockets[0] == -1 && room->second->sockets[1] == -1) {
+                i_shard.rooms.erase(room);
+                i_shard.room_count = static_cast<unsigned>(i_shard.rooms.size());
+            }
+        }
+
+        i_shard.connections.erase(connection);
+    }
+
+    epoll_ctl(i_shard.epoll, EPOLL_CTL_DEL, i_socket, nullptr);
+    close(i_socket);
+}
+
+// Put the new connections in their rooms
+static void add_pending_connections(Shard& i_shard) {
+    std::vector<PendingConnection> pending_connections;
+
+    {
+        std::lock_guard<std::mutex> lock(i_shard.pending_mutex);
+
+        pending_connections.swap(i_shard.pending_connections);
+    }
+
+    for (const PendingConnection& pending_connection : pending_connections) {
+        std::unique_ptr<Room>& room = i_shard.rooms[pending_connection.room];
+
+        if (!room) {
+            // Every room gets its own (but repeatable) random numbers
+            room.reset(new Room(pending_connection.versus, 2654435769u * (1 + pending_connection.room)));
+
+            i_shard.room_count = static_cast<unsigned>(i_shard.rooms.size());
+        }
+
+        // Somebody is already playing this player
+        if (room->sockets[pending_connection.player] != -1) {
+            close(pending_connection.socket);
+
+            continue;
+        }
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = pending_connection.socket;
+
+        room->sockets[pending_connection.player] = pending_connection.socket;
+
+        i_shard.connections[pending_connection.socket] = { 0, pending_connection.player, 0, pending_connection.room, {} };
+
+        epoll_ctl(i_shard.epoll, EPOLL_CTL_ADD, pending_connection.socket, &event);
+    }
+}
+
+// Read the inputs of a player (we only keep the newest one)
+static void read_inputs(Shard& i_shard, int i_socket) {
+    unsigned char buffer[256];
+
+    Connection& connection = i_shard.connections[i_socket];
+
+    while (1) {
+        ssize_t size = read(i_socket, buffer, sizeof(buffer));
+
+        if (size == 0 || (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            close_connection(i_shard, i_socket);
+
+            return;
+        }
+        else if (size < 0) {
+            return;
+        }
+
+        for (ssize_t a = 0; a < size; a++) {
+            if (!connection.has_partial_input) {
+                connection.has_partial_input = 1;
+                connection.partial_input = buffer[a];
+            }
+            else {
+                connection.has_partial_input = 0;
+
+                if (connection.partial_input == MESSAGE_INPUT) {
+                    i_shard.rooms[connection.room]->inputs[connection.player] = buffer[a];
+                }
+            }
+        }
+    }
+}
+
+// Simulate every room and send the new states
+static void tick(Shard& i_shard, unsigned char i_steps) {
+    TRACE_ZONE("Shard tick");
+
+    unsigned char message[STATE_MESSAGE_SIZE];
+
+    for (std::pair<const unsigned, std::unique_ptr<Room>>& room : i_shard.rooms) {
+        Game& game = room.second->game;
+
+        for (unsigned char a = 0; a < i_steps; a++) {
+            bool playing = !game.get_game_won() && !game.get_pacman().get_dead();
+
+            game.update(room.second->inputs[0], room.second->inputs[1]);
+
+            room.second->frame++;
+
+            if (playing && game.get_pacman().get_dead()) {
+                add_death_metric(game.get_level());
+            }
+            else if (playing && game.get_game_won()) {
+                add_metric(Metric::LevelWonMetric);
+            }
+        }
+
+        add_metric(Metric::TickMetric, i_steps);
+        set_level_metric(game.get_level());
+
+        // Pack the state
+        unsigned char* data = message;
+
+        *data++ = MESSAGE_STATE;
+
+        for (unsigned char a = 0; a < 4; a++) {
+            *data++ = static_cast<unsigned char>(room.second->frame >> (8 * a));
+        }
+
+        *data++ = game.get_level();
+        *data++ = static_cast<unsigned char>(game.get_pacman().get_position().x);
+        *data++ = static_cast<unsigned char>(game.get_pacman().get_position().x >> 8);
+        *data++ = static_cast<unsigned char>(game.get_pacman().get_position().y);
+        *data++ = static_cast<unsigned char>(game.get_pacman().get_position().y >> 8);
+
+        for (Ghost& ghost : game.get_ghost_manager().get_ghosts()) {
+            *data++ = static_cast<unsigned char>(ghost.get_position().x);
+            *data++ = static_cast<unsigned char>(ghost.get_position().x >> 8);
+            *data++ = static_cast<unsigned char>(ghost.get_position().y);
+            *data++ = static_cast<unsigned char>(ghost.get_position().y >> 8);
+        }
+
+        // The lower half of the hash is enough to compare games
+        unsigned checksum = static_cast<unsigned>(game.get_hash());
+
+        for (unsigned char a = 0; a < 4; a++) {
+            *data++ = static_cast<unsigned char>(checksum >> (8 * a));
+        }
+
+        // Send it to everyone in the room
+        for (int socket : room.second->sockets) {
+            if (socket != -1) {
+                Connection& connection = i_shard.connections[socket];
+
+                if (connection.output.empty()) {
+                    write_message(i_shard, socket, connection, message, STATE_MESSAGE_SIZE);
+                }
+            }
+        }
+    }
+}
+
+// The event loop of one shard
+static void run_shard(Shard& i_shard, unsigned i_index) {
+    std::array<epoll_event, 256> events;
+
+    unsigned long long tick_count = 0;
+
+    // The ticks are scheduled from this moment, so the latency includes waking up late
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    itimerspec timer_settings = {};
+    timer_settings.it_interval.tv_nsec = 1000l * FRAME_DURATION;
+    timer_settings.it_value.tv_nsec = 1000l * FRAME_DURATION;
+
+    timerfd_settime(i_shard.timer, 0, &timer_settings, nullptr);
+
+    set_trace_thread_name("Shard " + std::to_string(i_index));
+
+    while (running) {
+        int event_count = epoll_wait(i_shard.epoll, events.data(), static_cast<int>(events.size()), 100);
+
+        for (int a = 0; a < event_count; a++) {
+            int socket = events[a].data.fd;
+
+            if (socket == i_shard.timer) {
+                unsigned long long expirations = 0;
+
+                if (read(i_shard.timer, &expirations, sizeof(expirations)) != sizeof(expirations) || expirations == 0) {
+                    continue;
+                }
+
+                // We missed some ticks
+                if (expirations > 1) {
+                    i_shard.overruns += static_cast<unsigned>(expirations - 1);
+
+                    add_metric(Metric::TickOverrunMetric, expirations - 1);
+                }
+
+                std::chrono::time_point<std::chrono::steady_clock> tick_start_time = std::chrono::steady_clock::now();
+
+                tick(i_shard, static_cast<unsigned char>(std::min<unsigned long long>(expirations, MAX_CATCH_UP_TICKS)));
+
+                add_metric_sample(MetricHistogram::TickTimeHistogram, static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tick_start_time).count()));
+
+                tick_count += expirations;
+
+                // How late this tick finished, compared to when it should've started
+                long long latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count() - static_cast<long long>(tick_count * FRAME_DURATION);
+
+                i_shard.latency_histogram[std::min<long long>(LATENCY_BUCKETS - 1, std::max<long long>(0, latency) / LATENCY_BUCKET_SIZE)]++;
+                i_shard.ticks++;
+            }
+            else if (socket == i_shard.wakeup) {
+                unsigned long long value;
+
+                if (read(i_shard.wakeup, &value, sizeof(value)) == sizeof(value)) {
+                    add_pending_connections(i_shard);
+                }
+            }
+            else if (events[a].events & (EPOLLERR | EPOLLHUP)) {
+                close_connection(i_shard, socket);
+            }
+            else {
+                if (events[a].events & EPOLLOUT) {
+                    Connection& connection = i_shard.connections[socket];
+
+                    std::vector<unsigned char> output;
+                    output.swap(connection.output);
+
+                    epoll_event event = {};
+                    event.events = EPOLLIN;
+                    event.data.fd = socket;
+
+                    epoll_ctl(i_shard.epoll, EPOLL_CTL_MOD, socket, &event);
+
+                    // If it still doesn't fit, this puts the rest back
+                    write_message(i_shard, socket, connection, output.data(), output.size());
+                }
+
+                if (events[a].events & EPOLLIN) {
+                    read_inputs(i_shard, socket);
+                }
+            }
+        }
+    }
+
+    for (std::pair<const int, Connection>& connection : i_shard.connections) {
+        close(connection.first);
+    }
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned short port = SERVER_PORT;
+
+    unsigned shard_count = std::max(1u, std::thread::hardware_concurrency());
+
+    std::array<epoll_event, 256> events;
+
+    std::chrono::time_point<std::chrono::steady_clock> report_time = std::chrono::steady_clock::now();
+
+    // Where we serve the metrics (0 means we don't)
+    unsigned short metrics_port = 0;
+
+    std::string metrics_socket_path;
+    std::string trace_file_name = "pakku-server-trace.json";
+
+    // The connections that didn't send their whole join message yet
+    std::unordered_map<int, JoiningConnection> joining;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // Read the command line arguments
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--port") {
+            port = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--threads") {
+            shard_count = std::max(1, std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--metrics-port") {
+            metrics_port = static_cast<unsigned short>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--metrics-socket") {
+            metrics_socket_path = i_arguments[1 + a];
+        }
+        else if (argument == "--trace") {
+            trace_file_name = i_arguments[1 + a];
+        }
+        else if (argument == "--levels" && !load_level_settings(i_arguments[1 + a])) {
+            std::printf("Can't read the level settings in %s.\n", i_arguments[1 + a]);
+
+            return 1;
+        }
+    }
+
+    // Thousands of players need thousands of sockets
+    rlimit file_limit;
+
+    if (getrlimit(RLIMIT_NOFILE, &file_limit) == 0) {
+        file_limit.rlim_cur = file_limit.rlim_max;
+
+        setrlimit(RLIMIT_NOFILE, &file_limit);
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+
+    MetricsEndpoint http_metrics_endpoint;
+    MetricsEndpoint unix_metrics_endpoint;
+
+    if (metrics_port != 0 && !http_metrics_endpoint.start_http(metrics_port)) {
+        std::printf("Can't serve the metrics on port %u.\n", metrics_port);
+
+        return 1;
+    }
+
+    if (!metrics_socket_path.empty() && !unix_metrics_endpoint.start_unix(metrics_socket_path)) {
+        std::printf("Can't serve the metrics on %s.\n", metrics_socket_path.c_str());
+
+        return 1;
+    }
+
+    // Listen for new players
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int enable = 1;
+
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        std::printf("Can't listen on port %u.\n", port);
+
+        return 1;
+    }
+
+    set_non_blocking(listener);
+
+    int epoll = epoll_create1(0);
+
+    epoll_event listener_event = {};
+    listener_event.events = EPOLLIN;
+    listener_event.data.fd = listener;
+
+    epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &listener_event);
+
+    // Once per second, we close the connections that are taking too long to join (with a timer like the shards' tick timers)
+    int join_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+
+    itimerspec join_timer_settings = {};
+    join_timer_settings.it_interval.tv_sec = 1;
+    join_timer_settings.it_value.tv_sec = 1;
+
+    timerfd_settime(join_timer, 0, &join_timer_settings, nullptr);
+
+    listener_event.data.fd = join_timer;
+
+    epoll_ctl(epoll, EPOLL_CTL_ADD, join_timer, &listener_event);
+
+    // Start the shards
+    for (unsigned a = 0; a < shard_count; a++) {
+        shards.emplace_back(new Shard());
+
+        Shard& shard = *shards.back();
+        shard.epoll = epoll_create1(0);
+        shard.timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+        shard.wakeup = eventfd(0, EFD_NONBLOCK);
+
+        for (int file : { shard.timer, shard.wakeup }) {
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.fd = file;
+
+            epoll_ctl(shard.epoll, EPOLL_CTL_ADD, file, &event);
+        }
+
+        shard.thread = std::thread(run_shard, std::ref(shard), a);
+    }
+
+    std::printf("Listening on port %u with %u shards.\n", port, shard_count);
+
+    while (running) {
+        int event_count = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), 100);
+
+        for (int a = 0; a < event_count; a++) {
+            int socket = events[a].data.fd;
+
+            if (socket == listener) {
+                int client;
+
+                while ((client = accept(listener, nullptr, nullptr)) >= 0) {
+                    epoll_event event = {};
+                    event.events = EPOLLIN;
+                    event.data.fd = client;
+
+                    set_non_blocking(client);
+                    setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+                    joining[client].start_time = std::chrono::steady_clock::now();
+
+                    epoll_ctl(epoll, EPOLL_CTL_ADD, client, &event);
+                }
+            }
+            else if (socket == join_timer) {
+                unsigned long long expirations;
+
+                if (read(join_timer, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+                    continue;
+                }
+
+                std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+                for (std::unordered_map<int, JoiningConnection>::iterator connection = joining.begin(); connection != joining.end();) {
+                    if (now - connection->second.start_time < std::chrono::seconds(JOIN_TIMEOUT)) {
+                        connection++;
+
+                        continue;
+                    }
+
+                    epoll_ctl(epoll, EPOLL_CTL_DEL, connection->first, nullptr);
+                    close(connection->first);
+
+                    connection = joining.erase(connection);
+                }
+            }
+            else {
+                std::unordered_map<int, JoiningConnection>::iterator connection = joining.find(socket);
+
+                // A connection the timer closed in this batch of events
+                if (connection == joining.end()) {
+                    continue;
+                }
+
+                std::vector<unsigned char>& message = connection->second.message;
+
+                unsigned char buffer[JOIN_MESSAGE_SIZE];
+
+                // Don't read further than the join message, the rest belongs to the shard
+                ssize_t size = read(socket, buffer, JOIN_MESSAGE_SIZE - message.size());
+
+                if (size == 0 || (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    joining.erase(socket);
+                    epoll_ctl(epoll, EPOLL_CTL_DEL, socket, nullptr);
+                    close(socket);
+
+                    continue;
+                }
+                else if (size < 0) {
+                    continue;
+                }
+
+                message.insert(message.end(), buffer, buffer + size);
+
+                if (message.size() == JOIN_MESSAGE_SIZE) {
+                    PendingConnection pending_connection;
+                    pending_connection.player = message[5] == 1;
+                    pending_connection.versus = message[6] == 1;
+                    pending_connection.socket = socket;
+                    pending_connection.room = message[1] | (message[2] << 8) | (message[3] << 16) | (static_cast<unsigned>(message[4]) << 24);
+
+                    bool valid = message[0] == MESSAGE_JOIN;
+
+                    joining.erase(socket);
+                    epoll_ctl(epoll, EPOLL_CTL_DEL, socket, nullptr);
+
+                    if (!valid) {
+                        close(socket);
+
+                        continue;
+                    }
+
+                    // Hand the connection to the shard that owns the room
+                    Shard& shard = *shards[pending_connection.room % shard_count];
+
+                    {
+                        std::lock_guard<std::mutex> lock(shard.pending_mutex);
+
+                        shard.pending_connections.push_back(pending_connection);
+                    }
+
+                    unsigned long long value = 1;
+
+                    if (write(shard.wakeup, &value, sizeof(value)) != sizeof(value)) {
+                        std::printf("Can't wake up shard %u.\n", pending_connection.room % shard_count);
+                    }
+                }
+            }
+        }
+
+        // Once per second, print the statistics of every shard put together
+        if (std::chrono::seconds(1) <= std::chrono::steady_clock::now() - report_time) {
+            unsigned latency_count = 0;
+            unsigned overruns = 0;
+            unsigned p99_bucket = 0;
+            unsigned rooms = 0;
+            unsigned ticks = 0;
+
+            std::array<unsigned, LATENCY_BUCKETS> latency_histogram = {};
+
+            report_time = std::chrono::steady_clock::now();
+
+            for (std::unique_ptr<Shard>& shard : shards) {
+                overruns += shard->overruns.exchange(0);
+                rooms += shard->room_count;
+                ticks += shard->ticks.exchange(0);
+
+                for (unsigned short b = 0; b < LATENCY_BUCKETS; b++) {
+                    latency_histogram[b] += shard->latency_histogram[b].exchange(0);
+                }
+            }
+
+            for (unsigned count : latency_histogram) {
+                latency_count += count;
+            }
+
+            // Find the bucket below which 99% of the ticks are
+            for (unsigned seen = 0; p99_bucket < LATENCY_BUCKETS - 1; p99_bucket++) {
+                seen += latency_histogram[p99_bucket];
+
+                if (100ull * seen >= 99ull * latency_count) {
+                    break;
+                }
+            }
+
+            std::printf("Rooms: %u (%.1f per core) | Ticks: %u/s | Tick overruns: %u/s | p99 tick latency: %u us\n",
+                rooms, rooms / static_cast<float>(shard_count), ticks, overruns, LATENCY_BUCKET_SIZE * (1 + p99_bucket));
+        }
+    }
+
+    for (std::unique_ptr<Shard>& shard : shards) {
+        shard->thread.join();
+
+        close(shard->epoll);
+        close(shard->timer);
+        close(shard->wakeup);
+    }
+
+    for (std::pair<const int, JoiningConnection>& connection : joining) {
+        close(connection.first);
+    }
+
+    close(epoll);
+    close(join_timer);
+    close(listener);
+
+    if (TRACE_ENABLED && save_trace(trace_file_name)) {
+        std::printf("Saved the trace in %s.\n", trace_file_name.c_str());
+    }
+}
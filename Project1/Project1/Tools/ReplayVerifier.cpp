@@ -0,0 +1,405 @@
+// Checks submitted runs for the leaderboards: it plays every replay (see Headers/Replay.hpp) again and compares the level and the hash with what the player claims.
+// The replays are read from a stream (a file, or "-" for the standard input) while the worker threads play them, and the verdicts go to the output as they're done, one line per replay:
+//     <id> OK <ticks> ticks, level <level>, hash <hash>
+//     <id> REJECTED <ticks> ticks, claimed level <level> hash <hash>, replayed level <level> hash <hash>
+//     <id> REJECTED <reason>
+// The last one is for the replays we don't play at all: longer than MAX_REPLAY_TICKS, a run of 0 ticks, or played with another maze or other level settings (the setup hash).
+// The memory doesn't depend on how long the stream is: there are only --queue replays in memory at once (the reader waits for a free one), and at most MAX_REPLAY_TICKS runs in each.
+// Usage: ReplayVerifier [--input <file>] [--output <file>] [--threads <threads>] [--queue <replays>] [--maze <file>] [--levels <file>]
+//        ReplayVerifier --generate <replays> [--output <file>] [--ticks <ticks>] [--bad <percent>] [--maze <file>] [--levels <file>]
+// --generate writes random runs (random inputs, restarting after every death), with --bad percent of them claiming a wrong hash, to test the verifier.
+
+#include <algorithm>          // For std::max and std::min
+#include <array>              // For std::array
+#include <chrono>             // For measuring the throughput
+#include <condition_variable> // For waiting on the queues
+#include <cstdio>             // For reading the replays and writing the verdicts
+#include <mutex>              // For the queues
+#include <string>             // For the command line arguments
+#include <thread>             // For the workers
+#include <vector>             // For std::vector
+#include <SFML/Graphics.hpp>  // SFML graphics library (the game can draw itself, but we never ask it to)
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"      // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp"  // Header for loading maze files
+#include "../Headers/Random.hpp"         // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"        // Header for the random player
+#include "../Headers/Replay.hpp"         // Header for the replays
+
+// The index that tells a worker that there's nothing left (and the tick count that tells the writer)
+constexpr unsigned QUEUE_END = ~0u;
+constexpr unsigned long long VERDICTS_END = ~0ull;
+
+// What we found out about a replay
+struct Verdict
+{
+    bool valid;
+
+    //Why we didn't play the replay (nullptr if we did).
+    const char* error;
+
+    unsigned char claimed_level;
+    unsigned char level;
+
+    unsigned id;
+
+    unsigned long long claimed_hash;
+    unsigned long long hash;
+    unsigned long long ticks;
+};
+
+// A queue with a fixed size: pushing waits while it's full, popping waits while it's empty
+// The items live in a ring that's allocated once, so a long stream doesn't make it grow
+template <typename Item>
+class BoundedQueue
+{
+    std::size_t count;
+    std::size_t head;
+
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+
+    std::mutex mutex;
+
+    std::vector<Item> items;
+public:
+    BoundedQueue(std::size_t i_size) :
+        count(0),
+        head(0),
+        items(i_size)
+    {
+    }
+
+    void push(const Item& i_item) {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        not_full.wait(lock, [this] { return count < items.size(); });
+
+        items[(head + count) % items.size()] = i_item;
+        count++;
+
+        not_empty.notify_one();
+    }
+
+    Item pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        not_empty.wait(lock, [this] { return 0 < count; });
+
+        Item output = items[head];
+
+        head = (1 + head) % items.size();
+        count--;
+
+        not_full.notify_one();
+
+        return output;
+    }
+};
+
+// Play the replay again and compare the result with the claim
+static Verdict verify_replay(const Replay& i_replay, unsigned long long i_setup_hash, const std::vector<std::string>& i_map_sketch) {
+    Verdict output = {};
+    output.claimed_hash = i_replay.hash;
+    output.claimed_level = i_replay.level;
+    output.id = i_replay.id;
+
+    // On another maze or with other settings, even an honest replay plays another game
+    if (i_replay.setup_hash != i_setup_hash) {
+        output.error = "played with another maze or other level settings";
+
+        return output;
+    }
+
+    Game game(i_replay.versus, i_replay.seed, i_map_sketch);
+
+    game.set_ghost_simulation_radius(i_replay.ghost_simulation_radius);
+
+    for (const ReplayRun& run : i_replay.runs) {
+        for (unsigned short a = 0; a < run.length; a++) {
+            game.update(run.pacman_input, run.ghost_input);
+        }
+
+        output.ticks += run.length;
+    }
+
+    output.hash = game.get_hash();
+    output.level = game.get_level();
+    output.valid = output.hash == output.claimed_hash && output.level == output.claimed_level;
+
+    return output;
+}
+
+// Take replays from the queue until the reader says there are no more
+static void run_worker(unsigned long long i_setup_hash, const std::vector<std::string>& i_map_sketch, std::vector<Replay>& i_replays,
+    BoundedQueue<unsigned>& i_free_replays, BoundedQueue<unsigned>& i_full_replays, BoundedQueue<Verdict>& i_verdicts) {
+    for (unsigned index = i_full_replays.pop(); index != QUEUE_END; index = i_full_replays.pop()) {
+        Verdict verdict = verify_replay(i_replays[index], i_setup_hash, i_map_sketch);
+
+        i_free_replays.push(index);
+        i_verdicts.push(verdict);
+    }
+}
+
+// Write the verdicts until the one with VERDICTS_END ticks
+static void run_writer(std::FILE* i_file, BoundedQueue<Verdict>& i_verdicts, unsigned& i_valid_count, unsigned& i_verdict_count, unsigned long long& i_tick_count) {
+    for (Verdict verdict = i_verdicts.pop(); verdict.ticks != VERDICTS_END; verdict = i_verdicts.pop()) {
+        if (verdict.valid) {
+            std::fprintf(i_file, "%u OK %llu ticks, level %u, hash %016llx\n", verdict.id, verdict.ticks, 1 + verdict.level, verdict.hash);
+
+            i_valid_count++;
+        }
+        else if (verdict.error != nullptr) {
+            std::fprintf(i_file, "%u REJECTED %s\n", verdict.id, verdict.error);
+        }
+        else {
+            std::fprintf(i_file, "%u REJECTED %llu ticks, claimed level %u hash %016llx, replayed level %u hash %016llx\n",
+                verdict.id, verdict.ticks, 1 + verdict.claimed_level, verdict.claimed_hash, 1 + verdict.level, verdict.hash);
+        }
+
+        i_tick_count += verdict.ticks;
+        i_verdict_count++;
+    }
+}
+
+// Play random runs and write them with their real result (or a wrong hash, for the --bad ones)
+static bool generate_replays(std::FILE* i_file, unsigned i_count, unsigned i_ticks, unsigned char i_bad_percent, const std::vector<std::string>& i_map_sketch) {
+    unsigned random_state = seed_random(1, 0);
+
+    Replay replay;
+
+    for (unsigned a = 0; a < i_count; a++) {
+        replay.ghost_simulation_radius = 0;
+        replay.id = a;
+        replay.runs.clear();
+        replay.seed = get_random(random_state);
+        replay.setup_hash = get_replay_setup_hash(i_map_sketch);
+        replay.versus = 0;
+
+        Game game(0, replay.seed, i_map_sketch);
+
+        RandomPlayer player = get_random_player(replay.seed);
+
+        for (unsigned b = 0; b < i_ticks; b++) {
+            unsigned char tick_input = game.get_game_won() || game.get_pacman().get_dead() ? INPUT_RESTART : get_random_input(player);
+
+            game.update(tick_input, 0);
+
+            add_replay_input(tick_input, 0, replay);
+        }
+
+        replay.hash = game.get_hash() ^ (get_random(random_state) % 100 < i_bad_percent);
+        replay.level = game.get_level();
+
+        if (!write_replay(i_file, replay)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned char bad_percent = 0;
+
+    unsigned generate_count = 0;
+    unsigned generate_ticks = 36000;
+    unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+    unsigned queue_size = 0;
+
+    std::string input_file_name = "-";
+    std::string output_file_name = "-";
+
+    // The mazes from "--maze" (we play the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--bad") {
+            bad_percent = static_cast<unsigned char>(std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--generate") {
+            generate_count = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--input") {
+            input_file_name = i_arguments[1 + a];
+        }
+        else if (argument == "--levels" && !load_level_settings(i_arguments[1 + a])) {
+            std::fprintf(stderr, "Can't read the level settings in %s.\n", i_arguments[1 + a]);
+
+            return 1;
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty() || validate_maze(mazes[0]) != nullptr) {
+                std::fprintf(stderr, "Can't play a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+        }
+        else if (argument == "--output") {
+            output_file_name = i_arguments[1 + a];
+        }
+        else if (argument == "--queue") {
+            queue_size = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--threads") {
+            thread_count = std::max(1, std::stoi(i_arguments[1 + a]));
+        }
+        else if (argument == "--ticks") {
+            generate_ticks = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    const std::vector<std::string>& map_sketch = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    std::FILE* output_file = output_file_name == "-" ? stdout : std::fopen(output_file_name.c_str(), generate_count == 0 ? "w" : "wb");
+
+    if (output_file == nullptr) {
+        std::fprintf(stderr, "Can't write %s.\n", output_file_name.c_str());
+
+        return 1;
+    }
+
+    if (generate_count != 0) {
+        bool written = generate_replays(output_file, generate_count, generate_ticks, bad_percent, map_sketch);
+
+        if (std::fclose(output_file) != 0 || !written) {
+            std::fprintf(stderr, "Can't write %s.\n", output_file_name.c_str());
+
+            return 1;
+        }
+
+        return 0;
+    }
+
+    std::FILE* input_file = input_file_name == "-" ? stdin : std::fopen(input_file_name.c_str(), "rb");
+
+    if (input_file == nullptr) {
+        std::fprintf(stderr, "Can't read %s.\n", input_file_name.c_str());
+
+        return 1;
+    }
+
+    // Enough replays for every worker to have one while the reader fills the next ones
+    if (queue_size == 0) {
+        queue_size = 4 * thread_count;
+    }
+
+    queue_size = std::max(queue_size, 1 + thread_count);
+
+    bool broken = 0;
+
+    unsigned read_count = 0;
+    unsigned valid_count = 0;
+    unsigned verdict_count = 0;
+
+    unsigned long long tick_count = 0;
+
+    // After --maze and --levels
+    unsigned long long setup_hash = get_replay_setup_hash(map_sketch);
+
+    // The replays are only ever in these slots. A slot goes from the free queue, to the reader, to the full queue, to a worker, and back.
+    std::vector<Replay> replays(queue_size);
+
+    BoundedQueue<unsigned> free_replays(queue_size);
+    BoundedQueue<unsigned> full_replays(queue_size + thread_count);
+    BoundedQueue<Verdict> verdicts(queue_size);
+
+    for (unsigned a = 0; a < queue_size; a++) {
+        free_replays.push(a);
+    }
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    std::thread writer(run_writer, output_file, std::ref(verdicts), std::ref(valid_count), std::ref(verdict_count), std::ref(tick_count));
+
+    std::vector<std::thread> workers;
+
+    for (unsigned a = 0; a < thread_count; a++) {
+        workers.emplace_back(run_worker, setup_hash, std::cref(map_sketch), std::ref(replays), std::ref(free_replays), std::ref(full_replays), std::ref(verdicts));
+    }
+
+    while (1) {
+        unsigned index = free_replays.pop();
+
+        // The stream may only end between two replays
+        int next_byte = std::fgetc(input_file);
+
+        if (next_byte == EOF) {
+            break;
+        }
+
+        std::ungetc(next_byte, input_file);
+
+        ReplayStatus status = read_replay(input_file, replays[index]);
+
+        // After a cut replay (or garbage), we can't know where the next one starts
+        if (status == BrokenReplay) {
+            broken = 1;
+
+            break;
+        }
+
+        read_count++;
+
+        // We don't even give it to a worker
+        if (status == RefusedReplay) {
+            Verdict verdict = {};
+            verdict.claimed_hash = replays[index].hash;
+            verdict.claimed_level = replays[index].level;
+            verdict.error = "too long, or a run of 0 ticks";
+            verdict.id = replays[index].id;
+
+            free_replays.push(index);
+            verdicts.push(verdict);
+
+            continue;
+        }
+
+        full_replays.push(index);
+    }
+
+    for (unsigned a = 0; a < thread_count; a++) {
+        full_replays.push(QUEUE_END);
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    Verdict end = {};
+    end.ticks = VERDICTS_END;
+
+    verdicts.push(end);
+
+    writer.join();
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    if (input_file != stdin) {
+        std::fclose(input_file);
+    }
+
+    if (output_file != stdout) {
+        std::fclose(output_file);
+    }
+
+    std::fprintf(stderr, "%u replays (%u OK, %u rejected) in %.2f s with %u threads: %.0f replays/s, %.1f million ticks/s.\n",
+        verdict_count, valid_count, verdict_count - valid_count, duration, thread_count, verdict_count / std::max(duration, 1e-9), tick_count / std::max(duration, 1e-9) / 1e6);
+
+    if (broken) {
+        std::fprintf(stderr, "The stream is broken after replay %u (a cut replay, or not a replay).\n", read_count);
+
+        return 1;
+    }
+}
@@ -0,0 +1,635 @@
+// Searches every game reachable from the start of a level, breadth first, to find the places the game can get stuck.
+// At every place Pacman can choose a way (a junction, a corner, a dead end), the search tries the 4 directions: Pacman holds one until the next such place (or until he dies, wins or stops).
+// The games are told apart by their hash (so the ghosts, the timers and the eaten pellets all count), and a game we've already seen isn't searched again.
+// It reports:
+// - the places where no direction moves Pacman (wedged by the way map_collision probes the corners),
+// - the pellets and energizers Pacman never ate,
+// - the ghosts that never left the house.
+// Every layer of the search is shared by the threads. The games waiting in the next layer are kept in memory up to --memory-states, the rest go to --spill as the inputs that lead to them (and are played again when it's their turn).
+// Usage: StateExplorer [--maze <file>] [--seed <seed>] [--max-depth <steps>] [--max-states <states>] [--threads <count>] [--memory-states <states>] [--spill <file>]
+
+#include <algorithm>  // For std::max and std::min
+#include <array>      // For std::array
+#include <atomic>     // For handing out the games to the threads
+#include <chrono>     // For measuring the throughput
+#include <cstdio>     // For printing the results and the spill file
+#include <functional> // For std::ref
+#include <mutex>      // For the visited set
+#include <string>     // For std::string
+#include <thread>     // For std::thread
+#include <unordered_set> // For the visited set
+#include <vector>     // For std::vector
+#include <SFML/Graphics.hpp> // SFML graphics library (the game can draw itself, but we never ask it to)
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"      // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp"  // Header for loading maze files
+
+// The longest path we can store (2 bits per step)
+constexpr unsigned short MAX_EXPLORER_DEPTH = 256;
+
+// Pacman stopped if he didn't move for this many ticks (some ticks don't move him at all, see get_step)
+constexpr unsigned char EXPLORER_STUCK_TICKS = 2 * TICK_MULTIPLIER;
+
+// The visited set is split into this many parts, each with its own lock
+constexpr unsigned short EXPLORER_SHARDS = 64;
+
+// A step never holds a direction for longer than 10 seconds
+constexpr unsigned short MAX_STEP_TICKS = 10000000 / FRAME_DURATION;
+
+// The directions Pacman held from the start of the level to reach a game. This is all we write to the spill file.
+struct ExplorerPath
+{
+    unsigned short depth;
+
+    std::array<unsigned char, MAX_EXPLORER_DEPTH / 4> directions;
+};
+
+struct ExplorerState
+{
+    ExplorerPath path;
+
+    Game game;
+};
+
+// One part of the visited set
+struct ExplorerShard
+{
+    std::mutex mutex;
+
+    std::unordered_set<unsigned long long> hashes;
+};
+
+// What a thread found. The threads only add them up at the end of a batch, so they never wait for each other.
+struct ExplorerResults
+{
+    // Did every ghost leave the house at least once?
+    std::array<bool, 4> ghost_left;
+
+    unsigned long long deaths;
+    // The new games we couldn't keep (the visited set was full, they were too deep, or they didn't fit in memory without a spill file), so the search isn't complete
+    unsigned long long dropped_states;
+    unsigned long long expanded_states;
+    unsigned long long ticks;
+    unsigned long long wins;
+
+    // 1 for every cell where Pacman ate something
+    std::vector<unsigned char> eaten_cells;
+
+    std::vector<ExplorerPath> wedged_paths;
+
+    std::vector<ExplorerState> children;
+};
+
+// The batch the threads are working on: the games themselves, or the paths to them (from the spill file)
+struct ExplorerBatch
+{
+    const std::vector<ExplorerState>* states;
+    const std::vector<ExplorerPath>* paths;
+
+    std::atomic<unsigned> next_state;
+};
+
+static std::array<ExplorerShard, EXPLORER_SHARDS> visited_shards;
+
+static std::atomic<unsigned long long> visited_count(0);
+
+static unsigned char get_path_direction(const ExplorerPath& i_path, unsigned short i_step) {
+    return (i_path.directions[i_step / 4] >> (2 * (i_step % 4))) & 3;
+}
+
+static ExplorerPath get_child_path(const ExplorerPath& i_path, unsigned char i_direction) {
+    ExplorerPath output = i_path;
+
+    if (output.depth % 4 == 0) {
+        output.directions[output.depth / 4] = 0;
+    }
+
+    output.directions[output.depth / 4] |= i_direction << (2 * (output.depth % 4));
+    output.depth++;
+
+    return output;
+}
+
+// Add a hash to the visited set. Returns 0 if it was already there, or if it's new but the set is full (then i_full is 1).
+static bool visit(unsigned long long i_hash, unsigned long long i_max_states, bool& i_full) {
+    ExplorerShard& shard = visited_shards[i_hash % EXPLORER_SHARDS];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    i_full = 0;
+
+    if (shard.hashes.count(i_hash) != 0) {
+        return 0;
+    }
+
+    if (i_max_states <= visited_count.load()) {
+        i_full = 1;
+
+        return 0;
+    }
+
+    shard.hashes.insert(i_hash);
+
+    visited_count++;
+
+    return 1;
+}
+
+// Can Pacman choose a way here? (He's in the middle of a cell, and it's not a straight corridor.)
+static bool get_decision_point(Game& i_game) {
+    Position position = i_game.get_pacman().get_position();
+
+    if (position.x % CELL_SIZE != 0 || position.y % CELL_SIZE != 0) {
+        return 0;
+    }
+
+    const Map& map = i_game.get_map();
+
+    std::array<bool, 4> open{};
+
+    // Right, up, left, down (outside the map is a tunnel, so it's open)
+    const std::array<Position, 4> neighbors = {
+        Position{ static_cast<short>(1 + position.x / CELL_SIZE), static_cast<short>(position.y / CELL_SIZE) },
+        Position{ static_cast<short>(position.x / CELL_SIZE), static_cast<short>(position.y / CELL_SIZE - 1) },
+        Position{ static_cast<short>(position.x / CELL_SIZE - 1), static_cast<short>(position.y / CELL_SIZE) },
+        Position{ static_cast<short>(position.x / CELL_SIZE), static_cast<short>(1 + position.y / CELL_SIZE) }
+    };
+
+    for (unsigned char a = 0; a < 4; a++) {
+        const Position& cell = neighbors[a];
+
+        open[a] = cell.x < 0 || cell.y < 0 || cell.x >= map.get_width() || cell.y >= map.get_height() ||
+            (map.get_cell(cell.x, cell.y) != Cell::Wall && map.get_cell(cell.x, cell.y) != Cell::Door);
+    }
+
+    // Only the straight corridors have no choice
+    return !((open[0] && open[2] && !open[1] && !open[3]) || (open[1] && open[3] && !open[0] && !open[2]));
+}
+
+// Hold a direction until Pacman gets to the next decision point, dies, wins or stops. Returns 0 if he never moved.
+static bool run_step(unsigned char i_direction, Game& i_game, unsigned long long& i_ticks) {
+    bool moved = 0;
+
+    unsigned char still_ticks = 0;
+
+    for (unsigned short a = 0; a < MAX_STEP_TICKS; a++) {
+        Position position = i_game.get_pacman().get_position();
+
+        i_game.update(static_cast<unsigned char>(1 << i_direction), 0);
+
+        i_ticks++;
+
+        if (i_game.get_game_won() || i_game.get_pacman().get_dead()) {
+            return 1;
+        }
+
+        if (position == i_game.get_pacman().get_position()) {
+            still_ticks++;
+
+            if (still_ticks == EXPLORER_STUCK_TICKS) {
+                break;
+            }
+        }
+        else {
+            moved = 1;
+            still_ticks = 0;
+
+            if (get_decision_point(i_game)) {
+                break;
+            }
+        }
+    }
+
+    return moved;
+}
+
+// Mark the cells where Pacman ate something between the parent and the child (only the chunks that changed)
+static void mark_eaten_cells(Game& i_parent, Game& i_child, std::vector<unsigned char>& i_eaten_cells) {
+    const Map& parent_map = i_parent.get_map();
+    const Map& child_map = i_child.get_map();
+
+    for (unsigned short a = 0; a < child_map.get_chunk_rows(); a++) {
+        for (unsigned short b = 0; b < child_map.get_chunk_columns(); b++) {
+            if (parent_map.get_chunk_version(b, a) == child_map.get_chunk_version(b, a)) {
+                continue;
+            }
+
+            unsigned short end_x = std::min<unsigned short>(child_map.get_width(), CHUNK_SIZE * (1 + b));
+            unsigned short end_y = std::min<unsigned short>(child_map.get_height(), CHUNK_SIZE * (1 + a));
+
+            for (unsigned short c = CHUNK_SIZE * a; c < end_y; c++) {
+                for (unsigned short d = CHUNK_SIZE * b; d < end_x; d++) {
+                    if (parent_map.get_cell(d, c) != child_map.get_cell(d, c)) {
+                        i_eaten_cells[d + child_map.get_width() * c] = 1;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Try the 4 directions from a game, and keep the children nobody has seen
+static void expand_state(const ExplorerState& i_state, unsigned long long i_max_states, Game& i_parent, Game& i_child, ExplorerResults& i_results) {
+    bool moved = 0;
+
+    i_results.expanded_states++;
+
+    for (unsigned char a = 0; a < 4; a++) {
+        // Copying into a game that has the memory doesn't allocate
+        i_child = i_parent;
+
+        if (!run_step(a, i_child, i_results.ticks)) {
+            continue;
+        }
+
+        moved = 1;
+
+        mark_eaten_cells(i_parent, i_child, i_results.eaten_cells);
+
+        for (unsigned char b = 0; b < 4; b++) {
+            if (!i_child.get_ghost_manager().get_ghosts()[b].get_use_door()) {
+                i_results.ghost_left[b] = 1;
+            }
+        }
+
+        bool full = 0;
+
+        if (!visit(i_child.get_hash(), i_max_states, full)) {
+            i_results.dropped_states += full;
+
+            continue;
+        }
+
+        // The end of a level has no children
+        if (i_child.get_pacman().get_dead()) {
+            i_results.deaths++;
+        }
+        else if (i_child.get_game_won()) {
+            i_results.wins++;
+        }
+        else if (i_state.path.depth < MAX_EXPLORER_DEPTH) {
+            i_results.children.push_back(ExplorerState{ get_child_path(i_state.path, a), i_child });
+        }
+        else {
+            i_results.dropped_states++;
+        }
+    }
+
+    if (!moved) {
+        i_results.wedged_paths.push_back(i_state.path);
+    }
+}
+
+// Expand the games of the batch until there are none left
+static void run_worker(ExplorerBatch& i_batch, const Game& i_root, unsigned long long i_max_states, ExplorerResults& i_results) {
+    // The parent (when we play a path again) and the child we're trying
+    Game parent = i_root;
+    Game child = i_root;
+
+    unsigned long long replay_ticks = 0;
+
+    unsigned size = static_cast<unsigned>(i_batch.states != nullptr ? i_batch.states->size() : i_batch.paths->size());
+
+    for (unsigned a = i_batch.next_state++; a < size; a = i_batch.next_state++) {
+        if (i_batch.states != nullptr) {
+            parent = (*i_batch.states)[a].game;
+
+            expand_state((*i_batch.states)[a], i_max_states, parent, child, i_results);
+
+            continue;
+        }
+
+        // A game from the spill file: play its path again from the start
+        const ExplorerPath& path = (*i_batch.paths)[a];
+
+        parent = i_root;
+
+        for (unsigned short b = 0; b < path.depth; b++) {
+            run_step(get_path_direction(path, b), parent, replay_ticks);
+        }
+
+        expand_state(ExplorerState{ path, parent }, i_max_states, parent, child, i_results);
+    }
+}
+
+// The paths of the games of one layer that didn't fit in memory
+struct ExplorerSpill
+{
+    unsigned long long path_count;
+
+    std::string file_name;
+
+    std::FILE* file;
+};
+
+// Keep at most i_memory_states games in memory, and write the paths of the others to the spill file (or drop them, without one)
+// Returns 0 if we couldn't write the spill file
+static bool spill_states(unsigned i_memory_states, ExplorerSpill& i_spill, std::vector<ExplorerState>& i_states, unsigned long long& i_dropped_states) {
+    if (i_states.size() <= i_memory_states) {
+        return 1;
+    }
+
+    if (i_spill.file_name.empty()) {
+        // They're already in the visited set, so we'll never find them again
+        i_dropped_states += i_states.size() - i_memory_states;
+    }
+    else {
+        if (i_spill.file == nullptr) {
+            i_spill.file = std::fopen(i_spill.file_name.c_str(), "w+b");
+
+            if (i_spill.file == nullptr) {
+                return 0;
+            }
+        }
+
+        for (std::size_t a = i_memory_states; a < i_states.size(); a++) {
+            if (std::fwrite(&i_states[a].path, sizeof(ExplorerPath), 1, i_spill.file) != 1) {
+                return 0;
+            }
+        }
+
+        i_spill.path_count += i_states.size() - i_memory_states;
+    }
+
+    i_states.erase(i_states.begin() + i_memory_states, i_states.end());
+
+    return 1;
+}
+
+// Run a batch on every thread, then add what they found to the totals (their children are the next layer)
+// Returns 0 if we couldn't write the spill file
+static bool run_batch(ExplorerBatch& i_batch, const Game& i_root, unsigned long long i_max_states, unsigned i_memory_states, std::vector<ExplorerResults>& i_results, ExplorerSpill& i_next_spill, ExplorerResults& i_totals) {
+    std::vector<std::thread> threads;
+
+    for (ExplorerResults& result : i_results) {
+        result.ghost_left = {};
+        result.deaths = 0;
+        result.dropped_states = 0;
+        result.expanded_states = 0;
+        result.ticks = 0;
+        result.wins = 0;
+        result.eaten_cells.assign(i_totals.eaten_cells.size(), 0);
+        result.wedged_paths.clear();
+        result.children.clear();
+
+        threads.push_back(std::thread(run_worker, std::ref(i_batch), std::cref(i_root), i_max_states, std::ref(result)));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (ExplorerResults& result : i_results) {
+        i_totals.deaths += result.deaths;
+        i_totals.dropped_states += result.dropped_states;
+        i_totals.expanded_states += result.expanded_states;
+        i_totals.ticks += result.ticks;
+        i_totals.wins += result.wins;
+
+        for (unsigned char a = 0; a < 4; a++) {
+            i_totals.ghost_left[a] = i_totals.ghost_left[a] || result.ghost_left[a];
+        }
+
+        for (std::size_t a = 0; a < i_totals.eaten_cells.size(); a++) {
+            i_totals.eaten_cells[a] |= result.eaten_cells[a];
+        }
+
+        i_totals.wedged_paths.insert(i_totals.wedged_paths.end(), result.wedged_paths.begin(), result.wedged_paths.end());
+        i_totals.children.insert(i_totals.children.end(), result.children.begin(), result.children.end());
+
+        if (!spill_states(i_memory_states, i_next_spill, i_totals.children, i_totals.dropped_states)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned seed = 1;
+    unsigned thread_count = std::max(1u, std::thread::hardware_concurrency());
+    unsigned memory_states = 100000;
+
+    unsigned short max_depth = MAX_EXPLORER_DEPTH;
+
+    unsigned long long max_states = 1000000;
+
+    std::string spill_file_name;
+
+    // The mazes from "--maze" (we explore the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+        }
+        else if (argument == "--max-depth") {
+            max_depth = static_cast<unsigned short>(std::min<unsigned long>(MAX_EXPLORER_DEPTH, std::stoul(i_arguments[1 + a])));
+        }
+        else if (argument == "--max-states") {
+            max_states = std::stoull(i_arguments[1 + a]);
+        }
+        else if (argument == "--memory-states") {
+            memory_states = std::max(1u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+        else if (argument == "--seed") {
+            seed = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--spill") {
+            spill_file_name = i_arguments[1 + a];
+        }
+        else if (argument == "--threads") {
+            thread_count = std::max(1u, static_cast<unsigned>(std::stoul(i_arguments[1 + a])));
+        }
+    }
+
+    const std::vector<std::string>& maze = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    Game root(0, seed, maze);
+
+    const Map& root_map = root.get_map();
+
+    // Everything the threads found, and the games of the next layer in its children
+    ExplorerResults totals = {};
+    totals.eaten_cells.resize(root_map.get_width() * root_map.get_height(), 0);
+
+    std::vector<ExplorerResults> results(thread_count);
+
+    // The games of this layer (the ones that didn't fit are in the spill file)
+    std::vector<ExplorerState> states;
+
+    // The spill files of this layer and the next one
+    std::array<ExplorerSpill, 2> spills = {
+        ExplorerSpill{ 0, spill_file_name.empty() ? "" : spill_file_name + ".0", nullptr },
+        ExplorerSpill{ 0, spill_file_name.empty() ? "" : spill_file_name + ".1", nullptr }
+    };
+
+    unsigned long long max_spilled_paths = 0;
+
+    std::vector<ExplorerPath> paths;
+
+    bool full = 0;
+
+    visit(root.get_hash(), max_states, full);
+
+    for (unsigned char a = 0; a < 4; a++) {
+        totals.ghost_left[a] = !root.get_ghost_manager().get_ghosts()[a].get_use_door();
+    }
+
+    states.push_back(ExplorerState{ ExplorerPath{}, root });
+
+    std::printf("Exploring a %ux%u maze (seed %u) on %u threads.\n", root_map.get_width(), root_map.get_height(), seed, thread_count);
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+
+    // The last layer we expanded
+    unsigned short expanded_depth = 0;
+
+    for (unsigned short depth = 0; depth < max_depth && (!states.empty() || spills[0].path_count != 0); depth++) {
+        unsigned long long layer_size = states.size() + spills[0].path_count;
+
+        ExplorerBatch batch;
+        batch.states = &states;
+        batch.paths = nullptr;
+        batch.next_state = 0;
+
+        if (!run_batch(batch, root, max_states, memory_states, results, spills[1], totals)) {
+            std::printf("Can't write the spill file %s.\n", spills[1].file_name.c_str());
+
+            return 1;
+        }
+
+        // The rest of this layer, from the spill file
+        if (spills[0].file != nullptr) {
+            std::rewind(spills[0].file);
+
+            while (spills[0].path_count != 0) {
+                paths.resize(static_cast<std::size_t>(std::min<unsigned long long>(memory_states, spills[0].path_count)));
+
+                if (std::fread(paths.data(), sizeof(ExplorerPath), paths.size(), spills[0].file) != paths.size()) {
+                    std::printf("Can't read the spill file %s.\n", spills[0].file_name.c_str());
+
+                    return 1;
+                }
+
+                spills[0].path_count -= paths.size();
+
+                batch.states = nullptr;
+                batch.paths = &paths;
+                batch.next_state = 0;
+
+                if (!run_batch(batch, root, max_states, memory_states, results, spills[1], totals)) {
+                    std::printf("Can't write the spill file %s.\n", spills[1].file_name.c_str());
+
+                    return 1;
+                }
+            }
+
+            std::fclose(spills[0].file);
+            std::remove(spills[0].file_name.c_str());
+
+            spills[0].file = nullptr;
+        }
+
+        max_spilled_paths = std::max(max_spilled_paths, spills[1].path_count);
+
+        expanded_depth = depth;
+
+        std::printf("Depth %3u: %10llu games, %10llu visited, %10llu on the disk for the next layer\n", depth, layer_size, visited_count.load(), spills[1].path_count);
+
+        states.swap(totals.children);
+        totals.children.clear();
+
+        std::swap(spills[0], spills[1]);
+
+        if (max_states <= visited_count.load()) {
+            break;
+        }
+    }
+
+    double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // Something is left to search (or a limit dropped some games), so "never" only means "not in the games we searched"
+    bool complete = states.empty() && spills[0].path_count == 0 && totals.dropped_states == 0;
+
+    if (spills[0].file != nullptr) {
+        std::fclose(spills[0].file);
+        std::remove(spills[0].file_name.c_str());
+    }
+
+    // The memory a game needs: the object, and the cells and versions of the map chunks
+    unsigned chunk_count = root_map.get_chunk_columns() * root_map.get_chunk_rows();
+    unsigned long long state_bytes = sizeof(ExplorerState) + chunk_count * (sizeof(std::array<Cell, CHUNK_SIZE * CHUNK_SIZE>) + sizeof(unsigned long long));
+
+    // And the visited set: the buckets, and a node with a pointer and the hash for every game (without what the allocator adds)
+    unsigned long long visited_bytes = 0;
+
+    for (ExplorerShard& shard : visited_shards) {
+        visited_bytes += shard.hashes.bucket_count() * sizeof(void*) + shard.hashes.size() * (sizeof(void*) + sizeof(unsigned long long));
+    }
+
+    std::printf("\n%llu games expanded to depth %u in %.2f s: %.0f games/s, %.2f M ticks/s (%s).\n",
+        totals.expanded_states, expanded_depth, duration, totals.expanded_states / duration, totals.ticks / duration / 1000000, complete ? "everything was searched" : "the limits stopped the search");
+    std::printf("Memory: %llu bytes for a game in memory, %u bytes for a game on the disk (%llu there at most), %.1f bytes for a visited game.\n",
+        state_bytes, static_cast<unsigned>(sizeof(ExplorerPath)), max_spilled_paths, static_cast<double>(visited_bytes) / std::max<unsigned long long>(1, visited_count.load()));
+    std::printf("Pacman died in %llu games and cleared the level in %llu.\n", totals.deaths, totals.wins);
+
+    if (totals.dropped_states != 0) {
+        std::printf("%llu new games were dropped (--max-states, --memory-states without --spill, or MAX_EXPLORER_DEPTH), so the lists below only cover the games we searched.\n", totals.dropped_states);
+    }
+
+    unsigned never_eaten = 0;
+
+    for (unsigned short a = 0; a < root_map.get_height(); a++) {
+        for (unsigned short b = 0; b < root_map.get_width(); b++) {
+            Cell cell = root_map.get_cell(b, a);
+
+            if ((cell == Cell::Pellet || cell == Cell::Energizer) && totals.eaten_cells[b + root_map.get_width() * a] == 0) {
+                // The first ones are enough to find them
+                if (never_eaten < 16) {
+                    std::printf("Never eaten: the %s at %u,%u.\n", cell == Cell::Pellet ? "pellet" : "energizer", b, a);
+                }
+
+                never_eaten++;
+            }
+        }
+    }
+
+    std::printf("%u pellets and energizers were never eaten.\n", never_eaten);
+
+    for (unsigned char a = 0; a < 4; a++) {
+        if (!totals.ghost_left[a]) {
+            std::printf("Ghost %u never left the house.\n", a);
+        }
+    }
+
+    for (std::size_t a = 0; a < std::min<std::size_t>(16, totals.wedged_paths.size()); a++) {
+        std::printf("Wedged after %u steps:", totals.wedged_paths[a].depth);
+
+        for (unsigned short b = 0; b < totals.wedged_paths[a].depth; b++) {
+            std::printf(" %c", "RULD"[get_path_direction(totals.wedged_paths[a], b)]);
+        }
+
+        std::printf("\n");
+    }
+
+    std::printf("Pacman was wedged in %u games.\n", static_cast<unsigned>(totals.wedged_paths.size()));
+
+    // Only a wedged Pacman is always a bug (the rest can be the limits of the search)
+    return totals.wedged_paths.empty() ? 0 : 1;
+}
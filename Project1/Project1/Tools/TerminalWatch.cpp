@@ -0,0 +1,311 @@
+// Shows a game in the terminal (Linux only, it asks the terminal for its size), so the games on a server without a display can be watched over SSH.
+// It plays random inputs (and starts again 2 seconds after Pacman dies or wins), or the inputs of a replay with --replay, at the speed of the game.
+// Every frame writes only the cells that changed (see Headers/TerminalRenderer.hpp), and the status line shows how many bytes per second that is and how long drawing takes.
+// --frames stops after that many frames and prints the same numbers for the whole run (with the output going to /dev/null, that's a quick benchmark).
+// Usage: TerminalWatch [--maze <file>] [--levels <file>] [--seed <seed>] [--replay <file>] [--frames <count>] [--columns <count>] [--rows <count>]
+
+#include <algorithm> // For std::max
+#include <array>     // For std::array
+#include <atomic>    // For stopping with Ctrl+C
+#include <chrono>    // For the speed of the game and timing the frames
+#include <csignal>   // For stopping with Ctrl+C and the resizes
+#include <cstdio>    // For printing the results
+#include <ctime>     // For the CPU time of the process
+#include <string>    // For std::string
+#include <thread>    // For std::this_thread::sleep_until
+#include <vector>    // For std::vector
+#include <sys/ioctl.h> // For the size of the terminal
+#include <unistd.h>    // For write
+#include <SFML/Graphics.hpp> // For SFML graphics components (the game's headers need them, there's no window)
+
+#include "../Headers/Global.hpp"           // Header for global constants and definitions
+#include "../Headers/Map.hpp"              // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"    // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp"   // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"           // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"            // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"     // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"      // Header for drawing the game map
+#include "../Headers/Game.hpp"             // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"        // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp"    // Header for loading maze files
+#include "../Headers/Random.hpp"           // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"          // Header for the random player
+#include "../Headers/Replay.hpp"           // Header for reading the replays
+#include "../Headers/TerminalRenderer.hpp" // Header for the TerminalRenderer class definition
+
+// How long a finished level stays on the terminal before the game starts again
+constexpr unsigned short RESTART_TICKS = 2000000 / FRAME_DURATION;
+
+static std::atomic<bool> running(1);
+// Did the terminal change its size?
+static std::atomic<bool> resized(0);
+
+static void stop(int) {
+    running = 0;
+}
+
+static void resize(int) {
+    resized = 1;
+}
+
+// Ask the terminal for its size (if the output isn't a terminal, we keep the one we have)
+static void get_terminal_size(unsigned short& i_columns, unsigned short& i_rows) {
+    winsize size;
+
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col != 0 && size.ws_row != 0) {
+        i_columns = size.ws_col;
+        i_rows = size.ws_row;
+    }
+}
+
+// Write everything (the terminal must get all of a frame). Returns 0 if the terminal is gone.
+static bool write_output(const std::string& i_output) {
+    std::size_t written = 0;
+
+    while (written < i_output.size()) {
+        ssize_t size = write(STDOUT_FILENO, i_output.data() + written, i_output.size() - written);
+
+        if (size <= 0) {
+            return 0;
+        }
+
+        written += size;
+    }
+
+    return 1;
+}
+
+// The CPU time of the whole process, in seconds
+static double get_cpu_time() {
+    timespec time;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+
+    return time.tv_sec + 1e-9 * time.tv_nsec;
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned seed = 1;
+
+    // 0 means until Ctrl+C
+    unsigned long long frame_count = 0;
+
+    unsigned short columns = 80;
+    unsigned short rows = 24;
+
+    // Did we get a size from the arguments? (Then we don't ask the terminal.)
+    bool fixed_size = 0;
+
+    std::vector<std::vector<std::string>> mazes;
+
+    // The replay we watch (if there's one), and the run and tick of it we're in
+    bool watch_replay = 0;
+
+    unsigned replay_run = 0;
+    unsigned short replay_tick = 0;
+
+    Replay replay;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--columns") {
+            columns = static_cast<unsigned short>(std::max(2, std::stoi(i_arguments[1 + a])));
+            fixed_size = 1;
+        }
+        else if (argument == "--frames") {
+            frame_count = std::stoull(i_arguments[1 + a]);
+        }
+        else if (argument == "--levels" && !load_level_settings(i_arguments[1 + a])) {
+            std::printf("Can't read the level settings in %s.\n", i_arguments[1 + a]);
+
+            return 1;
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+
+            const char* error = validate_maze(mazes[0]);
+
+            if (error != nullptr) {
+                std::printf("Can't play the maze in %s: %s\n", i_arguments[1 + a], error);
+
+                return 1;
+            }
+        }
+        else if (argument == "--replay") {
+            std::FILE* file = std::fopen(i_arguments[1 + a], "rb");
+
+            watch_replay = file != nullptr && read_replay(file, replay) == ValidReplay;
+
+            if (file != nullptr) {
+                std::fclose(file);
+            }
+
+            if (!watch_replay) {
+                std::printf("Can't read a replay in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+        }
+        else if (argument == "--rows") {
+            rows = static_cast<unsigned short>(std::max(2, std::stoi(i_arguments[1 + a])));
+            fixed_size = 1;
+        }
+        else if (argument == "--seed") {
+            seed = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    std::vector<std::string> maze = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    // The replay would play another game than the one that was verified
+    if (watch_replay && replay.setup_hash != get_replay_setup_hash(maze)) {
+        std::printf("The replay was played with another maze or other level settings (see --maze and --levels).\n");
+
+        return 1;
+    }
+
+    Game game(watch_replay && replay.versus, watch_replay ? replay.seed : seed, maze);
+
+    if (watch_replay) {
+        game.set_ghost_simulation_radius(replay.ghost_simulation_radius);
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+    std::signal(SIGWINCH, resize);
+    // A closed SSH session makes write fail instead
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (!fixed_size) {
+        get_terminal_size(columns, rows);
+    }
+
+    TerminalRenderer renderer;
+    renderer.resize(columns, rows);
+
+    RandomPlayer player = get_random_player(seed);
+
+    unsigned short finished_ticks = 0;
+
+    // The totals, and the ones since the status line was last updated
+    unsigned long long frames = 0;
+    unsigned long long total_bytes = 0;
+    unsigned long long total_cells = 0;
+
+    double total_draw_time = 0;
+
+    unsigned long long second_bytes = 0;
+    unsigned long long second_frames = 0;
+
+    double second_draw_time = 0;
+
+    // What the status line says about us
+    char note[64] = "";
+
+    std::chrono::time_point<std::chrono::steady_clock> start_time = std::chrono::steady_clock::now();
+    std::chrono::time_point<std::chrono::steady_clock> second_time = start_time;
+    std::chrono::time_point<std::chrono::steady_clock> frame_time = start_time;
+
+    double start_cpu_time = get_cpu_time();
+    double second_cpu_time = start_cpu_time;
+
+    while (running && (frame_count == 0 || frames < frame_count)) {
+        if (resized.exchange(0) && !fixed_size) {
+            get_terminal_size(columns, rows);
+
+            renderer.resize(columns, rows);
+        }
+
+        // The ticks of one 60 Hz frame
+        for (unsigned char a = 0; a < TICK_MULTIPLIER; a++) {
+            if (watch_replay) {
+                // The runs we're done with (a run of 0 ticks isn't played at all, like in verify_replay)
+                while (replay_run < replay.runs.size() && replay_tick == replay.runs[replay_run].length) {
+                    replay_run++;
+                    replay_tick = 0;
+                }
+
+                // The replay is over, so we keep showing how it ended
+                if (replay_run == replay.runs.size()) {
+                    break;
+                }
+
+                replay_tick++;
+
+                game.update(replay.runs[replay_run].pacman_input, replay.runs[replay_run].ghost_input);
+
+                continue;
+            }
+
+            unsigned char input = 0;
+
+            if (game.get_game_won() || game.get_pacman().get_dead()) {
+                finished_ticks++;
+
+                if (finished_ticks == RESTART_TICKS) {
+                    finished_ticks = 0;
+
+                    input = INPUT_RESTART;
+                }
+            }
+            else {
+                input = get_random_input(player);
+            }
+
+            game.update(input, 0);
+        }
+
+        std::chrono::time_point<std::chrono::steady_clock> draw_time = std::chrono::steady_clock::now();
+
+        const std::string& output = renderer.draw(game, note);
+
+        double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - draw_time).count();
+
+        if (!write_output(output)) {
+            break;
+        }
+
+        frames++;
+        total_bytes += output.size();
+        total_cells += renderer.get_changed_cells();
+        total_draw_time += duration;
+
+        second_bytes += output.size();
+        second_draw_time += duration;
+        second_frames++;
+
+        std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+        // Once a second, the bytes per second, the time per draw, and how much of a core the whole program uses
+        if (now - second_time >= std::chrono::seconds(1)) {
+            double seconds = std::chrono::duration<double>(now - second_time).count();
+            double cpu_time = get_cpu_time();
+
+            std::snprintf(note, sizeof(note), "%.0f B/s  draw %.1f us  CPU %.2f%%", second_bytes / seconds, 1e6 * second_draw_time / second_frames, 100 * (cpu_time - second_cpu_time) / seconds);
+
+            second_bytes = 0;
+            second_cpu_time = cpu_time;
+            second_draw_time = 0;
+            second_frames = 0;
+            second_time = now;
+        }
+
+        // The speed of the game (if we're late, we don't try to catch up)
+        frame_time = std::max(now, frame_time + std::chrono::microseconds(FRAME_DURATION * TICK_MULTIPLIER));
+
+        std::this_thread::sleep_until(frame_time);
+    }
+
+    write_output(renderer.finish());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    std::printf("%llu frames, %llu cells written (%.2f per frame), %llu bytes (%.1f per frame, %.0f per second).\n", frames, total_cells, total_cells / std::max(1.0, static_cast<double>(frames)), total_bytes, total_bytes / std::max(1.0, static_cast<double>(frames)), total_bytes / seconds);
+    std::printf("Drawing took %.2f us per frame, and the program used %.2f%% of a core.\n", 1e6 * total_draw_time / std::max(1.0, static_cast<double>(frames)), 100 * (get_cpu_time() - start_cpu_time) / seconds);
+}
@@ -0,0 +1,193 @@
+// Shows dozens of games in one window (see Headers/VideoWall.hpp), like a wall of screens in a control room.
+// Every game is played by random inputs in worker threads, at the speed of the game, and starts again 2 seconds after Pacman dies or wins.
+// The workers publish a copy of every game after every tick, and the window redraws only the tiles that changed.
+// Once a second, it prints how many tiles a frame redrew and how many draw calls it made.
+// Usage: VideoWall [--games <count>] [--threads <count>] [--maze <file>] [--width <pixels>] [--height <pixels>]
+
+#include <algorithm> // For std::max and std::min
+#include <array>     // For std::array
+#include <atomic>    // For stopping the workers
+#include <chrono>    // For the speed of the game
+#include <cstdio>    // For printing the draw calls
+#include <functional> // For std::ref
+#include <memory>    // For std::unique_ptr
+#include <mutex>     // For the snapshots
+#include <string>    // For std::string
+#include <thread>    // For the workers
+#include <vector>    // For std::vector
+#include <SFML/Graphics.hpp> // For the window
+
+#include "../Headers/Global.hpp"         // Header for global constants and definitions
+#include "../Headers/Map.hpp"            // Header for the Map class definition
+#include "../Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "../Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "../Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "../Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "../Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "../Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "../Headers/Game.hpp"           // Header for the Game class definition
+#include "../Headers/MapSketch.hpp"      // Header for the default map sketch
+#include "../Headers/MazeGenerator.hpp"  // Header for loading maze files
+#include "../Headers/Random.hpp"         // Header for the deterministic random number generator
+#include "../Headers/Players.hpp"        // Header for the random player
+#include "../Headers/VideoWall.hpp"      // Header for the VideoWall class definition
+
+// How long a finished level stays on the wall before the game starts again
+constexpr unsigned short RESTART_TICKS = 2000000 / FRAME_DURATION;
+
+// Play the games i_first, i_first + i_step... until we're told to stop
+static void run_worker(unsigned short i_first, unsigned short i_step, unsigned short i_game_count, const std::vector<std::string>& i_maze, const std::atomic<bool>& i_stop, VideoWall& i_wall) {
+    std::vector<std::unique_ptr<Game>> games;
+
+    // The player of every game, and how many ticks it's been finished
+    std::vector<RandomPlayer> players;
+    std::vector<unsigned short> finished_ticks;
+
+    for (unsigned short a = i_first; a < i_game_count; a += i_step) {
+        games.emplace_back(new Game(0, 1 + a, i_maze));
+        players.push_back(get_random_player(1 + a));
+        finished_ticks.push_back(0);
+    }
+
+    std::chrono::time_point<std::chrono::steady_clock> tick_time = std::chrono::steady_clock::now();
+
+    while (!i_stop.load()) {
+        for (unsigned short a = 0; a < games.size(); a++) {
+            Game& game = *games[a];
+
+            unsigned char input = 0;
+
+            if (game.get_game_won() || game.get_pacman().get_dead()) {
+                finished_ticks[a]++;
+
+                if (finished_ticks[a] == RESTART_TICKS) {
+                    finished_ticks[a] = 0;
+
+                    input = INPUT_RESTART;
+                }
+            }
+            else {
+                input = get_random_input(players[a]);
+            }
+
+            game.update(input, 0);
+
+            i_wall.publish(static_cast<unsigned short>(i_first + i_step * a), game);
+        }
+
+        // The speed of the game (if we're late, we don't try to catch up)
+        tick_time = std::max(std::chrono::steady_clock::now(), tick_time + std::chrono::microseconds(FRAME_DURATION));
+
+        std::this_thread::sleep_until(tick_time);
+    }
+}
+
+int main(int i_argument_count, char** i_arguments) {
+    unsigned short game_count = 16;
+    unsigned short thread_count = static_cast<unsigned short>(std::max(2u, std::thread::hardware_concurrency()) - 1);
+
+    unsigned height = 720;
+    unsigned width = 1280;
+
+    // The mazes from "--maze" (every game plays the first one)
+    std::vector<std::vector<std::string>> mazes;
+
+    for (int a = 1; a + 1 < i_argument_count; a += 2) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--games") {
+            game_count = static_cast<unsigned short>(std::max(1, std::stoi(i_arguments[1 + a])));
+        }
+        else if (argument == "--height") {
+            height = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+        else if (argument == "--maze") {
+            if (!load_mazes(i_arguments[1 + a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[1 + a]);
+
+                return 1;
+            }
+
+            const char* error = validate_maze(mazes[0]);
+
+            if (error != nullptr) {
+                std::printf("Can't play the maze in %s: %s\n", i_arguments[1 + a], error);
+
+                return 1;
+            }
+        }
+        else if (argument == "--threads") {
+            thread_count = static_cast<unsigned short>(std::max(1, std::stoi(i_arguments[1 + a])));
+        }
+        else if (argument == "--width") {
+            width = static_cast<unsigned>(std::stoul(i_arguments[1 + a]));
+        }
+    }
+
+    thread_count = std::min(thread_count, game_count);
+
+    std::vector<std::string> maze = mazes.empty() ? get_map_sketch() : mazes[0];
+
+    VideoWall wall;
+
+    if (!wall.create(game_count, static_cast<unsigned short>(maze[0].size()), static_cast<unsigned short>(maze.size()), width, height)) {
+        std::printf("%u games of %ux%u cells don't fit in a texture.\n", game_count, static_cast<unsigned>(maze[0].size()), static_cast<unsigned>(maze.size()));
+
+        return 1;
+    }
+
+    sf::RenderWindow window(sf::VideoMode(width, height), "Pac-Man video wall", sf::Style::Close);
+
+    window.setVerticalSyncEnabled(1);
+    window.setView(sf::View(sf::FloatRect(0, 0, static_cast<float>(width), static_cast<float>(height))));
+
+    std::atomic<bool> stop(0);
+
+    std::vector<std::thread> threads;
+
+    for (unsigned short a = 0; a < thread_count; a++) {
+        threads.push_back(std::thread(run_worker, a, thread_count, game_count, std::cref(maze), std::cref(stop), std::ref(wall)));
+    }
+
+    // What we print once a second
+    unsigned frames = 0;
+    unsigned long long draw_calls = 0;
+    unsigned long long redrawn_tiles = 0;
+
+    std::chrono::time_point<std::chrono::steady_clock> print_time = std::chrono::steady_clock::now();
+
+    while (window.isOpen()) {
+        sf::Event event;
+
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+        }
+
+        // The wall covers the whole window, so we don't clear it
+        wall.draw(window);
+
+        window.display();
+
+        frames++;
+        draw_calls += wall.get_draw_calls();
+        redrawn_tiles += wall.get_redrawn_tiles();
+
+        if (std::chrono::seconds(1) <= std::chrono::steady_clock::now() - print_time) {
+            std::printf("%u frames, %.1f of %u tiles and %.1f draw calls per frame\n", frames, static_cast<double>(redrawn_tiles) / frames, game_count, static_cast<double>(draw_calls) / frames);
+
+            frames = 0;
+            draw_calls = 0;
+            redrawn_tiles = 0;
+
+            print_time = std::chrono::steady_clock::now();
+        }
+    }
+
+    stop.store(1);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
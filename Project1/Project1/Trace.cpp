@@ -0,0 +1,241 @@
+#include <algorithm> // For std::min
+#include <array>  // For std::array
+#include <atomic> // For the ring buffers
+#include <chrono> // For the timestamps
+#include <cstdio> // For writing the trace file
+#include <memory> // For std::unique_ptr
+#include <mutex>  // For the list of ring buffers
+#include <string> // For std::string
+#include <vector> // For std::vector
+
+#include "Headers/Trace.hpp" // Header for the trace zones
+
+#ifdef PAKKU_TRACE
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>    // For __rdtsc
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // For __rdtsc
+#endif
+
+// How many zones every thread remembers
+constexpr unsigned TRACE_BUFFER_SIZE = 65536;
+
+// One finished zone (the times are in clock ticks, see get_trace_time)
+// The fields are atomic because save_trace can read them while the thread writes new zones
+struct TraceEvent
+{
+    std::atomic<const char*> name;
+
+    std::atomic<unsigned long long> duration;
+    // 2 * (the number of the zone) + 1 while the thread writes it, and + 2 once it's done, so save_trace can tell if it read a whole zone
+    std::atomic<unsigned long long> sequence;
+    std::atomic<unsigned long long> start_time;
+};
+
+// The zones of one thread. Only that thread writes them, so there are no locks.
+struct TraceBuffer
+{
+    unsigned thread_id;
+
+    // How many zones were ever written (the newest one is at (event_count - 1) % TRACE_BUFFER_SIZE)
+    std::atomic<unsigned long long> event_count;
+
+    std::string thread_name;
+
+    std::array<TraceEvent, TRACE_BUFFER_SIZE> events;
+};
+
+// Every buffer ever made. They're never deleted, so we can still save the zones of threads that ended.
+static std::mutex trace_mutex;
+
+static std::vector<std::unique_ptr<TraceBuffer>> trace_buffers;
+
+// Read the clock. On x86, that's the time stamp counter (a few nanoseconds, instead of tens for steady_clock).
+// save_trace turns the ticks into nanoseconds, by comparing them with steady_clock since the first zone.
+static unsigned long long get_trace_time() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// When the first buffer was made, in clock ticks and in steady_clock time
+static unsigned long long trace_start_ticks;
+
+static std::chrono::time_point<std::chrono::steady_clock> trace_start_time;
+
+// Get the buffer of the current thread (the first zone of a thread makes it)
+static TraceBuffer& get_trace_buffer() {
+    thread_local TraceBuffer* buffer = nullptr;
+
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+
+        if (trace_buffers.empty()) {
+            trace_start_ticks = get_trace_time();
+            trace_start_time = std::chrono::steady_clock::now();
+        }
+
+        trace_buffers.emplace_back(new TraceBuffer());
+
+        buffer = trace_buffers.back().get();
+        buffer->thread_id = static_cast<unsigned>(trace_buffers.size());
+        buffer->event_count = 0;
+        buffer->thread_name = "Thread " + std::to_string(buffer->thread_id);
+    }
+
+    return *buffer;
+}
+
+// Start a zone
+TraceZone::TraceZone(const char* i_name) :
+    name(i_name),
+    start_time(get_trace_time())
+{
+}
+
+// End a zone and put it in the ring buffer
+TraceZone::~TraceZone() {
+    unsigned long long end_time = get_trace_time();
+
+    TraceBuffer& buffer = get_trace_buffer();
+
+    unsigned long long index = buffer.event_count.load(std::memory_order_relaxed);
+
+    TraceEvent& event = buffer.events[index % TRACE_BUFFER_SIZE];
+    event.sequence.store(2 * index + 1, std::memory_order_relaxed);
+
+    // The odd sequence must be seen before any of the new fields
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.name.store(name, std::memory_order_relaxed);
+    event.duration.store(end_time - start_time, std::memory_order_relaxed);
+    event.start_time.store(start_time, std::memory_order_relaxed);
+    event.sequence.store(2 * index + 2, std::memory_order_release);
+
+    buffer.event_count.store(1 + index, std::memory_order_release);
+}
+
+// Write a string between quotes, escaped for JSON (the thread names can be anything)
+static void write_json_string(std::FILE* i_file, const char* i_text) {
+    std::fputc('"', i_file);
+
+    for (const char* character = i_text; *character != 0; character++) {
+        unsigned char code = static_cast<unsigned char>(*character);
+
+        if (code == '"' || code == '\\') {
+            std::fputc('\\', i_file);
+            std::fputc(code, i_file);
+        }
+        else if (code < 32) {
+            std::fprintf(i_file, "\\u%04x", code);
+        }
+        else {
+            std::fputc(code, i_file);
+        }
+    }
+
+    std::fputc('"', i_file);
+}
+
+// Save the zones of every thread
+bool save_trace(const std::string& i_file_name) {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    std::FILE* file = std::fopen(i_file_name.c_str(), "w");
+
+    if (file == nullptr) {
+        return 0;
+    }
+
+    // How many nanoseconds one clock tick is
+    double tick_duration = 1;
+
+    if (!trace_buffers.empty()) {
+        unsigned long long ticks = get_trace_time() - trace_start_ticks;
+
+        if (ticks != 0) {
+            tick_duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - trace_start_time).count() / ticks;
+        }
+    }
+
+    // The trace starts at the oldest zone we have
+    unsigned long long first_time = ~0ull;
+
+    std::vector<std::vector<std::array<unsigned long long, 2>>> times(trace_buffers.size());
+    std::vector<std::vector<const char*>> names(trace_buffers.size());
+
+    for (unsigned a = 0; a < trace_buffers.size(); a++) {
+        TraceBuffer& buffer = *trace_buffers[a];
+
+        unsigned long long event_count = buffer.event_count.load(std::memory_order_acquire);
+        unsigned long long first_event = TRACE_BUFFER_SIZE < event_count ? event_count - TRACE_BUFFER_SIZE : 0;
+
+        for (unsigned long long b = first_event; b < event_count; b++) {
+            TraceEvent& event = buffer.events[b % TRACE_BUFFER_SIZE];
+
+            unsigned long long sequence = event.sequence.load(std::memory_order_acquire);
+
+            const char* name = event.name.load(std::memory_order_relaxed);
+
+            std::array<unsigned long long, 2> time = { event.start_time.load(std::memory_order_relaxed), event.duration.load(std::memory_order_relaxed) };
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // The thread kept going while we copied, so the zone was overwritten (maybe halfway). We throw it away.
+            if (sequence != 2 * b + 2 || event.sequence.load(std::memory_order_relaxed) != sequence) {
+                continue;
+            }
+
+            names[a].push_back(name);
+            times[a].push_back(time);
+        }
+
+        for (const std::array<unsigned long long, 2>& time : times[a]) {
+            first_time = std::min(first_time, time[0]);
+        }
+    }
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    for (unsigned a = 0; a < trace_buffers.size(); a++) {
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", a == 0 ? "" : ",\n", trace_buffers[a]->thread_id);
+
+        write_json_string(file, trace_buffers[a]->thread_name.c_str());
+
+        std::fprintf(file, "}}");
+
+        for (unsigned b = 0; b < names[a].size(); b++) {
+            std::fprintf(file, ",\n{\"name\":");
+
+            write_json_string(file, names[a][b]);
+
+            std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                trace_buffers[a]->thread_id, tick_duration * (times[a][b][0] - first_time) / 1000, tick_duration * times[a][b][1] / 1000);
+        }
+    }
+
+    std::fprintf(file, "\n]}\n");
+
+    return std::fclose(file) == 0;
+}
+
+// Name the current thread
+void set_trace_thread_name(const std::string& i_name) {
+    TraceBuffer& buffer = get_trace_buffer();
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    buffer.thread_name = i_name;
+}
+#else
+// Tracing is off, so there's nothing to save
+bool save_trace(const std::string&) {
+    return 0;
+}
+
+// Tracing is off, so nobody will see the name
+void set_trace_thread_name(const std::string&) {
+}
+#endif
@@ -0,0 +1,361 @@
+#include <algorithm> // For std::max and std::min
+#include <array>  // For std::array
+#include <cmath>  // For floor
+#include <memory> // For std::unique_ptr
+#include <mutex>  // For guarding the snapshots
+#include <tuple>  // For the list of ghost personalities
+#include <vector> // For std::vector
+#include <SFML/Graphics.hpp> // For SFML graphics components
+
+#include "Headers/Global.hpp"         // Header for global constants and definitions
+#include "Headers/Map.hpp"            // Header for the Map class definition
+#include "Headers/LevelSettings.hpp"  // Header for the per-level settings
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
+#include "Headers/Pacman.hpp"         // Header for Pac-Man class definition
+#include "Headers/Ghost.hpp"          // Header for Ghost class definition
+#include "Headers/GhostPersonalities.hpp" // Header for the colors of the ghosts
+#include "Headers/GhostManager.hpp"   // Header for GhostManager class definition
+#include "Headers/MapRenderer.hpp"    // Header for drawing the game map
+#include "Headers/Game.hpp"           // Header for the Game class definition
+#include "Headers/Trace.hpp"          // Header for the trace zones
+#include "Headers/VideoWall.hpp"      // Header for the VideoWall class definition
+
+// The pixel of every cell on a small tile, in the order of the Cell enum (the pellets are dim, so the walls stand out)
+const std::array<sf::Color, 5> CELL_COLORS = {
+    sf::Color(255, 182, 255),
+    sf::Color(0, 0, 0),
+    sf::Color(255, 255, 255),
+    sf::Color(128, 128, 128),
+    sf::Color(36, 36, 255)
+};
+
+// A small tile whose level is over (Pacman died or ate everything) is darker
+const sf::Color FINISHED_TILE_COLOR(96, 96, 96);
+
+// Add a square of one color
+static void append_square(sf::VertexArray& i_vertices, float i_x, float i_y, float i_size, const sf::Color& i_color) {
+    i_vertices.append(sf::Vertex(sf::Vector2f(i_x, i_y), i_color, sf::Vector2f()));
+    i_vertices.append(sf::Vertex(sf::Vector2f(i_size + i_x, i_y), i_color, sf::Vector2f()));
+    i_vertices.append(sf::Vertex(sf::Vector2f(i_size + i_x, i_size + i_y), i_color, sf::Vector2f()));
+    i_vertices.append(sf::Vertex(sf::Vector2f(i_x, i_size + i_y), i_color, sf::Vector2f()));
+}
+
+// Where a square starts on one axis of a tile. It stays inside the tile (Pacman and the ghosts stick out in the tunnels), or it would stay on the canvas after it moved.
+static float get_square_start(float i_tile_start, float i_tile_size, float i_offset, float i_size) {
+    return std::max(i_tile_start, std::min(i_tile_start + i_tile_size - i_size, i_tile_start + i_offset));
+}
+
+// Constructor for the VideoWall class (it has no tiles until it's created)
+VideoWall::VideoWall() :
+    detailed(0),
+    columns(1),
+    draw_calls(0),
+    map_height(0),
+    map_width(0),
+    redrawn_tiles(0),
+    cell_size(0),
+    cell_vertices(sf::Quads),
+    entity_vertices(sf::Quads)
+{
+}
+
+bool VideoWall::create(unsigned short i_tile_count, unsigned short i_map_width, unsigned short i_map_height, unsigned i_width, unsigned i_height) {
+    i_tile_count = std::max<unsigned short>(1, i_tile_count);
+
+    map_height = i_map_height;
+    map_width = i_map_width;
+
+    cell_size = 0;
+
+    // Try every number of columns (there's a 1 pixel gap between the tiles)
+    for (unsigned short a = 1; a <= i_tile_count; a++) {
+        unsigned short rows = static_cast<unsigned short>((a + i_tile_count - 1) / a);
+
+        float width_cell_size = (static_cast<float>(i_width) - (a - 1)) / (a * map_width);
+        float height_cell_size = (static_cast<float>(i_height) - (rows - 1)) / (rows * map_height);
+
+        if (cell_size < std::min(width_cell_size, height_cell_size)) {
+            cell_size = std::min(width_cell_size, height_cell_size);
+
+            columns = a;
+        }
+    }
+
+    detailed = cell_size >= VIDEO_WALL_DETAIL_SIZE;
+
+    if (!canvas.create(i_width, i_height)) {
+        return 0;
+    }
+
+    canvas.clear();
+
+    // The sprites don't need this one
+    if (!detailed) {
+        unsigned short rows = static_cast<unsigned short>((columns + i_tile_count - 1) / columns);
+
+        if (!cell_texture.create(columns * map_width, rows * map_height)) {
+            return 0;
+        }
+    }
+
+    chunk_pixels.resize(4 * CHUNK_SIZE * CHUNK_SIZE);
+
+    tiles.clear();
+
+    for (unsigned short a = 0; a < i_tile_count; a++) {
+        // The () zeroes the versions and the hash
+        tiles.emplace_back(new VideoWallTile());
+    }
+
+    return 1;
+}
+
+sf::Vector2f VideoWall::get_tile_position(unsigned short i_tile) const {
+    // Whole pixels, so the maps don't get blurry seams
+    return sf::Vector2f(
+        floor((i_tile % columns) * (1 + cell_size * map_width)),
+        floor((i_tile / columns) * (1 + cell_size * map_height))
+    );
+}
+
+unsigned short VideoWall::get_draw_calls() {
+    return draw_calls;
+}
+
+unsigned short VideoWall::get_redrawn_tiles() {
+    return redrawn_tiles;
+}
+
+void VideoWall::publish(unsigned short i_tile, Game& i_game) {
+    VideoWallTile& tile = *tiles[i_tile];
+
+    std::lock_guard<std::mutex> lock(tile.mutex);
+
+    // Only the first copy allocates
+    if (tile.snapshot == nullptr) {
+        tile.snapshot.reset(new Game(i_game));
+    }
+    else {
+        *tile.snapshot = i_game;
+    }
+
+    tile.version++;
+}
+
+// Send the chunks that changed since we last drew the tile to its part of the cell texture
+void VideoWall::update_cell_texture(unsigned short i_tile) {
+    VideoWallTile& tile = *tiles[i_tile];
+
+    const Map& map = tile.game->get_map();
+
+    unsigned short texture_x = map_width * (i_tile % columns);
+    unsigned short texture_y = map_height * (i_tile / columns);
+
+    // 0 is a version no chunk has, so every chunk is sent the first time
+    tile.chunk_versions.resize(map.get_chunk_columns() * map.get_chunk_rows(), 0);
+
+    for (unsigned short a = 0; a < map.get_chunk_rows(); a++) {
+        for (unsigned short b = 0; b < map.get_chunk_columns(); b++) {
+            unsigned long long& version = tile.chunk_versions[b + map.get_chunk_columns() * a];
+
+            if (version == map.get_chunk_version(b, a)) {
+                continue;
+            }
+
+            version = map.get_chunk_version(b, a);
+
+            // The last chunks of a row or a column can stick out of the map
+            unsigned short width = std::min<unsigned short>(CHUNK_SIZE, map_width - CHUNK_SIZE * b);
+            unsigned short height = std::min<unsigned short>(CHUNK_SIZE, map_height - CHUNK_SIZE * a);
+
+            for (unsigned short c = 0; c < height; c++) {
+                for (unsigned short d = 0; d < width; d++) {
+                    const sf::Color& color = CELL_COLORS[map.get_cell(d + CHUNK_SIZE * b, c + CHUNK_SIZE * a)];
+
+                    sf::Uint8* pixel = &chunk_pixels[4 * (d + width * c)];
+
+                    pixel[0] = color.r;
+                    pixel[1] = color.g;
+                    pixel[2] = color.b;
+                    pixel[3] = color.a;
+                }
+            }
+
+            cell_texture.update(chunk_pixels.data(), width, height, texture_x + CHUNK_SIZE * b, texture_y + CHUNK_SIZE * a);
+        }
+    }
+}
+
+// Add the quads of a small tile: its part of the cell texture, and a square for Pacman and every ghost
+void VideoWall::add_small_tile(unsigned short i_tile) {
+    Game& game = *tiles[i_tile]->game;
+
+    bool finished = game.get_game_won() || game.get_pacman().get_dead();
+
+    // The squares are a cell big, but never smaller than a pixel
+    float entity_size = std::max(1.f, cell_size);
+
+    float texture_x = static_cast<float>(map_width * (i_tile % columns));
+    float texture_y = static_cast<float>(map_height * (i_tile / columns));
+
+    // From the pixels of the game to the pixels of the tile
+    float scale = cell_size / CELL_SIZE;
+
+    sf::Vector2f position = get_tile_position(i_tile);
+
+    sf::Color color = finished ? FINISHED_TILE_COLOR : sf::Color(255, 255, 255);
+
+    sf::Vector2f size(cell_size * map_width, cell_size * map_height);
+
+    cell_vertices.append(sf::Vertex(position, color, sf::Vector2f(texture_x, texture_y)));
+    cell_vertices.append(sf::Vertex(sf::Vector2f(size.x + position.x, position.y), color, sf::Vector2f(map_width + texture_x, texture_y)));
+    cell_vertices.append(sf::Vertex(sf::Vector2f(size.x + position.x, size.y + position.y), color, sf::Vector2f(map_width + texture_x, map_height + texture_y)));
+    cell_vertices.append(sf::Vertex(sf::Vector2f(position.x, size.y + position.y), color, sf::Vector2f(texture_x, map_height + texture_y)));
+
+    // Like Game::draw, the ghosts are gone when the level is over
+    if (!finished) {
+        const std::array<sf::Color, 4> ghost_colors = {
+            GhostPersonality<0>::get_color(),
+            GhostPersonality<1>::get_color(),
+            GhostPersonality<2>::get_color(),
+            GhostPersonality<3>::get_color()
+        };
+
+        std::array<Ghost, 4>& ghosts = game.get_ghost_manager().get_ghosts();
+
+        for (unsigned char a = 0; a < 4; a++) {
+            float x = get_square_start(position.x, size.x, scale * ghosts[a].get_position().x, entity_size);
+            float y = get_square_start(position.y, size.y, scale * ghosts[a].get_position().y, entity_size);
+
+            if (ghosts[a].get_frightened_mode() == 0) {
+                append_square(entity_vertices, x, y, entity_size, ghost_colors[a]);
+            }
+            else if (ghosts[a].get_frightened_mode() == 1) {
+                append_square(entity_vertices, x, y, entity_size, sf::Color(36, 36, 255));
+            }
+            else {
+                // Only the eyes go back to the house
+                append_square(entity_vertices, x + 0.25f * entity_size, y + 0.25f * entity_size, 0.5f * entity_size, sf::Color(255, 255, 255));
+            }
+        }
+    }
+
+    append_square(entity_vertices,
+        get_square_start(position.x, size.x, scale * game.get_pacman().get_position().x, entity_size),
+        get_square_start(position.y, size.y, scale * game.get_pacman().get_position().y, entity_size),
+        entity_size, sf::Color(255, 255, 0));
+}
+
+// Draw a big tile like Game::draw draws the game, with the whole map in the tile
+void VideoWall::draw_detailed_tile(unsigned short i_tile) {
+    VideoWallTile& tile = *tiles[i_tile];
+
+    Game& game = *tile.game;
+
+    float map_pixel_width = static_cast<float>(CELL_SIZE * map_width);
+    float map_pixel_height = static_cast<float>(CELL_SIZE * map_height);
+
+    sf::Vector2f position = get_tile_position(i_tile);
+
+    sf::View view(sf::FloatRect(0, 0, map_pixel_width, map_pixel_height));
+
+    view.setViewport(sf::FloatRect(
+        position.x / canvas.getSize().x,
+        position.y / canvas.getSize().y,
+        cell_size * map_width / canvas.getSize().x,
+        cell_size * map_height / canvas.getSize().y
+    ));
+
+    canvas.setView(view);
+
+    // Clear the tile (the canvas still has the last frame of it)
+    const std::array<sf::Vertex, 4> background = {
+        sf::Vertex(sf::Vector2f(0, 0), sf::Color(0, 0, 0), sf::Vector2f()),
+        sf::Vertex(sf::Vector2f(map_pixel_width, 0), sf::Color(0, 0, 0), sf::Vector2f()),
+        sf::Vertex(sf::Vector2f(map_pixel_width, map_pixel_height), sf::Color(0, 0, 0), sf::Vector2f()),
+        sf::Vertex(sf::Vector2f(0, map_pixel_height), sf::Color(0, 0, 0), sf::Vector2f())
+    };
+
+    canvas.draw(background.data(), background.size(), sf::Quads);
+
+    draw_calls++;
+
+    if (!game.get_game_won() && !game.get_pacman().get_dead()) {
+        tile.map_renderer.draw(game.get_map(), canvas);
+
+        draw_calls += tile.map_renderer.get_drawn_chunks();
+
+        game.get_ghost_manager().draw(get_level_settings(game.get_level()).ghost_flash_start >= game.get_pacman().get_energizer_timer(), entity_renderer);
+    }
+
+    game.get_pacman().draw(game.get_game_won(), entity_renderer);
+
+    entity_renderer.draw(canvas);
+
+    draw_calls += entity_renderer.get_draw_calls();
+}
+
+void VideoWall::draw(sf::RenderTarget& i_target) {
+    TRACE_ZONE("VideoWall::draw");
+
+    draw_calls = 0;
+    redrawn_tiles = 0;
+
+    // They keep their memory, so this doesn't allocate after the first frames
+    cell_vertices.clear();
+    entity_vertices.clear();
+
+    for (unsigned short a = 0; a < tiles.size(); a++) {
+        VideoWallTile& tile = *tiles[a];
+
+        {
+            std::lock_guard<std::mutex> lock(tile.mutex);
+
+            if (tile.drawn_version == tile.version) {
+                continue;
+            }
+
+            // We draw our own copy, so the simulation can publish again while we draw
+            if (tile.game == nullptr) {
+                tile.game.reset(new Game(*tile.snapshot));
+            }
+            else {
+                *tile.game = *tile.snapshot;
+            }
+
+            tile.drawn_version = tile.version;
+        }
+
+        // Nothing we'd draw changed (the sprites don't animate either, their animations only run when the simulation draws the game)
+        if (tile.drawn_hash == tile.game->get_hash()) {
+            continue;
+        }
+
+        tile.drawn_hash = tile.game->get_hash();
+
+        redrawn_tiles++;
+
+        if (detailed) {
+            draw_detailed_tile(a);
+        }
+        else {
+            update_cell_texture(a);
+            add_small_tile(a);
+        }
+    }
+
+    // Every small tile that changed, in two draw calls
+    if (cell_vertices.getVertexCount() != 0) {
+        canvas.setView(sf::View(sf::FloatRect(0, 0, static_cast<float>(canvas.getSize().x), static_cast<float>(canvas.getSize().y))));
+        canvas.draw(cell_vertices, sf::RenderStates(&cell_texture));
+        canvas.draw(entity_vertices);
+
+        draw_calls += 2;
+    }
+
+    canvas.display();
+
+    i_target.draw(sf::Sprite(canvas.getTexture()));
+
+    draw_calls++;
+}
\ No newline at end of file
@@ -1,94 +1,301 @@
 #include <array>  // For the std::array class template
+#include <atomic> // For the metrics endpoint
 #include <chrono> // For time handling
+#include <climits> // For UINT_MAX
+#include <cstdio> // For printing the versus mode statistics
 #include <ctime>  // For generating random seeds
+#include <string> // For the command line arguments
+#include <thread> // For the metrics endpoint
+#include <vector> // For std::vector
 #include <SFML/Graphics.hpp> // SFML graphics library
+#include <SFML/Network.hpp>  // SFML network library
 
 #include "Headers/Global.hpp"        // Custom global header file
+#include "Headers/Map.hpp"           // Header for the Map class definition
+#include "Headers/LevelSettings.hpp" // Header for the per-level settings
 #include "Headers/DrawText.hpp"      // Header for drawing text on screen
+#include "Headers/EntityRenderer.hpp" // Header for drawing Pacman and the ghosts
 #include "Headers/Pacman.hpp"        // Header for Pac-Man class definition
 #include "Headers/Ghost.hpp"         // Header for Ghost class definition
 #include "Headers/GhostManager.hpp"  // Header for managing ghosts
-#include "Headers/ConvertSketch.hpp" // Header for converting map sketch to a game map
-#include "Headers/DrawMap.hpp"       // Header for drawing the game map
 #include "Headers/MapCollision.hpp"  // Header for handling collisions in the map
-
-int main() {
-    // Tracks whether the game is won or not
-    bool game_won = 0;
-
+#include "Headers/MapRenderer.hpp"   // Header for drawing the game map
+#include "Headers/Game.hpp"          // Header for the Game class definition
+#include "Headers/FlightRecorder.hpp" // Header for recording the last seconds of the game
+#include "Headers/MapSketch.hpp"     // Header for the default map sketch
+#include "Headers/MazeGenerator.hpp" // Header for reading maze files
+#include "Headers/Netplay.hpp"       // Header for the versus mode
+#include "Headers/InputQueue.hpp"    // Header for reading the keyboard between ticks
+#include "Headers/LatencyTest.hpp"   // Header for measuring the input latency
+#include "Headers/Trace.hpp"         // Header for the trace zones
+#include "Headers/AllocationCounter.hpp" // Header for counting the heap allocations
+#include "Headers/Metrics.hpp"           // Header for the monitoring counters
+#include "Headers/MetricsEndpoint.hpp"   // Header for serving them
+#include "Headers/Replay.hpp"            // Header for saving the replay
+
+// With "--check-allocations", the frames before this one may allocate memory (they load the textures and so on)
+constexpr unsigned short ALLOCATION_WARM_UP_FRAMES = 120;
+
+// Versus mode: "--host" or "--join <address>", with "--port <port>" if you don't like the default one
+// To test bad connections, add "--latency <milliseconds>" and "--loss <percent>"
+// "--levels <file>" replaces the level settings (see LevelSettings.cpp), every player must use the same file
+// "--maze <file>" plays the first maze in a maze file (see MazeGenerator.hpp) instead of the default map, every player must use the same file
+// "--ghost-radius <cells>" makes the ghosts further than that from Pacman move less often (for very big mazes), every player must use the same radius
+// "--input-latency-test" shows a square that flips with every key press and prints how long each press took to reach the screen
+// "--check-allocations" prints every frame that allocates memory after the warm-up, and fails if there was one
+// "--show-draw-calls" prints how many draw calls the map and the sprites took, once every 60 frames (the text isn't counted)
+// The last "--flight-seconds <seconds>" (30 by default) of ticks are always recorded in "--flight-recorder <file>" (flight.bin by default), see Tools/FlightDump.cpp
+// A tick slower than "--tick-budget <microseconds>" also saves a copy of the recording in flight_slow_<tick>.bin
+// "--metrics-port <port>" serves the metrics (see Headers/Metrics.hpp) on http://127.0.0.1:<port>, "--metrics-socket <path>" on a Unix socket
+// "--save-replay <file>" adds the replay of the game to the file when the game closes, for Tools/ReplayVerifier (not in versus mode)
+// With PAKKU_TRACE defined, the trace zones are saved in "--trace <file>" when the game closes, and "--trace-slow-frame <milliseconds>" also saves them after a slow frame
+int main(int i_argument_count, char** i_arguments) {
+    // Are we playing against another player?
+    bool versus = 0;
+    // Are we waiting for them, or are we joining them?
+    bool versus_host = 0;
+    // Are we measuring the input latency?
+    bool latency_test_enabled = 0;
+    // Are we checking that the frames don't allocate memory?
+    bool check_allocations = 0;
+    // Are we printing the draw calls?
+    bool show_draw_calls = 0;
+
+    // Fake packet loss (in percent) for testing the versus mode
+    unsigned char loss = 0;
+
+    // Fake latency (in milliseconds) for testing the versus mode
+    unsigned short latency = 0;
+    // How many seconds the flight recorder keeps
+    unsigned short flight_seconds = 30;
+    unsigned short port = NETPLAY_PORT;
+    // How far from Pacman the ghosts move in every tick (0 means everywhere)
+    unsigned short ghost_radius = 0;
+    // Where we serve the metrics (0 means we don't)
+    unsigned short metrics_port = 0;
+
+    // Frames slower than this (in microseconds) save a trace. 0 means never.
+    unsigned slow_frame_duration = 0;
+    // Ticks slower than this (in microseconds) save a copy of the flight recording
+    unsigned tick_budget = FRAME_DURATION / 4;
+    // How long the last frame we showed took (in microseconds)
+    unsigned frame_duration = 0;
     // Used to track time-based lag for framerate independence
     unsigned lag = 0;
 
-    // Level variable to track the current level
-    unsigned char level = 0;
+    // Seed for the ghosts' random numbers (in versus mode, the host sends theirs)
+    unsigned seed = static_cast<unsigned>(time(0));
+
+    // Counts the ticks, for the flight recorder and so we print the versus statistics once per second
+    unsigned ticks = 0;
+
+    // In versus mode, the input of the ticks that waited for the other player (so their taps and turns aren't lost)
+    unsigned char stalled_input = 0;
+    // Counts the frames we showed, and the ones that allocated memory
+    unsigned allocating_frames = 0;
+    unsigned drawn_frames = 0;
+
+    // How many allocations there were before the current frame
+    unsigned long long allocation_count = 0;
+
+    // The address of the host
+    sf::IpAddress address = sf::IpAddress::LocalHost;
+
+    std::string flight_file_name = "flight.bin";
+    std::string metrics_socket_path;
+    std::string replay_file_name;
+    std::string trace_file_name = "trace.json";
+
+    // The mazes from "--maze" (we play the first one)
+    std::vector<std::vector<std::string>> mazes;
 
     // Time point to measure elapsed time for game logic
     std::chrono::time_point<std::chrono::steady_clock> previous_time;
 
-    // Initial game map represented as a sketch (a grid of characters)
-    std::array<std::string, MAP_HEIGHT> map_sketch = {
-        " ################### ",
-        " #........#........# ",
-        " #o##.###.#.###.##o# ",
-        " #.................# ",
-        " #.##.#.#####.#.##.# ",
-        " #....#...#...#....# ",
-        " ####.### # ###.#### ",
-        "    #.#   0   #.#    ",
-        "#####.# ##=## #.#####",
-        "     .  #123#  .     ",
-        "#####.# ##### #.#####",
-        "    #.#       #.#    ",
-        " ####.# ##### #.#### ",
-        " #........#........# ",
-        " #.##.###.#.###.##.# ",
-        " #o.#.....P.....#.o# ",
-        " ##.#.#.#####.#.#.## ",
-        " #....#...#...#....# ",
-        " #.######.#.######.# ",
-        " #.................# ",
-        " ################### "
-    };
-
-    // 2D array representing the game map, filled later
-    std::array<std::array<Cell, MAP_HEIGHT>, MAP_WIDTH> map{};
-
-    // Stores initial ghost positions
-    std::array<Position, 4> ghost_positions;
-
-    // SFML event object to handle game events
-    sf::Event event;
+    // Read the command line arguments
+    for (int a = 1; a < i_argument_count; a++) {
+        std::string argument = i_arguments[a];
+
+        if (argument == "--host") {
+            versus = 1;
+            versus_host = 1;
+        }
+        else if (argument == "--check-allocations") {
+            check_allocations = 1;
+        }
+        else if (argument == "--show-draw-calls") {
+            show_draw_calls = 1;
+        }
+        else if (argument == "--input-latency-test") {
+            latency_test_enabled = 1;
+        }
+        else if (argument == "--join" && a + 1 < i_argument_count) {
+            versus = 1;
+            address = i_arguments[++a];
+        }
+        else if (argument == "--port" && a + 1 < i_argument_count) {
+            port = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+        }
+        else if (argument == "--latency" && a + 1 < i_argument_count) {
+            latency = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+        }
+        else if (argument == "--loss" && a + 1 < i_argument_count) {
+            loss = static_cast<unsigned char>(std::stoi(i_arguments[++a]));
+        }
+        else if (argument == "--trace" && a + 1 < i_argument_count) {
+            trace_file_name = i_arguments[++a];
+        }
+        else if (argument == "--flight-recorder" && a + 1 < i_argument_count) {
+            flight_file_name = i_arguments[++a];
+        }
+        else if (argument == "--flight-seconds" && a + 1 < i_argument_count) {
+            flight_seconds = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+        }
+        else if (argument == "--tick-budget" && a + 1 < i_argument_count) {
+            tick_budget = static_cast<unsigned>(std::stoul(i_arguments[++a]));
+        }
+        else if (argument == "--save-replay" && a + 1 < i_argument_count) {
+            replay_file_name = i_arguments[++a];
+        }
+        else if (argument == "--metrics-port" && a + 1 < i_argument_count) {
+            metrics_port = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+        }
+        else if (argument == "--metrics-socket" && a + 1 < i_argument_count) {
+            metrics_socket_path = i_arguments[++a];
+        }
+        else if (argument == "--trace-slow-frame" && a + 1 < i_argument_count) {
+            slow_frame_duration = 1000 * static_cast<unsigned>(std::stoul(i_arguments[++a]));
+        }
+        else if (argument == "--ghost-radius" && a + 1 < i_argument_count) {
+            ghost_radius = static_cast<unsigned short>(std::stoi(i_arguments[++a]));
+        }
+        else if (argument == "--maze" && a + 1 < i_argument_count) {
+            if (!load_mazes(i_arguments[++a], mazes) || mazes.empty()) {
+                std::printf("Can't read a maze in %s.\n", i_arguments[a]);
+
+                return 1;
+            }
+
+            const char* error = validate_maze(mazes[0]);
+
+            if (error != nullptr) {
+                std::printf("Can't play the maze in %s: %s\n", i_arguments[a], error);
+
+                return 1;
+            }
+        }
+        else if (argument == "--levels" && a + 1 < i_argument_count) {
+            if (!load_level_settings(i_arguments[++a])) {
+                std::printf("Can't read the level settings in %s.\n", i_arguments[a]);
+
+                return 1;
+            }
+        }
+    }
+
+    // Answers the monitoring from its own thread (the game only counts, see Headers/Metrics.hpp)
+    MetricsEndpoint http_metrics_endpoint;
+    MetricsEndpoint unix_metrics_endpoint;
+
+    if (metrics_port != 0 && !http_metrics_endpoint.start_http(metrics_port)) {
+        std::printf("Can't serve the metrics on port %u.\n", metrics_port);
+
+        return 1;
+    }
+
+    if (!metrics_socket_path.empty() && !unix_metrics_endpoint.start_unix(metrics_socket_path)) {
+        std::printf("Can't serve the metrics on %s.\n", metrics_socket_path.c_str());
+
+        return 1;
+    }
+
+    // The connection to the other player
+    Netplay netplay(latency, loss);
+
+    if (versus) {
+        if (versus_host) {
+            std::printf("Waiting for the other player on port %u...\n", port);
+
+            if (!netplay.host(port, seed)) {
+                std::printf("Can't use port %u.\n", port);
+
+                return 1;
+            }
+        }
+        else if (!netplay.join(address, port, seed)) {
+            std::printf("Can't reach the host.\n");
+
+            return 1;
+        }
+    }
 
     // Create a render window for the game with a specific size and style
     sf::RenderWindow window(
-        sf::VideoMode(CELL_SIZE * MAP_WIDTH * SCREEN_RESIZE,
-            (FONT_HEIGHT + CELL_SIZE * MAP_HEIGHT) * SCREEN_RESIZE),
+        sf::VideoMode(CELL_SIZE * VIEW_WIDTH * SCREEN_RESIZE,
+            (FONT_HEIGHT + CELL_SIZE * VIEW_HEIGHT) * SCREEN_RESIZE),
         "Pac-Man",
         sf::Style::Close
     );
 
+    // We want one press and one release per key, not the repeats
+    window.setKeyRepeatEnabled(0);
+
     // Set the view to fit the window size
-    window.setView(sf::View(sf::FloatRect(0, 0, CELL_SIZE * MAP_WIDTH,
-        FONT_HEIGHT + CELL_SIZE * MAP_HEIGHT)));
+    window.setView(sf::View(sf::FloatRect(0, 0, CELL_SIZE * VIEW_WIDTH,
+        FONT_HEIGHT + CELL_SIZE * VIEW_HEIGHT)));
+
+    // The whole game (the map, the ghosts, Pac-Man...)
+    Game game(versus, seed, mazes.empty() ? get_map_sketch() : mazes[0]);
+
+    game.set_ghost_simulation_radius(ghost_radius);
 
-    // Instantiate the ghost manager and Pac-Man
-    GhostManager ghost_manager;
-    Pacman pacman;
+    // Keeps the vertices of the map between frames
+    MapRenderer map_renderer;
+    // Draws Pacman and the ghosts from one texture, in one draw call
+    EntityRenderer entity_renderer;
 
-    // Seed the random number generator with the current time for randomness
-    srand(static_cast<unsigned>(time(0)));
+    // The key presses and releases since the last tick
+    InputQueue input_queue;
 
-    // Convert the sketch into a structured map and set initial ghost and Pac-Man positions
-    map = convert_sketch(map_sketch, ghost_positions, pacman);
+    LatencyTest latency_test(latency_test_enabled);
 
-    // Reset the ghost manager for the current level and set initial positions
-    ghost_manager.reset(level, ghost_positions);
+    // The seed and every input, if we save the replay
+    Replay replay = {};
+    replay.ghost_simulation_radius = ghost_radius;
+    replay.seed = seed;
+    replay.setup_hash = get_replay_setup_hash(mazes.empty() ? get_map_sketch() : mazes[0]);
+
+    // The inputs rarely change, so this is hours of play (and we don't allocate while playing)
+    if (!replay_file_name.empty()) {
+        replay.runs.reserve(65536);
+    }
+
+    // Keeps the last seconds of the game on the disk, even if we crash
+    FlightRecorder flight_recorder;
+
+    if (!flight_recorder.open(flight_file_name, flight_seconds)) {
+        std::printf("Can't create the flight recording %s, the game won't be recorded.\n", flight_file_name.c_str());
+    }
 
     // Store the initial time for measuring frame lag
     previous_time = std::chrono::steady_clock::now();
 
+    // When we showed the last frame, and when we last saved a slow frame trace
+    std::chrono::time_point<std::chrono::steady_clock> display_time = previous_time;
+    std::chrono::time_point<std::chrono::steady_clock> slow_frame_save_time = previous_time;
+    // The same for the frame durations and the slow tick copies of the flight recording
+    std::chrono::time_point<std::chrono::steady_clock> frame_time = previous_time;
+    std::chrono::time_point<std::chrono::steady_clock> slow_tick_save_time = previous_time;
+
+    set_trace_thread_name("Game");
+
     // Game loop runs while the window is open
     while (window.isOpen()) {
+        allocation_count = get_allocation_count();
+
+        // Read the events as soon as they arrive, so we know when every key was pressed
+        input_queue.poll(window);
+
         // Calculate elapsed time since the last frame
         unsigned delta_time = std::chrono::duration_cast<std::chrono::microseconds>(
             std::chrono::steady_clock::now() - previous_time
@@ -105,59 +312,94 @@ int main() {
             // Decrease lag by one frame duration to keep the game running smoothly
             lag -= FRAME_DURATION;
 
-            // Poll all SFML events in the queue
-            while (window.pollEvent(event)) {
-                if (event.type == sf::Event::Closed) {
-                    // If the window close event is triggered, close the game window
-                    window.close();
-                }
+            // Turn the events since the last tick into one input (in versus mode, the ghost player uses the same keys)
+            unsigned char input = input_queue.update();
+
+            // The directions and restarts of the ticks that stalled carry over, and so does their turn (unless there's a newer one)
+            if ((input & INPUT_TURN) == 0) {
+                input |= stalled_input & (INPUT_TURN | 96);
             }
 
-            if (!game_won && !pacman.get_dead()) {
-                // Set game_won to 1 temporarily (check if any pellets are left)
-                game_won = 1;
+            input |= stalled_input & (15 | INPUT_RESTART);
 
-                // Update Pac-Man's state
-                pacman.update(level, map);
+            if (latency_test.get_enabled() && input_queue.get_pressed()) {
+                latency_test.press(input_queue.get_press_time());
+            }
 
-                // Update ghost behavior
-                ghost_manager.update(level, map, pacman);
+            std::chrono::time_point<std::chrono::steady_clock> tick_start_time = std::chrono::steady_clock::now();
 
-                // Check all cells in the map to see if any pellets are left
-                for (const std::array<Cell, MAP_HEIGHT>& column : map) {
-                    for (const Cell& cell : column) {
-                        if (cell == Cell::Pellet) {
-                            // If at least one pellet is found, set game_won to 0 (game not over)
-                            game_won = 0;
-                            break;
-                        }
+            ticks++;
+
+            // So we can count the deaths and the levels
+            bool playing = !game.get_game_won() && !game.get_pacman().get_dead();
+
+            if (versus) {
+                // Simulate the frame with a guess of the other player's input (and fix old guesses)
+                if (netplay.update(input, game)) {
+                    stalled_input = 0;
+                }
+                else {
+                    stalled_input = input;
+                }
+
+                // Once per second, show how the connection is doing
+                if (ticks % (1000000 / FRAME_DURATION) == 0) {
+                    NetplayStatistics statistics = netplay.get_statistics();
+
+                    std::printf("Rollback depth: %u max, %.1f average | Resimulated: %u frames/s | Stalled: %u frames/s | Sent: %u B/s | Received: %u B/s\n",
+                        statistics.max_rollback_depth, statistics.average_rollback_depth, statistics.resimulated_frames,
+                        statistics.stalled_frames, statistics.sent_bytes, statistics.received_bytes);
+
+                    // The hashes of the games are compared all the time, so this shouldn't happen (but if it does, we want to know where)
+                    if (netplay.get_desync_frame() != UINT_MAX) {
+                        std::printf("Desync! The games went different ways at frame %u.\n", netplay.get_desync_frame());
                     }
-                    if (!game_won) break;
                 }
+            }
+            else {
+                game.update(input, 0);
 
-                // If all pellets are collected, prepare for level transition
-                if (game_won) {
-                    pacman.set_animation_timer(0);
+                if (!replay_file_name.empty()) {
+                    add_replay_input(input, 0, replay);
                 }
             }
-            else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Enter)) {
-                // If the Enter key is pressed, restart the game logic
 
-                game_won = 0; // Reset game_won flag
+            {
+                std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+                unsigned tick_duration = static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(now - tick_start_time).count());
 
-                if (pacman.get_dead()) {
-                    level = 0; // Reset to level 0 if Pac-Man died
+                bool slow_tick = tick_budget < tick_duration;
+
+                add_metric(Metric::TickMetric);
+                add_metric_sample(MetricHistogram::TickTimeHistogram, tick_duration);
+
+                if (slow_tick) {
+                    add_metric(Metric::TickOverrunMetric);
                 }
-                else {
-                    // Increment level if Pac-Man won
-                    level++;
+
+                if (playing && game.get_pacman().get_dead()) {
+                    add_death_metric(game.get_level());
                 }
+                else if (playing && game.get_game_won()) {
+                    add_metric(Metric::LevelWonMetric);
+                }
+
+                set_level_metric(game.get_level());
 
-                // Reset the map and ghost manager for the new level
-                map = convert_sketch(map_sketch, ghost_positions, pacman);
-                ghost_manager.reset(level, ghost_positions);
+                // In versus mode we don't know the other player's input yet (we record the game with our guess of it)
+                flight_recorder.record(ticks, input, 0, tick_duration, frame_duration, slow_tick, game);
 
-                pacman.reset(); // Reset Pac-Man's state
+                // The ring is overwritten after a while, so we keep a copy of what led to the slow tick (but not of every one)
+                if (slow_tick && std::chrono::seconds(5) < now - slow_tick_save_time) {
+                    std::string file_name = "flight_slow_" + std::to_string(ticks) + ".bin";
+
+                    if (flight_recorder.save(file_name)) {
+                        std::printf("Tick %u took %u us, saved the flight recording in %s.\n", ticks, tick_duration, file_name.c_str());
+                    }
+
+                    slow_tick_save_time = std::chrono::steady_clock::now();
+                }
             }
 
             if (FRAME_DURATION > lag) {
@@ -165,34 +407,99 @@ int main() {
 
                 window.clear(); // Clear the window for redrawing
 
-                if (!game_won && !pacman.get_dead()) {
-                    // Draw the game map
-                    draw_map(map, window);
+                // Draw the map, the ghosts, Pac-Man and the text
+                game.draw(map_renderer, entity_renderer, window);
 
-                    // Draw ghosts, with a check for flashing state (ghosts are vulnerable)
-                    ghost_manager.draw(GHOST_FLASH_START >= pacman.get_energizer_timer(), window);
+                latency_test.draw(window);
+
+                // Show the drawn graphics on the screen
+                {
+                    TRACE_ZONE("window.display");
 
-                    // Display the current level on the screen
-                    draw_text(0, 0, CELL_SIZE * MAP_HEIGHT, "Level: " + std::to_string(1 + level), window);
+                    window.display();
                 }
 
-                // Draw Pac-Man with the game status
-                pacman.draw(game_won, window);
+                latency_test.displayed();
 
-                if (pacman.get_animation_over()) {
-                    if (game_won) {
-                        // If the game is won, display "Next level!"
-                        draw_text(1, 0, 0, "Next level!", window);
-                    }
-                    else {
-                        // If Pac-Man died, display "Game over"
-                        draw_text(1, 0, 0, "Game over", window);
-                    }
+                {
+                    std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+                    frame_duration = static_cast<unsigned>(std::chrono::duration_cast<std::chrono::microseconds>(now - frame_time).count());
+                    frame_time = now;
                 }
 
-                // Show the drawn graphics on the screen
-                window.display();
+                add_metric(Metric::DrawCallMetric, map_renderer.get_drawn_chunks() + entity_renderer.get_draw_calls());
+                add_metric_sample(MetricHistogram::FrameTimeHistogram, frame_duration);
+
+                drawn_frames++;
+
+                if (show_draw_calls && drawn_frames % 60 == 0) {
+                    std::printf("Draw calls: %u (map chunks: %u, Pacman and the ghosts: %u)\n",
+                        map_renderer.get_drawn_chunks() + entity_renderer.get_draw_calls(), map_renderer.get_drawn_chunks(), entity_renderer.get_draw_calls());
+                }
+
+                // After the warm-up (loading the textures and so on), a frame shouldn't allocate anything
+                if (check_allocations && ALLOCATION_WARM_UP_FRAMES < drawn_frames && allocation_count != get_allocation_count()) {
+                    std::printf("Frame %u allocated memory %llu times.\n", drawn_frames, get_allocation_count() - allocation_count);
+
+                    allocating_frames++;
+                }
+
+                if (TRACE_ENABLED && slow_frame_duration != 0) {
+                    std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
+
+                    // Saving takes a while, so we wait a bit before saving the next one (otherwise every frame would be slow)
+                    if (std::chrono::microseconds(slow_frame_duration) < now - display_time && std::chrono::seconds(5) < now - slow_frame_save_time) {
+                        std::string file_name = "slow_frame_" + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(now - display_time).count()) + "ms.json";
+
+                        if (save_trace(file_name)) {
+                            std::printf("Slow frame, saved the trace in %s.\n", file_name.c_str());
+                        }
+
+                        slow_frame_save_time = std::chrono::steady_clock::now();
+                        now = slow_frame_save_time;
+                    }
+
+                    display_time = now;
+                }
             }
         }
     }
+
+    // In versus mode, the inputs we played aren't the final ones (the rollbacks change them)
+    if (!replay_file_name.empty() && versus) {
+        std::printf("Replays aren't saved in versus mode.\n");
+    }
+    else if (!replay_file_name.empty()) {
+        std::FILE* replay_file = std::fopen(replay_file_name.c_str(), "ab");
+
+        // What we claim is what we got
+        replay.hash = game.get_hash();
+        replay.level = game.get_level();
+
+        bool saved = replay_file != nullptr && write_replay(replay_file, replay);
+
+        if (replay_file != nullptr && std::fclose(replay_file) != 0) {
+            saved = 0;
+        }
+
+        if (saved) {
+            std::printf("Saved the replay (%llu ticks) in %s.\n", get_replay_ticks(replay), replay_file_name.c_str());
+        }
+        else {
+            std::printf("Can't save the replay in %s.\n", replay_file_name.c_str());
+        }
+    }
+
+    if (TRACE_ENABLED && save_trace(trace_file_name)) {
+        std::printf("Saved the trace in %s.\n", trace_file_name.c_str());
+    }
+
+    if (check_allocations) {
+        std::printf("%u of %u frames allocated memory after the warm-up.\n", allocating_frames, drawn_frames);
+
+        if (allocating_frames != 0) {
+            return 1;
+        }
+    }
 }